@@ -1136,13 +1136,21 @@ bool retro_load_game(const struct retro_game_info *info)
    }
    delete custompalette;
    
-   sprintf(db_path, "%s%cNstDatabase.xml", dir, slash);
+   // A compiled database loads much faster, fall back to the XML one
+   sprintf(db_path, "%s%cNstDatabase.bin", dir, slash);
+   std::ifstream *db_file = new std::ifstream(db_path, std::ifstream::in|std::ifstream::binary);
+
+   if (!db_file->is_open())
+   {
+      delete db_file;
+      sprintf(db_path, "%s%cNstDatabase.xml", dir, slash);
+      db_file = new std::ifstream(db_path, std::ifstream::in|std::ifstream::binary);
+   }
 
    if (log_cb)
-      log_cb(RETRO_LOG_INFO, "NstDatabase.xml path: %s\n", db_path);
+      log_cb(RETRO_LOG_INFO, "NstDatabase path: %s\n", db_path);
    
    Api::Cartridge::Database database(emulator);
-   std::ifstream *db_file = new std::ifstream(db_path, std::ifstream::in|std::ifstream::binary);
    
    if (db_file->is_open())
    {
@@ -1172,9 +1180,6 @@ bool retro_load_game(const struct retro_game_info *info)
       return false;
    }
    
-   std::stringstream ss(std::string(reinterpret_cast<const char*>(info->data),
-            reinterpret_cast<const char*>(info->data) + info->size));
-
    if (info->path && (strstr(info->path, ".fds") || strstr(info->path, ".FDS")))
    {
       fds = new Api::Fds(emulator);
@@ -1212,7 +1217,7 @@ bool retro_load_game(const struct retro_game_info *info)
    is_pal = false;
    check_variables();
 
-   if (machine->Load(ss, favsystem))
+   if (machine->Load(info->data, info->size, favsystem))
       return false;
 
    Api::Video ivideo(emulator);
@@ -1315,31 +1320,18 @@ bool retro_load_game_special(unsigned, const struct retro_game_info *, size_t)
 
 size_t retro_serialize_size(void)
 {
-   std::stringstream ss;
-   if (machine->SaveState(ss, Api::Machine::NO_COMPRESSION))
-      return 0;
-   return ss.str().size();
+   // Cached by the core, only measured again after load, reset or input changes
+   return machine->GetStateSize();
 }
 
 bool retro_serialize(void *data, size_t size)
 {
-   std::stringstream ss;
-   if (machine->SaveState(ss, Api::Machine::NO_COMPRESSION))
-      return false;
-
-   std::string state = ss.str();
-   if (state.size() > size)
-      return false;
-
-   std::copy(state.begin(), state.end(), reinterpret_cast<char*>(data));
-   return true;
+   return !machine->SaveState(data, size);
 }
 
 bool retro_unserialize(const void *data, size_t size)
 {
-   std::stringstream ss(std::string(reinterpret_cast<const char*>(data),
-            reinterpret_cast<const char*>(data) + size));
-   return !machine->LoadState(ss);
+   return !machine->LoadState(data, size);
 }
 
 void *retro_get_memory_data(unsigned id)
@@ -0,0 +1,228 @@
+/*
+ * Nestopia UE
+ *
+ * Copyright (C) 2026 R. Danbrook
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ *
+ */
+
+#include <deque>
+#include <vector>
+
+#include <pthread.h>
+
+#include "batch.h"
+
+typedef struct {
+	pthread_mutex_t mutex;
+	std::deque<int> jobs;
+} batchqueue_t;
+
+typedef struct {
+	batch_t *batch;
+	int id;
+} batchworker_t;
+
+struct batch_t {
+	int threads;
+	std::vector<pthread_t> threadids;
+	std::vector<batchworker_t> workers;
+	std::vector<batchqueue_t> queues;
+
+	pthread_mutex_t mutex;
+	pthread_cond_t start;
+	pthread_cond_t done;
+	unsigned generation;
+	int active;
+	bool quit;
+
+	batchjob_t job;
+	void *userdata;
+};
+
+static bool batch_pop(batchqueue_t& queue, bool steal, int& index) {
+	// The owner takes from the back, thieves take from the front
+	bool found = false;
+
+	pthread_mutex_lock(&queue.mutex);
+
+	if (!queue.jobs.empty()) {
+		if (steal) {
+			index = queue.jobs.front();
+			queue.jobs.pop_front();
+		}
+		else {
+			index = queue.jobs.back();
+			queue.jobs.pop_back();
+		}
+		found = true;
+	}
+
+	pthread_mutex_unlock(&queue.mutex);
+
+	return found;
+}
+
+static void batch_work(batch_t *batch, int id) {
+	// Drain the own queue, then steal until every queue is empty. No jobs
+	// are queued during a run so a fruitless sweep means the run is over.
+	int index;
+
+	for (;;) {
+		if (batch_pop(batch->queues[id], false, index)) {
+			batch->job(batch->userdata, index);
+			continue;
+		}
+
+		bool stolen = false;
+
+		for (int i = 1; i < batch->threads && !stolen; i++) {
+			stolen = batch_pop(batch->queues[(id + i) % batch->threads], true, index);
+		}
+
+		if (!stolen) { return; }
+
+		batch->job(batch->userdata, index);
+	}
+}
+
+static void* batch_thread(void *data) {
+	batchworker_t *worker = (batchworker_t*)data;
+	batch_t *batch = worker->batch;
+	unsigned generation = 0;
+
+	for (;;) {
+		pthread_mutex_lock(&batch->mutex);
+
+		while (batch->generation == generation && !batch->quit) {
+			pthread_cond_wait(&batch->start, &batch->mutex);
+		}
+
+		generation = batch->generation;
+		bool quit = batch->quit;
+
+		pthread_mutex_unlock(&batch->mutex);
+
+		if (quit) { return NULL; }
+
+		batch_work(batch, worker->id);
+
+		pthread_mutex_lock(&batch->mutex);
+
+		if (--batch->active == 0) {
+			pthread_cond_signal(&batch->done);
+		}
+
+		pthread_mutex_unlock(&batch->mutex);
+	}
+}
+
+batch_t* batch_create(int threads) {
+	batch_t *batch = new batch_t;
+
+	batch->threads = threads > 0 ? threads : 1;
+	batch->queues.resize(batch->threads);
+	batch->workers.resize(batch->threads);
+	batch->generation = 0;
+	batch->active = 0;
+	batch->quit = false;
+	batch->job = NULL;
+	batch->userdata = NULL;
+
+	pthread_mutex_init(&batch->mutex, NULL);
+	pthread_cond_init(&batch->start, NULL);
+	pthread_cond_init(&batch->done, NULL);
+
+	for (int i = 0; i < batch->threads; i++) {
+		pthread_mutex_init(&batch->queues[i].mutex, NULL);
+		batch->workers[i].batch = batch;
+		batch->workers[i].id = i;
+	}
+
+	// Worker 0 is the thread calling batch_run
+	for (int i = 1; i < batch->threads; i++) {
+		pthread_t thread;
+
+		if (pthread_create(&thread, NULL, batch_thread, &batch->workers[i]) != 0) {
+			batch->threads = i;
+			break;
+		}
+
+		batch->threadids.push_back(thread);
+	}
+
+	return batch;
+}
+
+void batch_run(batch_t *batch, int count, batchjob_t job, void *userdata) {
+	// Hand out contiguous blocks so each thread mostly keeps its own instances
+	for (int i = 0; i < batch->threads; i++) {
+		int first = (int)((long long)count * i / batch->threads);
+		int last = (int)((long long)count * (i + 1) / batch->threads);
+
+		pthread_mutex_lock(&batch->queues[i].mutex);
+
+		for (int j = last - 1; j >= first; j--) {
+			batch->queues[i].jobs.push_back(j);
+		}
+
+		pthread_mutex_unlock(&batch->queues[i].mutex);
+	}
+
+	pthread_mutex_lock(&batch->mutex);
+	batch->job = job;
+	batch->userdata = userdata;
+	batch->active = batch->threads - 1;
+	batch->generation++;
+	pthread_cond_broadcast(&batch->start);
+	pthread_mutex_unlock(&batch->mutex);
+
+	batch_work(batch, 0);
+
+	pthread_mutex_lock(&batch->mutex);
+
+	while (batch->active) {
+		pthread_cond_wait(&batch->done, &batch->mutex);
+	}
+
+	pthread_mutex_unlock(&batch->mutex);
+}
+
+int batch_threads(const batch_t *batch) {
+	return batch->threads;
+}
+
+void batch_destroy(batch_t *batch) {
+	pthread_mutex_lock(&batch->mutex);
+	batch->quit = true;
+	pthread_cond_broadcast(&batch->start);
+	pthread_mutex_unlock(&batch->mutex);
+
+	for (size_t i = 0; i < batch->threadids.size(); i++) {
+		pthread_join(batch->threadids[i], NULL);
+	}
+
+	for (size_t i = 0; i < batch->queues.size(); i++) {
+		pthread_mutex_destroy(&batch->queues[i].mutex);
+	}
+
+	pthread_cond_destroy(&batch->done);
+	pthread_cond_destroy(&batch->start);
+	pthread_mutex_destroy(&batch->mutex);
+
+	delete batch;
+}
@@ -0,0 +1,44 @@
+/*
+ * Nestopia UE
+ *
+ * Copyright (C) 2026 R. Danbrook
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ *
+ */
+
+#ifndef _BATCH_H_
+#define _BATCH_H_
+
+// Work-stealing thread pool that steps a batch of independent jobs,
+// e.g. one Nes::Api::Emulator per job, in parallel. Jobs must not share
+// mutable state; emulator instances should only use per-instance callbacks.
+
+typedef void (*batchjob_t)(void *userdata, int index);
+
+typedef struct batch_t batch_t;
+
+// Create a pool of the given number of threads, the calling thread counts as one
+batch_t* batch_create(int threads);
+
+// Run job(userdata, i) for every i in [0, count) and wait for all of them
+void batch_run(batch_t *batch, int count, batchjob_t job, void *userdata);
+
+int batch_threads(const batch_t *batch);
+
+void batch_destroy(batch_t *batch);
+
+#endif
@@ -0,0 +1,1040 @@
+/*
+ * Nestopia UE
+ *
+ * Copyright (C) 2026 R. Danbrook
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ *
+ */
+
+// Headless frame-throughput benchmark for the core
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <new>
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#include "core/api/NstApiEmulator.hpp"
+#include "core/api/NstApiMachine.hpp"
+#include "core/api/NstApiCartridge.hpp"
+#include "core/api/NstApiVideo.hpp"
+#include "core/api/NstApiSound.hpp"
+#include "core/api/NstApiInput.hpp"
+#include "core/api/NstApiRewinder.hpp"
+#include "core/api/NstApiRunAhead.hpp"
+#include "core/NstMachine.hpp"
+#include "core/board/NstBoard.hpp"
+
+#include "bench.h"
+#include "batch.h"
+
+using namespace Nes::Api;
+
+typedef Nes::Core::Machine::Profiler Profiler;
+
+static benchconf_t bconf;
+
+static unsigned int videobuf[Video::Output::WIDTH * 4 * Video::Output::HEIGHT * 4];
+static short audiobuf[Sound::Output::MAX_LENGTH];
+
+static uint64_t sectionstart[Profiler::NUM_SECTIONS];
+static uint64_t sectiontime[Profiler::NUM_SECTIONS];
+
+NST_COMPILE_ASSERT( Profiler::NUM_SECTIONS == BENCH_NUM_SECTIONS );
+
+static const char *sectionname[Profiler::NUM_SECTIONS] = {
+	"Cpu::ExecuteFrame",
+	"Ppu::EndFrame",
+	"Renderer::Blit"
+};
+
+static const struct {
+	const char *name;
+	Video::RenderState::Filter filter;
+	int width;
+	int height;
+} benchfilter[] = {
+	{ "none",    Video::RenderState::FILTER_NONE,    Video::Output::WIDTH,      Video::Output::HEIGHT },
+	{ "ntsc",    Video::RenderState::FILTER_NTSC,    Video::Output::NTSC_WIDTH, Video::Output::HEIGHT },
+	{ "scale2x", Video::RenderState::FILTER_SCALE2X, Video::Output::WIDTH * 2,  Video::Output::HEIGHT * 2 },
+	{ "scale3x", Video::RenderState::FILTER_SCALE3X, Video::Output::WIDTH * 3,  Video::Output::HEIGHT * 3 },
+	{ "hq2x",    Video::RenderState::FILTER_HQ2X,    Video::Output::WIDTH * 2,  Video::Output::HEIGHT * 2 },
+	{ "hq3x",    Video::RenderState::FILTER_HQ3X,    Video::Output::WIDTH * 3,  Video::Output::HEIGHT * 3 },
+	{ "hq4x",    Video::RenderState::FILTER_HQ4X,    Video::Output::WIDTH * 4,  Video::Output::HEIGHT * 4 },
+	{ "2xsai",   Video::RenderState::FILTER_2XSAI,   Video::Output::WIDTH * 2,  Video::Output::HEIGHT * 2 },
+	{ "xbr2x",   Video::RenderState::FILTER_2XBR,    Video::Output::WIDTH * 2,  Video::Output::HEIGHT * 2 },
+	{ "xbr3x",   Video::RenderState::FILTER_3XBR,    Video::Output::WIDTH * 3,  Video::Output::HEIGHT * 3 },
+	{ "xbr4x",   Video::RenderState::FILTER_4XBR,    Video::Output::WIDTH * 4,  Video::Output::HEIGHT * 4 }
+};
+
+static const int benchfilters = sizeof(benchfilter) / sizeof(benchfilter[0]);
+
+static int benchheapfill = -1;
+
+// Heap allocations go through here so -H can build an instance on memory
+// that isn't zeroed
+#if __cplusplus < 201103L
+void* operator new(std::size_t size) throw(std::bad_alloc) {
+#else
+void* operator new(std::size_t size) {
+#endif
+	void *ptr = malloc(size ? size : 1);
+
+	if (!ptr) { throw std::bad_alloc(); }
+	if (benchheapfill >= 0) { memset(ptr, benchheapfill, size); }
+
+	return ptr;
+}
+
+void operator delete(void *ptr) throw() {
+	free(ptr);
+}
+
+#ifdef __cpp_sized_deallocation
+void operator delete(void *ptr, std::size_t) throw() {
+	free(ptr);
+}
+#endif
+
+static uint64_t bench_time_ns() {
+	// Monotonic wall clock in nanoseconds
+	struct timespec ts;
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000ULL + (uint64_t)ts.tv_nsec;
+}
+
+static void NST_CALLBACK bench_cb_profile(void*, Profiler::Section section, bool begin) {
+	// Accumulate time spent inside each instrumented core section
+	if (begin) { sectionstart[section] = bench_time_ns(); }
+	else { sectiontime[section] += bench_time_ns() - sectionstart[section]; }
+}
+
+static uint64_t bench_percentile(const std::vector<uint64_t>& sorted, int pct) {
+	// Nearest-rank percentile of an ascending sample set
+	size_t rank = (sorted.size() * pct + 99) / 100;
+	return sorted[rank ? rank - 1 : 0];
+}
+
+static void bench_usage() {
+	fprintf(stderr,
+		"Usage: nestopia-bench [options] [rom[:frames] ...]\n\n"
+		"  -f <n>     Frames to measure per ROM (default %d)\n"
+		"  -w <n>     Warm-up frames before measuring (default %d)\n"
+		"  -l <file>  Read ROMs from a suite list (\"path [frames]\" per line)\n"
+		"  -d <file>  Load NstDatabase.xml (or a compiled .bin) from the given path\n"
+		"  -v         Render video (32bpp) instead of a NULL output\n"
+		"  -F <name>  Video filter: none, ntsc, scale2x/3x, hq2x/3x/4x, 2xsai, xbr2x/3x/4x\n"
+		"  -b <n>     Spread the video filter across <n> blit threads\n"
+		"  -B         Finish blits asynchronously, overlapping the next frame\n"
+		"  -s         Render sound (16-bit mono) instead of a NULL output\n"
+		"  -k <n>     Sample rate in Hz with -s (default %d)\n"
+		"  -L         Use band-limited synthesis with -s\n"
+		"  -c         Print results as CSV\n"
+		"  -S         Time save states and snapshots instead of frames\n"
+		"  -n <n>     Step <n> instances of each ROM in parallel\n"
+		"  -j <n>     Threads to use with -n (default: online CPUs)\n"
+		"  -r <n>     Keep the rewinder enabled with <n> seconds of history\n"
+		"  -R         Store rewinder keys as deltas instead of full states\n"
+		"  -m <n>     Cap rewinder memory at <n> KB (default: no cap)\n"
+		"  -a <n>     Run <n> frames ahead of the presented frame\n"
+		"  -A         Use preemptive run-ahead instead of rerunning every frame\n"
+		"  -i <n>     Toggle the A button every <n> frames (default: never)\n"
+		"  -U         Time loading a UNIF image of every known board name, no ROMs needed\n"
+		"  -H         Check that two instances of each ROM keep the same state hash every frame\n"
+		"  -X         Check that the SSE2 and scalar hqNx/xBR paths render the same frames\n"
+		"  -h         Show this help\n",
+		BENCH_DEFAULT_FRAMES, BENCH_DEFAULT_WARMUP, BENCH_DEFAULT_SAMPLE_RATE);
+}
+
+static int bench_find_filter(const char *name) {
+	for (int i = 0; i < benchfilters; i++) {
+		if (!strcmp(name, benchfilter[i].name)) { return i; }
+	}
+
+	return -1;
+}
+
+static void bench_add(std::vector<benchrom_t>& suite, const std::string& path, int frames) {
+	benchrom_t rom;
+	rom.path = path;
+	rom.frames = frames > 0 ? frames : bconf.frames;
+	suite.push_back(rom);
+}
+
+static void bench_add_arg(std::vector<benchrom_t>& suite, const char *arg) {
+	// Accept "rom" or "rom:frames"
+	std::string path(arg);
+	int frames = 0;
+	size_t colon = path.rfind(':');
+
+	if (colon != std::string::npos && colon + 1 < path.size() &&
+		strspn(path.c_str() + colon + 1, "0123456789") == path.size() - colon - 1) {
+		frames = atoi(path.c_str() + colon + 1);
+		path.erase(colon);
+	}
+
+	bench_add(suite, path, frames);
+}
+
+static bool bench_load_list(std::vector<benchrom_t>& suite, const char *filename) {
+	// Load a suite list, resolving relative paths against the list's directory
+	std::ifstream list(filename);
+
+	if (!list.is_open()) {
+		fprintf(stderr, "Could not open suite list: %s\n", filename);
+		return false;
+	}
+
+	std::string dir(filename);
+	size_t slash = dir.rfind('/');
+	dir = (slash == std::string::npos) ? std::string() : dir.substr(0, slash + 1);
+
+	std::string line;
+
+	while (std::getline(list, line)) {
+		size_t start = line.find_first_not_of(" \t\r");
+
+		if (start == std::string::npos || line[start] == '#') { continue; }
+
+		size_t end = line.find_first_of(" \t\r", start);
+		std::string path = line.substr(start, end == std::string::npos ? std::string::npos : end - start);
+		int frames = end == std::string::npos ? 0 : atoi(line.c_str() + end);
+
+		if (path[0] != '/') { path = dir + path; }
+
+		bench_add(suite, path, frames);
+	}
+
+	return true;
+}
+
+static void bench_load_db(Emulator& emulator) {
+	// Load the image database so boards are detected as in the frontends
+	Cartridge::Database database(emulator);
+
+	const char *paths[] = { bconf.dbpath, "NstDatabase.xml",
+#ifdef DATADIR
+		DATADIR "/NstDatabase.xml",
+#endif
+		NULL };
+
+	for (int i = 0; i < (int)(sizeof(paths) / sizeof(paths[0])); i++) {
+		if (!paths[i]) { continue; }
+
+		std::ifstream db(paths[i], std::ifstream::in|std::ifstream::binary);
+
+		if (db.is_open()) {
+			database.Load(db);
+			database.Enable(true);
+			return;
+		}
+	}
+
+	if (bconf.dbpath) {
+		fprintf(stderr, "NstDatabase.xml not found: %s\n", bconf.dbpath);
+	}
+}
+
+static bool bench_load(Emulator& emulator, const benchrom_t& rom) {
+	// Load a ROM, apply the output settings and power on
+	Machine machine(emulator);
+	Video video(emulator);
+	Sound sound(emulator);
+
+	bench_load_db(emulator);
+
+	std::ifstream file(rom.path.c_str(), std::ios::in|std::ios::binary);
+
+	if (!file.is_open()) {
+		fprintf(stderr, "%s: could not open file\n", rom.path.c_str());
+		return false;
+	}
+
+	Nes::Result res = machine.Load(file, Machine::FAVORED_NES_NTSC);
+
+	if (NES_FAILED(res)) {
+		fprintf(stderr, "%s: load failed (%d)\n", rom.path.c_str(), res);
+		return false;
+	}
+
+	if (bconf.video) {
+		Video::RenderState renderstate;
+		renderstate.filter = benchfilter[bconf.filter].filter;
+		renderstate.width = benchfilter[bconf.filter].width;
+		renderstate.height = benchfilter[bconf.filter].height;
+		renderstate.bits.count = 32;
+		renderstate.bits.mask.r = 0x00ff0000;
+		renderstate.bits.mask.g = 0x0000ff00;
+		renderstate.bits.mask.b = 0x000000ff;
+
+		if (NES_FAILED(video.SetRenderState(renderstate))) {
+			fprintf(stderr, "Nestopia core rejected render state\n");
+			return false;
+		}
+
+		if (bconf.blitthreads || bconf.blitasync) {
+			res = video.SetBlitThreads(bconf.blitthreads ? bconf.blitthreads : 1, bconf.blitasync);
+
+			if (NES_FAILED(res)) {
+				fprintf(stderr, "%s: blit threads failed (%d)\n", rom.path.c_str(), res);
+				return false;
+			}
+		}
+	}
+
+	if (bconf.sound) {
+		sound.SetSampleBits(16);
+		sound.SetSpeaker(Sound::SPEAKER_MONO);
+		sound.SetSynthesis(bconf.bandlimited ? Sound::SYNTHESIS_BANDLIMITED : Sound::SYNTHESIS_SAMPLED);
+
+		if (NES_FAILED(sound.SetSampleRate(bconf.samplerate))) {
+			fprintf(stderr, "Nestopia core rejected sample rate %d\n", bconf.samplerate);
+			return false;
+		}
+	}
+
+	machine.Power(true);
+
+	if (bconf.runahead) {
+		RunAhead runahead(emulator);
+		Nes::Result res = runahead.SetFrames(bconf.runahead,
+			bconf.preemptive ? RunAhead::PREEMPTIVE : RunAhead::RERUN);
+
+		if (NES_FAILED(res)) {
+			fprintf(stderr, "%s: run-ahead failed (%d)\n", rom.path.c_str(), res);
+			return false;
+		}
+	}
+
+	if (bconf.rewind) {
+		Rewinder rewinder(emulator);
+		Nes::Result res = rewinder.SetStorage(
+			bconf.rewinddeltas ? Rewinder::DELTA_STATES : Rewinder::FULL_STATES,
+			bconf.rewind, bconf.rewindbudget * 1024UL);
+
+		if (NES_FAILED(res) || NES_FAILED(res = rewinder.Enable(true))) {
+			fprintf(stderr, "%s: rewinder failed (%d)\n", rom.path.c_str(), res);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static void bench_unload(Emulator& emulator) {
+	Machine machine(emulator);
+	machine.Power(false);
+	machine.Unload();
+}
+
+static void bench_input(Input::Controllers& controllers, int frame) {
+	// Scripted input, so run-ahead has something to mispredict
+	if (bconf.inputperiod) {
+		controllers.pad[0].buttons = (frame / bconf.inputperiod) & 1 ? Input::Controllers::Pad::A : 0;
+	}
+}
+
+static bool bench_run(const benchrom_t& rom, benchresult_t& result) {
+	// Load a ROM and time each emulated frame
+	Emulator emulator;
+
+	if (!bench_load(emulator, rom)) { return false; }
+
+	Video::Output videoout(videobuf, benchfilter[bconf.filter].width * sizeof(unsigned int));
+	Sound::Output soundout(audiobuf, bconf.samplerate / 60);
+	Input::Controllers controllers;
+
+	Video::Output *videoptr = bconf.video ? &videoout : NULL;
+	Sound::Output *soundptr = bconf.sound ? &soundout : NULL;
+
+	for (int i = 0; i < bconf.warmup; i++) {
+		emulator.Execute(videoptr, soundptr, &controllers);
+	}
+
+	Nes::Core::Machine& core = emulator;
+	memset(sectiontime, 0, sizeof(sectiontime));
+	core.profiler.Set(bench_cb_profile, NULL);
+
+	std::vector<uint64_t> frametimes(rom.frames);
+	uint64_t total = bench_time_ns();
+
+	for (int i = 0; i < rom.frames; i++) {
+		bench_input(controllers, i);
+
+		uint64_t start = bench_time_ns();
+		emulator.Execute(videoptr, soundptr, &controllers);
+		frametimes[i] = bench_time_ns() - start;
+	}
+
+	Video(emulator).FinishBlit();
+	total = bench_time_ns() - total;
+	core.profiler.Set(NULL, NULL);
+
+	result.rewindbytes = bconf.rewind ? Rewinder(emulator).GetMemoryUsage() : 0;
+	result.rollbacks = RunAhead(emulator).NumRollbacks();
+
+	bench_unload(emulator);
+
+	std::sort(frametimes.begin(), frametimes.end());
+
+	result.frames = rom.frames;
+	result.total = total;
+	result.p50 = bench_percentile(frametimes, 50);
+	result.p90 = bench_percentile(frametimes, 90);
+	result.p99 = bench_percentile(frametimes, 99);
+	result.max = frametimes.back();
+
+	for (int i = 0; i < Profiler::NUM_SECTIONS; i++) {
+		result.section[i] = sectiontime[i];
+	}
+
+	return true;
+}
+
+static const char* bench_basename(const std::string& path) {
+	size_t slash = path.rfind('/');
+	return path.c_str() + (slash == std::string::npos ? 0 : slash + 1);
+}
+
+static uint64_t bench_median(std::vector<uint64_t>& samples) {
+	std::sort(samples.begin(), samples.end());
+	return bench_percentile(samples, 50);
+}
+
+static bool bench_run_state(const benchrom_t& rom) {
+	// Time the stream save state path against in-memory snapshots,
+	// stepping one frame between iterations so the state keeps changing
+	static const char *methodname[4] = { "stream (zlib)", "stream (raw)", "snapshot", "buffer" };
+
+	Emulator emulator;
+	Machine machine(emulator);
+
+	if (!bench_load(emulator, rom)) { return false; }
+
+	Input::Controllers controllers;
+
+	for (int i = 0; i < bconf.warmup; i++) {
+		emulator.Execute(NULL, NULL, &controllers);
+	}
+
+	std::vector<uint64_t> savetimes[4], loadtimes[4];
+	size_t size[4] = { 0, 0, 0, 0 };
+	std::vector<unsigned char> buffer;
+	Machine::Snapshot snapshot;
+	std::stringstream stream;
+	Nes::Result res = Nes::RESULT_OK;
+
+	for (int m = 0; m < 4; m++) {
+		savetimes[m].resize(rom.frames);
+		loadtimes[m].resize(rom.frames);
+	}
+
+	for (int i = 0; i < rom.frames && NES_SUCCEEDED(res); i++) {
+		emulator.Execute(NULL, NULL, &controllers);
+
+		for (int m = 0; m < 2 && NES_SUCCEEDED(res); m++) {
+			stream.str(std::string());
+			stream.clear();
+
+			uint64_t start = bench_time_ns();
+			res = machine.SaveState(stream, m ? Machine::NO_COMPRESSION : Machine::USE_COMPRESSION);
+			savetimes[m][i] = bench_time_ns() - start;
+			size[m] = stream.str().size();
+
+			if (NES_FAILED(res)) { break; }
+
+			start = bench_time_ns();
+			res = machine.LoadState(stream);
+			loadtimes[m][i] = bench_time_ns() - start;
+		}
+
+		if (NES_FAILED(res)) { break; }
+
+		uint64_t start = bench_time_ns();
+		res = machine.SaveSnapshot(snapshot);
+		savetimes[2][i] = bench_time_ns() - start;
+		size[2] = snapshot.Size();
+
+		if (NES_FAILED(res)) { break; }
+
+		start = bench_time_ns();
+		res = machine.LoadSnapshot(snapshot);
+		loadtimes[2][i] = bench_time_ns() - start;
+
+		if (NES_FAILED(res)) { break; }
+
+		// Same sequence as the libretro serialize callbacks
+		start = bench_time_ns();
+		size[3] = machine.GetStateSize();
+		buffer.resize(size[3]);
+		res = machine.SaveState(&buffer[0], buffer.size());
+		savetimes[3][i] = bench_time_ns() - start;
+
+		if (NES_FAILED(res)) { break; }
+
+		start = bench_time_ns();
+		res = machine.LoadState(&buffer[0], buffer.size());
+		loadtimes[3][i] = bench_time_ns() - start;
+	}
+
+	bench_unload(emulator);
+
+	if (NES_FAILED(res)) {
+		fprintf(stderr, "%s: state failed (%d)\n", rom.path.c_str(), res);
+		return false;
+	}
+
+	if (!bconf.csv) { printf("%s\n", bench_basename(rom.path)); }
+
+	for (int m = 0; m < 4; m++) {
+		uint64_t save = bench_median(savetimes[m]);
+		uint64_t load = bench_median(loadtimes[m]);
+
+		if (bconf.csv) {
+			printf("%s,%s,%llu,%llu,%lu\n", rom.path.c_str(), methodname[m],
+				(unsigned long long)save, (unsigned long long)load, (unsigned long)size[m]);
+		}
+		else {
+			printf("  %-14s save %9llu ns  load %9llu ns  %7lu bytes\n", methodname[m],
+				(unsigned long long)save, (unsigned long long)load, (unsigned long)size[m]);
+		}
+	}
+
+	return true;
+}
+
+static bool bench_run_hash(const benchrom_t& rom) {
+	// Power two instances of the same ROM and feed them the same input,
+	// comparing their state hashes after power-on and after every frame.
+	// The second is built on heap memory filled with 0x01 rather than zeros,
+	// so a member its constructor forgot shows up as a set flag or mode.
+	Emulator *emulator[2];
+	Input::Controllers controllers;
+	bool loaded = true;
+	int mismatch = -1;
+
+	for (int j = 0; j < 2; j++) {
+		benchheapfill = j ? 0x01 : 0x00;
+		emulator[j] = new Emulator;
+		loaded = bench_load(*emulator[j], rom) && loaded;
+		benchheapfill = -1;
+	}
+
+	for (int i = 0; i <= rom.frames && loaded; i++) {
+		if (i) {
+			bench_input(controllers, i - 1);
+
+			for (int j = 0; j < 2; j++) {
+				emulator[j]->Execute(NULL, NULL, &controllers);
+			}
+		}
+
+		if (emulator[0]->GetStateHash() != emulator[1]->GetStateHash()) {
+			mismatch = i;
+			break;
+		}
+	}
+
+	unsigned long hash = emulator[0]->GetStateHash();
+
+	for (int j = 0; j < 2; j++) {
+		bench_unload(*emulator[j]);
+		delete emulator[j];
+	}
+
+	if (!loaded) { return false; }
+
+	if (bconf.csv) {
+		printf("%s,%d,%d,%08lx\n", rom.path.c_str(), rom.frames, mismatch, hash);
+	}
+	else if (mismatch < 0) {
+		printf("%s\n  %d frames, state hashes match (%08lx)\n", bench_basename(rom.path), rom.frames, hash);
+	}
+	else {
+		printf("%s\n  state hashes differ after %d frames\n", bench_basename(rom.path), mismatch);
+	}
+
+	return mismatch < 0;
+}
+
+static bool bench_run_simd(const benchrom_t& rom) {
+	// Render each ROM through every filter with an SSE2 path, in each pixel
+	// format it takes, on two instances fed the same input: one with SIMD
+	// enabled, one forced onto the scalar path. Every frame must match.
+	static const struct {
+		const char *name;
+		int bpp;
+		unsigned long r, g, b;
+	} formats[] = {
+		{ "888", 32, 0x00ff0000, 0x0000ff00, 0x000000ff },
+		{ "565", 16, 0xf800, 0x07e0, 0x001f },
+		{ "555", 16, 0x7c00, 0x03e0, 0x001f }
+	};
+
+	bool ok = true;
+
+	for (int f = 0; f < benchfilters; f++) {
+		if (strncmp(benchfilter[f].name, "hq", 2) && strncmp(benchfilter[f].name, "xbr", 3)) { continue; }
+
+		for (size_t k = 0; k < sizeof(formats) / sizeof(formats[0]); k++) {
+			Emulator emulator[2];
+			std::vector<unsigned char> buf[2];
+			Input::Controllers controllers;
+			const long pitch = benchfilter[f].width * (formats[k].bpp / 8);
+			bool loaded = true;
+			int mismatch = -1;
+
+			for (int j = 0; j < 2; j++) {
+				buf[j].resize(pitch * benchfilter[f].height);
+
+				if (!bench_load(emulator[j], rom)) {
+					loaded = false;
+					break;
+				}
+
+				Video video(emulator[j]);
+				Video::RenderState renderstate;
+				renderstate.filter = benchfilter[f].filter;
+				renderstate.width = benchfilter[f].width;
+				renderstate.height = benchfilter[f].height;
+				renderstate.bits.count = formats[k].bpp;
+				renderstate.bits.mask.r = formats[k].r;
+				renderstate.bits.mask.g = formats[k].g;
+				renderstate.bits.mask.b = formats[k].b;
+
+				if (NES_FAILED(video.SetRenderState(renderstate)) || NES_FAILED(video.EnableSimd(j == 0))) {
+					fprintf(stderr, "Nestopia core rejected render state\n");
+					loaded = false;
+					break;
+				}
+			}
+
+			for (int i = 0; i < rom.frames && loaded; i++) {
+				bench_input(controllers, i);
+
+				for (int j = 0; j < 2; j++) {
+					Video::Output videoout(&buf[j][0], pitch);
+					emulator[j].Execute(&videoout, NULL, &controllers);
+					Video(emulator[j]).FinishBlit();
+				}
+
+				if (buf[0] != buf[1]) {
+					mismatch = i;
+					break;
+				}
+			}
+
+			if (!loaded) { return false; }
+
+			if (bconf.csv) {
+				printf("%s,%s,%s,%d,%d\n", rom.path.c_str(), benchfilter[f].name, formats[k].name, rom.frames, mismatch);
+			}
+			else if (mismatch < 0) {
+				printf("%s %s %s\n  %d frames, SSE2 and scalar output match\n", bench_basename(rom.path), benchfilter[f].name, formats[k].name, rom.frames);
+			}
+			else {
+				printf("%s %s %s\n  SSE2 and scalar output differ at frame %d\n", bench_basename(rom.path), benchfilter[f].name, formats[k].name, mismatch);
+			}
+
+			for (int j = 0; j < 2; j++) {
+				bench_unload(emulator[j]);
+			}
+
+			ok = ok && mismatch < 0;
+		}
+	}
+
+	return ok;
+}
+
+static void bench_put_chunk(std::string& image, const char *id, const std::string& data) {
+	// UNIF chunk: four character id, little-endian length, payload
+	image.append(id, 4);
+
+	for (int i = 0; i < 32; i += 8) {
+		image += (char)(data.size() >> i & 0xFF);
+	}
+
+	image += data;
+}
+
+static bool bench_run_boards() {
+	// Load a minimal UNIF image naming each board the core knows,
+	// timing board detection and setup through the normal load path
+	typedef Nes::Core::Boards::Board::Context BoardContext;
+
+	std::string header("UNIF", 4);
+	header += std::string(1, (char)7) + std::string(27, '\0');
+
+	const std::string prg(BENCH_BOARD_PRG_SIZE, '\0');
+	const std::string chr(BENCH_BOARD_CHR_SIZE, '\0');
+
+	Emulator emulator;
+	Machine machine(emulator);
+	std::vector<uint64_t> times;
+	int failed = 0;
+
+	for (unsigned int i = 0; i < BoardContext::NumNames(); i++) {
+		const char *name = BoardContext::GetName(i);
+		std::string image(header);
+
+		bench_put_chunk(image, "MAPR", std::string(name, strlen(name) + 1));
+		bench_put_chunk(image, "PRG0", prg);
+		bench_put_chunk(image, "CHR0", chr);
+
+		std::istringstream stream(image);
+
+		uint64_t start = bench_time_ns();
+		Nes::Result res = machine.Load(stream, Machine::FAVORED_NES_NTSC);
+		uint64_t time = bench_time_ns() - start;
+
+		if (NES_FAILED(res)) {
+			fprintf(stderr, "%s: load failed (%d)\n", name, res);
+			failed++;
+			continue;
+		}
+
+		machine.Unload();
+		times.push_back(time);
+
+		if (bconf.csv) { printf("%s,%llu\n", name, (unsigned long long)time); }
+	}
+
+	if (times.empty()) { return false; }
+
+	std::sort(times.begin(), times.end());
+
+	if (!bconf.csv) {
+		printf("boards: %d loaded, %d failed\n", (int)times.size(), failed);
+		printf("  ns/load: p50 %llu  p90 %llu  p99 %llu  max %llu\n",
+			(unsigned long long)bench_percentile(times, 50), (unsigned long long)bench_percentile(times, 90),
+			(unsigned long long)bench_percentile(times, 99), (unsigned long long)times.back());
+	}
+
+	return true;
+}
+
+typedef struct {
+	Emulator emulator;
+	unsigned int videobuf[Video::Output::NTSC_WIDTH * Video::Output::HEIGHT];
+	short audiobuf[Sound::Output::MAX_LENGTH];
+	Video::Output videoout;
+	Sound::Output soundout;
+	Input::Controllers controllers;
+} benchinst_t;
+
+static void bench_job_frame(void *userdata, int index) {
+	// Step one instance by one frame, called concurrently for different instances
+	benchinst_t *inst = ((benchinst_t**)userdata)[index];
+
+	inst->emulator.Execute(bconf.video ? &inst->videoout : NULL,
+		bconf.sound ? &inst->soundout : NULL, &inst->controllers);
+}
+
+static bool bench_run_batch(const benchrom_t& rom, benchresult_t& result, batch_t *batch) {
+	// Step a batch of independent instances of the same ROM in lockstep,
+	// timing how long each step of one frame per instance takes
+	std::vector<benchinst_t*> insts;
+	bool loaded = true;
+
+	for (int i = 0; i < bconf.instances && loaded; i++) {
+		benchinst_t *inst = new benchinst_t;
+		inst->videoout.pixels = inst->videobuf;
+		inst->videoout.pitch = Video::Output::WIDTH * sizeof(unsigned int);
+		inst->soundout.samples[0] = inst->audiobuf;
+		inst->soundout.length[0] = bconf.samplerate / 60;
+		insts.push_back(inst);
+
+		loaded = bench_load(inst->emulator, rom);
+	}
+
+	if (loaded) {
+		for (int i = 0; i < bconf.warmup; i++) {
+			batch_run(batch, insts.size(), bench_job_frame, &insts[0]);
+		}
+
+		std::vector<uint64_t> steptimes(rom.frames);
+		uint64_t total = bench_time_ns();
+
+		for (int i = 0; i < rom.frames; i++) {
+			uint64_t start = bench_time_ns();
+			batch_run(batch, insts.size(), bench_job_frame, &insts[0]);
+			steptimes[i] = bench_time_ns() - start;
+		}
+
+		total = bench_time_ns() - total;
+
+		std::sort(steptimes.begin(), steptimes.end());
+
+		result.frames = rom.frames * bconf.instances;
+		result.total = total;
+		result.p50 = bench_percentile(steptimes, 50);
+		result.p90 = bench_percentile(steptimes, 90);
+		result.p99 = bench_percentile(steptimes, 99);
+		result.max = steptimes.back();
+		memset(result.section, 0, sizeof(result.section));
+		result.rewindbytes = bconf.rewind ? Rewinder(insts[0]->emulator).GetMemoryUsage() : 0;
+		result.rollbacks = RunAhead(insts[0]->emulator).NumRollbacks();
+	}
+
+	for (size_t i = 0; i < insts.size(); i++) {
+		bench_unload(insts[i]->emulator);
+		delete insts[i];
+	}
+
+	return loaded;
+}
+
+static void bench_print(const benchrom_t& rom, const benchresult_t& r) {
+	double fps = r.total ? r.frames * 1e9 / r.total : 0.0;
+
+	if (bconf.csv) {
+		printf("%s,%d,%.1f,%llu,%llu,%llu,%llu", rom.path.c_str(), r.frames, fps,
+			(unsigned long long)r.p50, (unsigned long long)r.p90,
+			(unsigned long long)r.p99, (unsigned long long)r.max);
+
+		for (int i = 0; i < Profiler::NUM_SECTIONS; i++) {
+			printf(",%llu", (unsigned long long)(r.section[i] / r.frames));
+		}
+
+		if (bconf.rewind) { printf(",%lu", r.rewindbytes); }
+		if (bconf.runahead) { printf(",%lu", r.rollbacks); }
+
+		printf("\n");
+		return;
+	}
+
+	printf("%s\n", bench_basename(rom.path));
+
+	if (bconf.instances) {
+		printf("  %d instances on %d threads, %d frames in %.3f s, %.1f fps (%.1f fps per instance)\n",
+			bconf.instances, bconf.threads, r.frames, r.total / 1e9, fps, fps / bconf.instances);
+		printf("  ns/step: p50 %llu  p90 %llu  p99 %llu  max %llu\n",
+			(unsigned long long)r.p50, (unsigned long long)r.p90,
+			(unsigned long long)r.p99, (unsigned long long)r.max);
+		return;
+	}
+
+	printf("  %d frames in %.3f s, %.1f fps\n", r.frames, r.total / 1e9, fps);
+	printf("  ns/frame: p50 %llu  p90 %llu  p99 %llu  max %llu\n",
+		(unsigned long long)r.p50, (unsigned long long)r.p90,
+		(unsigned long long)r.p99, (unsigned long long)r.max);
+
+	if (bconf.rewind) {
+		printf("  rewinder: %s, %d s, %lu KB\n", bconf.rewinddeltas ? "deltas" : "full states",
+			bconf.rewind, r.rewindbytes / 1024);
+	}
+
+	if (bconf.runahead) {
+		printf("  run-ahead: %s, %d frames, %lu rollbacks\n", bconf.preemptive ? "preemptive" : "rerun",
+			bconf.runahead, r.rollbacks);
+	}
+
+#ifdef NST_PROFILE
+	for (int i = 0; i < Profiler::NUM_SECTIONS; i++) {
+		printf("  %-18s %10llu ns/frame  %5.1f%%\n", sectionname[i],
+			(unsigned long long)(r.section[i] / r.frames),
+			r.total ? r.section[i] * 100.0 / r.total : 0.0);
+	}
+#endif
+}
+
+int main(int argc, char *argv[]) {
+	std::vector<benchrom_t> suite;
+	std::vector<const char*> lists;
+	int c;
+
+	bconf.frames = BENCH_DEFAULT_FRAMES;
+	bconf.warmup = BENCH_DEFAULT_WARMUP;
+	bconf.video = false;
+	bconf.sound = false;
+	bconf.samplerate = BENCH_DEFAULT_SAMPLE_RATE;
+	bconf.bandlimited = false;
+	bconf.csv = false;
+	bconf.states = false;
+	bconf.threads = 0;
+	bconf.instances = 0;
+	bconf.rewind = 0;
+	bconf.rewinddeltas = false;
+	bconf.rewindbudget = 0;
+	bconf.runahead = 0;
+	bconf.preemptive = false;
+	bconf.inputperiod = 0;
+	bconf.filter = 0;
+	bconf.blitthreads = 0;
+	bconf.blitasync = false;
+	bconf.dbpath = NULL;
+	bconf.boards = false;
+	bconf.hashes = false;
+	bconf.simd = false;
+
+	while ((c = getopt(argc, argv, "f:w:l:d:vF:b:Bsk:LcSn:j:r:Rm:a:Ai:UHXh")) != -1) {
+		switch (c) {
+			case 'f': bconf.frames = atoi(optarg); break;
+			case 'w': bconf.warmup = atoi(optarg); break;
+			case 'l': lists.push_back(optarg); break;
+			case 'd': bconf.dbpath = optarg; break;
+			case 'v': bconf.video = true; break;
+			case 'F': bconf.filter = bench_find_filter(optarg); bconf.video = true; break;
+			case 'b': bconf.blitthreads = atoi(optarg); break;
+			case 'B': bconf.blitasync = true; break;
+			case 's': bconf.sound = true; break;
+			case 'k': bconf.samplerate = atoi(optarg); break;
+			case 'L': bconf.bandlimited = true; break;
+			case 'c': bconf.csv = true; break;
+			case 'S': bconf.states = true; break;
+			case 'n': bconf.instances = atoi(optarg); break;
+			case 'j': bconf.threads = atoi(optarg); break;
+			case 'r': bconf.rewind = atoi(optarg); break;
+			case 'R': bconf.rewinddeltas = true; break;
+			case 'm': bconf.rewindbudget = atoi(optarg); break;
+			case 'a': bconf.runahead = atoi(optarg); break;
+			case 'A': bconf.preemptive = true; break;
+			case 'i': bconf.inputperiod = atoi(optarg); break;
+			case 'U': bconf.boards = true; break;
+			case 'H': bconf.hashes = true; break;
+			case 'X': bconf.simd = true; break;
+			case 'h': bench_usage(); return 0;
+			default: bench_usage(); return 1;
+		}
+	}
+
+	if (bconf.threads <= 0) {
+		long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+		bconf.threads = cpus > 0 ? (int)cpus : 1;
+	}
+
+	if (bconf.threads > BENCH_MAX_THREADS) { bconf.threads = BENCH_MAX_THREADS; }
+
+	if (bconf.frames <= 0 || bconf.warmup < 0 || bconf.instances < 0 ||
+		bconf.rewind < 0 || bconf.rewindbudget < 0 ||
+		bconf.runahead < 0 || bconf.inputperiod < 0 || bconf.blitthreads < 0 ||
+		bconf.filter < 0 || (bconf.filter && bconf.instances) ||
+		bconf.samplerate / 60 <= 0 || bconf.samplerate / 60 > Sound::Output::MAX_LENGTH) {
+		bench_usage();
+		return 1;
+	}
+
+	for (size_t i = 0; i < lists.size(); i++) {
+		if (!bench_load_list(suite, lists[i])) { return 1; }
+	}
+
+	for (int i = optind; i < argc; i++) {
+		bench_add_arg(suite, argv[i]);
+	}
+
+	if (bconf.boards) {
+		if (bconf.csv) { printf("board,load_ns\n"); }
+
+		return bench_run_boards() ? 0 : 1;
+	}
+
+	if (suite.empty()) {
+		bench_usage();
+		return 1;
+	}
+
+#ifndef NST_PROFILE
+	if (!bconf.csv && !bconf.instances && !bconf.states && !bconf.hashes && !bconf.simd) {
+		fprintf(stderr, "Built without NST_PROFILE, per-subsystem times unavailable\n");
+	}
+#endif
+
+	if (bconf.states) {
+		if (bconf.csv) { printf("rom,method,save_ns,load_ns,bytes\n"); }
+
+		int failed = 0;
+
+		for (size_t i = 0; i < suite.size(); i++) {
+			if (!bench_run_state(suite[i])) { failed++; }
+		}
+
+		return failed ? 1 : 0;
+	}
+
+	if (bconf.hashes) {
+		if (bconf.csv) { printf("rom,frames,mismatch_frame,hash\n"); }
+
+		int failed = 0;
+
+		for (size_t i = 0; i < suite.size(); i++) {
+			if (!bench_run_hash(suite[i])) { failed++; }
+		}
+
+		return failed ? 1 : 0;
+	}
+
+	if (bconf.simd) {
+		if (bconf.csv) { printf("rom,filter,format,frames,mismatch_frame\n"); }
+
+		int failed = 0;
+
+		for (size_t i = 0; i < suite.size(); i++) {
+			if (!bench_run_simd(suite[i])) { failed++; }
+		}
+
+		return failed ? 1 : 0;
+	}
+
+	if (bconf.csv) {
+		printf("rom,frames,fps,p50_ns,p90_ns,p99_ns,max_ns");
+
+		for (int i = 0; i < Profiler::NUM_SECTIONS; i++) {
+			printf(",%s_ns", sectionname[i]);
+		}
+
+		if (bconf.rewind) { printf(",rewind_bytes"); }
+		if (bconf.runahead) { printf(",rollbacks"); }
+
+		printf("\n");
+	}
+
+	int failed = 0;
+	uint64_t frames = 0, total = 0;
+	batch_t *batch = bconf.instances ? batch_create(bconf.threads) : NULL;
+
+	if (batch) { bconf.threads = batch_threads(batch); }
+
+	for (size_t i = 0; i < suite.size(); i++) {
+		benchresult_t result;
+
+		if (batch ? !bench_run_batch(suite[i], result, batch) : !bench_run(suite[i], result)) {
+			failed++;
+			continue;
+		}
+
+		bench_print(suite[i], result);
+		frames += result.frames;
+		total += result.total;
+	}
+
+	if (!bconf.csv && suite.size() > 1 && total) {
+		printf("suite: %llu frames, %.1f fps\n", (unsigned long long)frames, frames * 1e9 / total);
+	}
+
+	if (batch) { batch_destroy(batch); }
+
+	return failed ? 1 : 0;
+}
@@ -0,0 +1,80 @@
+/*
+ * Nestopia UE
+ *
+ * Copyright (C) 2026 R. Danbrook
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ *
+ */
+
+#ifndef _BENCH_H_
+#define _BENCH_H_
+
+#include <stdint.h>
+#include <string>
+
+#define BENCH_DEFAULT_FRAMES 600
+#define BENCH_DEFAULT_WARMUP 60
+#define BENCH_DEFAULT_SAMPLE_RATE 48000
+#define BENCH_NUM_SECTIONS 3
+#define BENCH_MAX_THREADS 256
+#define BENCH_BOARD_PRG_SIZE 0x20000
+#define BENCH_BOARD_CHR_SIZE 0x10000
+
+typedef struct {
+	int frames;
+	int warmup;
+	bool video;
+	bool sound;
+	int samplerate;
+	bool bandlimited;
+	bool csv;
+	bool states;
+	int threads;
+	int instances;
+	int rewind;
+	bool rewinddeltas;
+	int rewindbudget;
+	int runahead;
+	bool preemptive;
+	int inputperiod;
+	int filter;
+	int blitthreads;
+	bool blitasync;
+	const char *dbpath;
+	bool boards;
+	bool hashes;
+	bool simd;
+} benchconf_t;
+
+typedef struct {
+	std::string path;
+	int frames;
+} benchrom_t;
+
+typedef struct {
+	int frames;
+	uint64_t total;
+	uint64_t p50;
+	uint64_t p90;
+	uint64_t p99;
+	uint64_t max;
+	uint64_t section[BENCH_NUM_SECTIONS];
+	unsigned long rewindbytes;
+	unsigned long rollbacks;
+} benchresult_t;
+
+#endif
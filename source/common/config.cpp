@@ -138,6 +138,10 @@ void config_file_write(const char *nstdir) {
 		fprintf(fp, "; 0=0x00, 1=0xFF, 2=Random\n");
 		fprintf(fp, "power_state=%d\n", conf.misc_power_state);
 		fprintf(fp, "overclock=%d\n\n", conf.misc_overclock);
+		fprintf(fp, "; Valid values are 0 (disabled) to 8 frames.\n");
+		fprintf(fp, "runahead=%d\n", conf.misc_runahead);
+		fprintf(fp, "; Valid values are 1 and 0.\n");
+		fprintf(fp, "runahead_preemptive=%d\n\n", conf.misc_runahead_preemptive);
 		fprintf(fp, "; Valid values are -1 (disabled) or 0 to 65535.\n");
 		fprintf(fp, "homebrew_exit=%d\n", conf.misc_homebrew_exit);
 		fprintf(fp, "homebrew_stdout=%d\n", conf.misc_homebrew_stdout);
@@ -217,6 +221,8 @@ void config_set_default() {
 	conf.misc_last_folder = NULL;
 	conf.misc_power_state = 0;
 	conf.misc_overclock = false;
+	conf.misc_runahead = 0;
+	conf.misc_runahead_preemptive = false;
 	conf.misc_homebrew_exit = -1;
 	conf.misc_homebrew_stdout = -1;
 	conf.misc_homebrew_stderr = -1;
@@ -290,6 +296,8 @@ static int config_match(void* user, const char* section, const char* name, const
 	else if (MATCH("misc", "last_folder")) { pconfig->misc_last_folder = strdup(value); }
 	else if (MATCH("misc", "power_state")) { pconfig->misc_power_state = atoi(value); }
 	else if (MATCH("misc", "overclock")) { pconfig->misc_overclock = atoi(value); }
+	else if (MATCH("misc", "runahead")) { pconfig->misc_runahead = atoi(value); }
+	else if (MATCH("misc", "runahead_preemptive")) { pconfig->misc_runahead_preemptive = atoi(value); }
 	else if (MATCH("misc", "homebrew_exit")) { pconfig->misc_homebrew_exit = atoi(value); }
 	else if (MATCH("misc", "homebrew_stdout")) { pconfig->misc_homebrew_stdout = atoi(value); }
 	else if (MATCH("misc", "homebrew_stderr")) { pconfig->misc_homebrew_stderr = atoi(value); }
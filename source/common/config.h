@@ -63,6 +63,8 @@ typedef struct {
 	char* misc_last_folder;
 	int misc_power_state;
 	bool misc_overclock;
+	int misc_runahead;
+	bool misc_runahead_preemptive;
 	int misc_homebrew_exit;
 	int misc_homebrew_stdout;
 	int misc_homebrew_stderr;
@@ -41,6 +41,9 @@
 #ifndef _MINGW
 #include <archive.h>
 #include <archive_entry.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
 #endif
 
 // Nst Common
@@ -64,6 +67,8 @@ static bool ffspeed = false;
 static bool playing = false;
 
 static std::ifstream *nstdb;
+static void *nstdbmap;
+static size_t nstdbmapsize;
 
 static std::ifstream *fdsbios;
 
@@ -75,6 +80,155 @@ static size_t custpalsize;
 
 bool (*nst_archive_select)(const char*, char*, size_t);
 
+// Battery saves are handed to a writer thread so the emulation loop never waits on the disk
+#define SAVE_FLUSH_FRAMES 300 // roughly every five seconds
+
+static struct {
+	SDL_Thread *thread;
+	SDL_mutex *lock;
+	SDL_cond *cond;
+	unsigned char *data; // latest content not yet written, replaces anything older
+	size_t size;
+	size_t capacity;
+	bool pending;
+	bool quit;
+	char path[512];
+} savewriter;
+
+static int flushcounter = 0;
+
+static void nst_save_write(const char *path, const void *data, size_t size) {
+	// Write to a temporary file and move it over the old one, so a crash never leaves half a save
+	char tmpname[520];
+	snprintf(tmpname, sizeof(tmpname), "%s.tmp", path);
+	
+	FILE *file = fopen(tmpname, "wb");
+	if (!file) { return; }
+	
+	bool ok = fwrite(data, 1, size, file) == size;
+	ok = fflush(file) == 0 && ok;
+#ifndef _MINGW
+	ok = fsync(fileno(file)) == 0 && ok;
+#endif
+	ok = fclose(file) == 0 && ok;
+	
+	if (!ok) {
+		fprintf(stderr, "Failed to write %s\n", path);
+		remove(tmpname);
+		return;
+	}
+	
+#ifdef _MINGW
+	remove(path);
+#endif
+	if (rename(tmpname, path)) {
+		fprintf(stderr, "Failed to replace %s\n", path);
+		remove(tmpname);
+	}
+}
+
+static int nst_save_thread(void *data) {
+	unsigned char *buffer = NULL;
+	size_t capacity = 0;
+	char path[512];
+	
+	SDL_LockMutex(savewriter.lock);
+	
+	for (;;) {
+		while (!savewriter.pending && !savewriter.quit) {
+			SDL_CondWait(savewriter.cond, savewriter.lock);
+		}
+		
+		if (!savewriter.pending) { break; }
+		
+		// Swap buffers so the emulation thread can queue the next save while this one is written
+		unsigned char *swap = buffer;
+		buffer = savewriter.data;
+		savewriter.data = swap;
+		
+		size_t size = savewriter.size;
+		size_t swapcap = capacity;
+		capacity = savewriter.capacity;
+		savewriter.capacity = swapcap;
+		
+		snprintf(path, sizeof(path), "%s", savewriter.path);
+		savewriter.pending = false;
+		
+		SDL_UnlockMutex(savewriter.lock);
+		nst_save_write(path, buffer, size);
+		SDL_LockMutex(savewriter.lock);
+	}
+	
+	SDL_UnlockMutex(savewriter.lock);
+	free(buffer);
+	
+	return 0;
+}
+
+static void nst_save_queue(const char *path, const void *data, size_t size) {
+	// Copy the content and wake the writer, starting it on the first save of the session
+	if (!savewriter.thread) {
+		savewriter.lock = SDL_CreateMutex();
+		savewriter.cond = SDL_CreateCond();
+		savewriter.quit = false;
+		
+		if (savewriter.lock && savewriter.cond) {
+			savewriter.thread = SDL_CreateThread(nst_save_thread, "nst_save", NULL);
+		}
+		
+		if (!savewriter.thread) {
+			if (savewriter.cond) { SDL_DestroyCond(savewriter.cond); savewriter.cond = NULL; }
+			if (savewriter.lock) { SDL_DestroyMutex(savewriter.lock); savewriter.lock = NULL; }
+			nst_save_write(path, data, size);
+			return;
+		}
+	}
+	
+	SDL_LockMutex(savewriter.lock);
+	
+	if (savewriter.capacity < size) {
+		unsigned char *grown = (unsigned char*)realloc(savewriter.data, size);
+		
+		if (!grown) {
+			SDL_UnlockMutex(savewriter.lock);
+			fprintf(stderr, "Out of memory for %s\n", path);
+			return;
+		}
+		
+		savewriter.data = grown;
+		savewriter.capacity = size;
+	}
+	
+	memcpy(savewriter.data, data, size);
+	savewriter.size = size;
+	snprintf(savewriter.path, sizeof(savewriter.path), "%s", path);
+	savewriter.pending = true;
+	
+	SDL_CondSignal(savewriter.cond);
+	SDL_UnlockMutex(savewriter.lock);
+}
+
+static void nst_save_finish() {
+	// Let the writer get through whatever is queued, then stop it
+	if (!savewriter.thread) { return; }
+	
+	SDL_LockMutex(savewriter.lock);
+	savewriter.quit = true;
+	SDL_CondSignal(savewriter.cond);
+	SDL_UnlockMutex(savewriter.lock);
+	
+	SDL_WaitThread(savewriter.thread, NULL);
+	SDL_DestroyCond(savewriter.cond);
+	SDL_DestroyMutex(savewriter.lock);
+	free(savewriter.data);
+	
+	savewriter.thread = NULL;
+	savewriter.cond = NULL;
+	savewriter.lock = NULL;
+	savewriter.data = NULL;
+	savewriter.size = savewriter.capacity = 0;
+}
+
 static bool NST_CALLBACK nst_cb_videolock(void* userData, Video::Output& video) {
 	video.pitch = video_lock_screen(video.pixels);
 	return true; // true=lock success, false=lock failed (Nestopia will carry on but skip video)
@@ -147,13 +301,12 @@ static void NST_CALLBACK nst_cb_file(void *userData, User::File& file) {
 		case User::File::SAVE_TAPE: // for saving Famicom cassette tapes
 		case User::File::SAVE_TURBOFILE: // for saving turbofile data
 		{
-			std::ofstream batteryFile(nstpaths.savename, std::ifstream::out|std::ifstream::binary);
 			const void* savedata;
 			unsigned long savedatasize;
 
-			file.GetContent(savedata, savedatasize);
-
-			if (batteryFile.is_open()) { batteryFile.write((const char*) savedata, savedatasize); }
+			if (NES_SUCCEEDED(file.GetContent(savedata, savedatasize)) && savedatasize) {
+				nst_save_queue(nstpaths.savename, savedata, savedatasize);
+			}
 
 			break;
 		}
@@ -325,13 +478,48 @@ bool nst_archive_open(const char *filename, char **rom, int *romsize, const char
 	return false;
 }
 
+static bool nst_db_load_compiled(const char *dbpath) {
+	// Load a compiled database (NstDatabase.bin), mapped and searched in place
+	Nes::Api::Cartridge::Database database(emulator);
+#ifndef _MINGW
+	int fd = open(dbpath, O_RDONLY);
+	if (fd < 0) { return false; }
+	
+	struct stat st;
+	void *map = MAP_FAILED;
+	
+	if (fstat(fd, &st) == 0 && st.st_size > 0) {
+		map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	}
+	close(fd);
+	
+	if (map == MAP_FAILED) { return false; }
+	
+	if (NES_FAILED(database.Load(map, st.st_size))) {
+		munmap(map, st.st_size);
+		return false;
+	}
+	
+	nstdbmap = map;
+	nstdbmapsize = st.st_size;
+#else
+	std::ifstream dbfile(dbpath, std::ifstream::in|std::ifstream::binary);
+	if (!dbfile.is_open() || NES_FAILED(database.Load(dbfile))) { return false; }
+#endif
+	database.Enable(true);
+	return true;
+}
+
 void nst_db_load() {
 	Nes::Api::Cartridge::Database database(emulator);
 	char dbpath[512];
 
-	if (nstdb) { return; }
+	if (nstdb || nstdbmap) { return; }
+
+	// Try the user's directory first, the compiled database before the XML
+	snprintf(dbpath, sizeof(dbpath), "%sNstDatabase.bin", nstpaths.nstdir);
+	if (nst_db_load_compiled(dbpath)) { return; }
 
-	// Try to open the database file
 	snprintf(dbpath, sizeof(dbpath), "%sNstDatabase.xml", nstpaths.nstdir);
 	nstdb = new std::ifstream(dbpath, std::ifstream::in|std::ifstream::binary);
 	
@@ -342,6 +530,12 @@ void nst_db_load() {
 	}
 #ifndef _MINGW
 	// If it fails, try looking in the data directory
+	delete nstdb;
+	nstdb = NULL;
+
+	snprintf(dbpath, sizeof(dbpath), "%s/NstDatabase.bin", DATADIR);
+	if (nst_db_load_compiled(dbpath)) { return; }
+
 	snprintf(dbpath, sizeof(dbpath), "%s/NstDatabase.xml", DATADIR);
 	nstdb = new std::ifstream(dbpath, std::ifstream::in|std::ifstream::binary);
 	
@@ -371,6 +565,13 @@ void nst_db_load() {
 
 void nst_db_unload() {
 	if (nstdb) { delete nstdb; nstdb = NULL; }
+#ifndef _MINGW
+	if (nstdbmap) {
+		Nes::Api::Cartridge::Database(emulator).Unload();
+		munmap(nstdbmap, nstdbmapsize);
+		nstdbmap = NULL;
+	}
+#endif
 }
 
 void nst_dipswitch() {
@@ -744,6 +945,13 @@ void nst_set_overclock() {
 	video.EnableOverclocking(conf.misc_overclock);
 }
 
+void nst_set_runahead() {
+	// Set the number of frames to run ahead, trading CPU time for input latency
+	RunAhead runahead(emulator);
+	runahead.SetFrames(conf.misc_runahead < 0 ? 0 : conf.misc_runahead,
+		conf.misc_runahead_preemptive ? RunAhead::PREEMPTIVE : RunAhead::RERUN);
+}
+
 void nst_set_region() {
 	// Set the region
 	Machine machine(emulator);
@@ -863,6 +1071,13 @@ void nst_emuloop() {
 		// Execute frames
 		for (int i = 0; i < nst_timing_runframes(); i++) {
 			emulator.Execute(cNstVideo, cNstSound, cNstPads);
+			flushcounter++;
+		}
+		
+		// Keep the battery save current in case the program doesn't exit cleanly
+		if (flushcounter >= SAVE_FLUSH_FRAMES) {
+			User(emulator).Flush();
+			flushcounter = 0;
 		}
 	}
 }
@@ -876,6 +1091,10 @@ void nst_unload() {
 
 	// Remove the cartridge
 	machine.Unload();
+	
+	// Wait for the battery save to reach the disk
+	nst_save_finish();
+	flushcounter = 0;
 }
 
 void nst_pause() {
@@ -939,25 +1158,20 @@ int nst_load(const char *filename) {
 		// Extract the contents
 		nst_archive_open(filename, &rom, &romsize, reqfile);
 		
-		// Convert the malloc'd char* to an istream
-		std::string rombuf(rom, romsize);
-		std::istringstream file(rombuf);
+		// Load straight from the malloc'd buffer
+		result = machine.Load(rom, romsize, nst_default_system());
 		free(rom);
-		
-		result = machine.Load(file, nst_default_system());
 	}
-	else { // Otherwise just load the file
-		std::ifstream file(filename, std::ios::in|std::ios::binary);
-		
+	else { // Otherwise just load the file, the core maps it
 		// Set the file paths
 		nst_set_paths(filename);
 		
 		if (nst_find_patch(patchname, sizeof(patchname), filename)) { // Load with a patch if there is one
 			std::ifstream pfile(patchname, std::ios::in|std::ios::binary);
 			Machine::Patch patch(pfile, false);
-			result = machine.Load(file, nst_default_system(), patch);
+			result = machine.Load(filename, nst_default_system(), patch);
 		}
-		else { result = machine.Load(file, nst_default_system()); }
+		else { result = machine.Load(filename, nst_default_system()); }
 	}
 	
 	if (NES_FAILED(result)) {
@@ -1017,6 +1231,9 @@ int nst_load(const char *filename) {
 	// Set video overclocking
 	nst_set_overclock();
 	
+	// Set run-ahead
+	nst_set_runahead();
+	
 	// Set the RAM's power state
 	machine.SetRamPowerState(conf.misc_power_state);
 	
@@ -11,6 +11,7 @@
 #include "core/api/NstApiNsf.hpp"
 #include "core/api/NstApiUser.hpp"
 #include "core/api/NstApiRewinder.hpp"
+#include "core/api/NstApiRunAhead.hpp"
 #include "core/api/NstApiMovie.hpp"
 
 using namespace Nes::Api;
@@ -81,6 +82,7 @@ bool nst_find_patch(char *patchname, unsigned int patchname_length, const char *
 void nst_set_callbacks();
 void nst_set_dirs();
 void nst_set_overclock();
+void nst_set_runahead();
 void nst_set_paths(const char *filename);
 void nst_set_region();
 void nst_set_rewind(int direction);
@@ -48,6 +48,10 @@ static Video::RenderState renderstate;
 static dimensions_t basesize, rendersize, screensize;
 static osdtext_t osdtext;
 
+// Rows of the video buffer not uploaded to the texture yet
+static int dirty_first, dirty_last;
+static int texture_w, texture_h;
+
 extern void *custompalette;
 
 extern nstpaths_t nstpaths;
@@ -140,6 +144,7 @@ void nst_ogl_init() {
 	glGenTextures(1, &gl_texture_id);
 	glActiveTexture(GL_TEXTURE0);
 	glBindTexture(GL_TEXTURE_2D, gl_texture_id);
+	texture_w = texture_h = 0;
 	
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, conf.video_linear_filter ? GL_LINEAR : GL_NEAREST);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
@@ -161,17 +166,51 @@ void nst_ogl_deinit() {
 	if (vbo) { glDeleteBuffers(1, &vbo); }
 }
 
+static void video_dirty_rows(int first, int last) {
+	// Mark rows of the video buffer for upload
+	if (dirty_first == dirty_last) { dirty_first = first; dirty_last = last; }
+	else {
+		if (first < dirty_first) { dirty_first = first; }
+		if (last > dirty_last) { dirty_last = last; }
+	}
+}
+
 void nst_ogl_render() {
 	// Render the scene
-	glTexImage2D(GL_TEXTURE_2D,
-				0,
-				GL_RGBA,
-				basesize.w,
-				overscan_height,
-				0,
-				GL_BGRA,
-				GL_UNSIGNED_BYTE,
-		videobuf + overscan_offset);
+	if (texture_w != basesize.w || texture_h != overscan_height) {
+		glTexImage2D(GL_TEXTURE_2D,
+					0,
+					GL_RGBA,
+					basesize.w,
+					overscan_height,
+					0,
+					GL_BGRA,
+					GL_UNSIGNED_BYTE,
+			videobuf + overscan_offset);
+		
+		texture_w = basesize.w;
+		texture_h = overscan_height;
+	}
+	else {
+		// Only upload the rows that changed since the last upload
+		int top = overscan_offset / basesize.w;
+		int first = dirty_first > top ? dirty_first : top;
+		int last = dirty_last < top + overscan_height ? dirty_last : top + overscan_height;
+		
+		if (first < last) {
+			glTexSubImage2D(GL_TEXTURE_2D,
+						0,
+						0,
+						first - top,
+						basesize.w,
+						last - first,
+						GL_BGRA,
+						GL_UNSIGNED_BYTE,
+				videobuf + first * basesize.w);
+		}
+	}
+	
+	dirty_first = dirty_last = 0;
 	
 	glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
 	glClear(GL_COLOR_BUFFER_BIT);
@@ -420,6 +459,9 @@ void video_set_filter() {
 		fprintf(stderr, "Nestopia core rejected render state\n");
 		exit(1);
 	}
+	
+	// Only filter and upload the rows that change from frame to frame
+	video.EnableDirtyRows(true);
 }
 
 dimensions_t nst_video_get_dimensions_render() {
@@ -512,6 +554,9 @@ void video_unlock_screen(void*) {
 	int xscale = renderstate.width / Video::Output::WIDTH;;
 	int yscale = renderstate.height / Video::Output::HEIGHT;
 	
+	unsigned first, last;
+	if (Video(emulator).GetDirtyRows(first, last)) { video_dirty_rows(first, last); }
+	
 	if (osdtext.drawtext) {
 		nst_video_text_draw(osdtext.textbuf, osdtext.xpos * xscale, osdtext.ypos * yscale, osdtext.bg);
 		osdtext.drawtext--;
@@ -565,6 +610,8 @@ void video_screenshot(const char* filename) {
 void video_clear_buffer() {
 	// Write black to the video buffer
 	memset(videobuf, 0x00000000, VIDBUF_MAXSIZE);
+	video_dirty_rows(0, basesize.h);
+	Video(emulator).InvalidateDirtyRows();
 }
 
 void video_disp_nsf() {
@@ -675,6 +722,10 @@ void nst_video_text_draw(const char *text, int xpos, int ypos, bool bg) {
 		}
 		letternum++;
 	}
+	
+	// The core has to redraw these rows once the text is gone
+	video_dirty_rows(ypos - 1, ypos + 9);
+	Video(emulator).InvalidateDirtyRows();
 }
 
 void nst_video_text_match(const char *text, int *xpos, int *ypos, int strpos) {
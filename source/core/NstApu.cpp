@@ -25,7 +25,7 @@
 #include <cstring>
 #include "NstCpu.hpp"
 #include "NstState.hpp"
-#include "api/NstApiSound.hpp"
+#include "api/NstApiCallbacks.hpp"
 #include "NstSoundRenderer.inl"
 
 namespace Nes
@@ -112,6 +112,22 @@ namespace Nes
 			0x10, 0x1C, 0x20, 0x1E
 		};
 
+		const byte Apu::Square::forms[4][8] =
+		{
+			{0x1F,0x00,0x1F,0x1F,0x1F,0x1F,0x1F,0x1F},
+			{0x1F,0x00,0x00,0x1F,0x1F,0x1F,0x1F,0x1F},
+			{0x1F,0x00,0x00,0x00,0x00,0x1F,0x1F,0x1F},
+			{0x00,0x1F,0x1F,0x00,0x00,0x00,0x00,0x00}
+		};
+
+		const byte Apu::Triangle::pyramid[32] =
+		{
+			0x0,0x1,0x2,0x3,0x4,0x5,0x6,0x7,
+			0x8,0x9,0xA,0xB,0xC,0xD,0xE,0xF,
+			0xF,0xE,0xD,0xC,0xB,0xA,0x9,0x8,
+			0x7,0x6,0x5,0x4,0x3,0x2,0x1,0x0
+		};
+
 		const word Apu::Noise::lut[3][16] =
 		{
 			{
@@ -297,7 +313,7 @@ namespace Nes
 			if (!rate)
 				return RESULT_ERR_INVALID_PARAM;
 
-			if (rate < 11025 || rate > 96000)
+			if (rate < 11025 || rate > 192000)
 				return RESULT_ERR_UNSUPPORTED;
 
 			settings.rate = rate;
@@ -411,15 +427,55 @@ namespace Nes
 			}
 		}
 
+		void Apu::EnableBandLimiting(const bool enable)
+		{
+			if (settings.bandLimited != enable)
+			{
+				settings.bandLimited = enable;
+				UpdateSettings();
+			}
+		}
+
+		void Apu::EnableRateControl(const bool enable)
+		{
+			if (settings.rateControl != enable)
+			{
+				settings.rateControl = enable;
+				synchronizer.Restart();
+				UpdateSettings();
+			}
+		}
+
+		inline bool Apu::IsSynthesizing() const
+		{
+			// expansion sound chips are sampled at the output
+			// rate and need the per-sample engine
+
+			return settings.bandLimited && !extChannel;
+		}
+
 		void Apu::UpdateSettings()
 		{
 			cycles.Update( settings.rate, settings.speed, cpu );
-			synchronizer.Reset( settings.speed, settings.rate, cpu );
+			synchronizer.Reset( settings.speed, cycles.rate, cpu );
 			dcBlocker.Reset();
 			buffer.Reset( settings.bits );
+			steps.Reset( cycles.rate, cycles.rateCounter );
 
 			Cycle rate; uint fixed;
-			CalculateOscillatorClock( rate, fixed );
+
+			if (IsSynthesizing())
+			{
+				// oscillators count in the same units as the
+				// APU clock, one CPU cycle being fixed * clock
+
+				rate = cycles.rate;
+				fixed = cycles.fixed * cpu.GetClock();
+			}
+			else
+			{
+				CalculateOscillatorClock( rate, fixed );
+			}
 
 			square[0].UpdateSettings ( settings.muted ? 0 : settings.volumes[ Channel::APU_SQUARE1  ], rate, fixed );
 			square[1].UpdateSettings ( settings.muted ? 0 : settings.volumes[ Channel::APU_SQUARE2  ], rate, fixed );
@@ -442,12 +498,6 @@ namespace Nes
 			);
 		}
 
-		void Apu::Resync(const dword rate)
-		{
-			cycles.Update( rate, settings.speed, cpu );
-			ClearBuffers( false );
-		}
-
 		void Apu::CalculateOscillatorClock(Cycle& rate,uint& fixed) const
 		{
 			dword sampleRate = settings.rate;
@@ -560,6 +610,7 @@ namespace Nes
 		{
 			cycles.frameIrqClock = Cpu::CYCLE_MAX;
 			cycles.frameIrqRepeat = 0;
+			cycles.extCounter = Cpu::CYCLE_MAX;
 
 			while (const dword chunk = state.Begin())
 			{
@@ -597,9 +648,9 @@ namespace Nes
 
 					case AsciiId<'E','X','T'>::V:
 
-						NST_VERIFY( cycles.extCounter != Cpu::CYCLE_MAX );
+						NST_VERIFY( extChannel );
 
-						if (cycles.extCounter != Cpu::CYCLE_MAX)
+						if (extChannel)
 						{
 							cycles.extCounter = cycles.fixed *
 							(
@@ -740,6 +791,19 @@ namespace Nes
 			}
 		}
 
+		void NST_FASTCALL Apu::SyncSteps(const Cycle target)
+		{
+			NST_ASSERT( (stream && settings.audible) && cycles.fixed && IsSynthesizing() );
+
+			while (cycles.frameCounter < target)
+			{
+				Synthesize( cycles.frameCounter );
+				ClockFrameCounter();
+			}
+
+			Synthesize( target );
+		}
+
 		void NST_FASTCALL Apu::SyncOff(const Cycle target)
 		{
 			NST_ASSERT( !(stream && settings.audible) && cycles.fixed );
@@ -760,8 +824,13 @@ namespace Nes
 
 		void Apu::BeginFrame(Sound::Output* output)
 		{
+			const Updater prev = updater;
+
 			stream = output;
-			updater = (output && settings.audible ? (cycles.extCounter == Cpu::CYCLE_MAX ? &Apu::SyncOn : &Apu::SyncOnExt) : &Apu::SyncOff);
+			updater = (output && settings.audible ? IsSynthesizing() ? &Apu::SyncSteps : (cycles.extCounter == Cpu::CYCLE_MAX ? &Apu::SyncOn : &Apu::SyncOnExt) : &Apu::SyncOff);
+
+			if (updater == &Apu::SyncSteps && prev != &Apu::SyncSteps)
+				steps.Reset( cycles.rate, cycles.rateCounter );
 		}
 
 		inline void Apu::Update(const Cycle target)
@@ -846,19 +915,88 @@ namespace Nes
 			}
 		}
 
+		template<typename T,bool STEREO>
+		void Apu::FlushSteps()
+		{
+			NST_ASSERT( (stream && settings.audible) && IsSynthesizing() );
+
+			SyncSteps( cpu.GetCycles() * cycles.fixed );
+
+			const Cycle limit = (cpu.GetCycles() + cpu.GetFrameCycles()) * cycles.fixed;
+
+			for (uint i=0; i < 2; ++i)
+			{
+				if (stream->length[i] && stream->samples[i])
+				{
+					Sound::Buffer::Renderer<T,STEREO> output( stream->samples[i], stream->length[i], buffer.history );
+
+					for (uint length=stream->length[i]; length; )
+					{
+						uint count = steps.Available( cycles.rateCounter );
+
+						if (!count)
+						{
+							// not enough emulated time for the requested length, synthesize
+							// ahead like FlushSound() does but never more than a frame
+
+							const Cycle required = steps.Required( NST_MIN(length,uint(Sound::Buffer::SIZE/4)) );
+
+							if (required <= limit)
+							{
+								SyncSteps( required );
+								continue;
+							}
+
+							do
+							{
+								output << Clamp<Channel::OUTPUT_MIN,Channel::OUTPUT_MAX>( dcBlocker.Apply( steps.Hold() ) );
+							}
+							while (--length);
+
+							break;
+						}
+
+						if (count > length)
+							count = length;
+
+						length -= count;
+
+						do
+						{
+							output << Clamp<Channel::OUTPUT_MIN,Channel::OUTPUT_MAX>( dcBlocker.Apply( steps.Read() ) );
+						}
+						while (--count);
+					}
+				}
+			}
+		}
+
 		void Apu::EndFrame()
 		{
 			NST_ASSERT( (stream && settings.audible) == (updater != &Apu::SyncOff) );
 
 			if (updater != &Apu::SyncOff)
 			{
-				dword streamed = 0;
-
-				if (Sound::Output::lockCallback( *stream ))
+				if (cpu.GetCallbacks().soundLock.Active()( *stream ))
 				{
-					streamed = stream->length[0] + stream->length[1];
-
-					if (settings.bits == 16)
+					if (updater == &Apu::SyncSteps)
+					{
+						if (settings.bits == 16)
+						{
+							if (!settings.stereo)
+								FlushSteps<iword,false>();
+							else
+								FlushSteps<iword,true>();
+						}
+						else
+						{
+							if (!settings.stereo)
+								FlushSteps<byte,false>();
+							else
+								FlushSteps<byte,true>();
+						}
+					}
+					else if (settings.bits == 16)
 					{
 						if (!settings.stereo)
 							FlushSound<iword,false>();
@@ -873,11 +1011,8 @@ namespace Nes
 							FlushSound<byte,true>();
 					}
 
-					Sound::Output::unlockCallback( *stream );
+					cpu.GetCallbacks().soundUnlock.Active()( *stream );
 				}
-
-				if (const dword rate = synchronizer.Clock( streamed, settings.rate, cpu ))
-					Resync( rate );
 			}
 
 			Update( cpu.GetCycles() );
@@ -904,6 +1039,9 @@ namespace Nes
 				cycles.extCounter >= frame
 			);
 
+			if (updater == &Apu::SyncSteps)
+				steps.EndFrame( frame, cycles.rateCounter );
+
 			cycles.rateCounter -= frame;
 			cycles.frameCounter -= frame;
 
@@ -911,12 +1049,41 @@ namespace Nes
 				cycles.extCounter -= frame;
 		}
 
+		uint Apu::UpdateRateControl(const dword queued,const dword target)
+		{
+			if (settings.rateControl)
+			{
+				if (const Cycle rate = synchronizer.Clock( queued, target ))
+				{
+					cycles.rate = rate;
+
+					if (updater == &Apu::SyncSteps)
+						steps.SetRate( rate, cycles.rateCounter );
+				}
+			}
+
+			// number of samples falling into the next frame, including
+			// the ones already rendered ahead and left in the buffers
+
+			const Cycle frame = cpu.GetFrameCycles() * cycles.fixed;
+
+			if (updater == &Apu::SyncSteps)
+				return steps.Available( NST_MAX(frame,cycles.rateCounter) );
+
+			uint length = buffer.Length();
+
+			if (cycles.rateCounter < frame)
+				length += (frame - cycles.rateCounter + cycles.rate - 1) / cycles.rate;
+
+			return length;
+		}
+
 		#ifdef NST_MSVC_OPTIMIZE
 		#pragma optimize("s", on)
 		#endif
 
 		Apu::Settings::Settings()
-		: rate(44100), bits(16), speed(0), muted(false), transpose(false), stereo(false), audible(true)
+		: rate(44100), bits(16), speed(0), muted(false), transpose(false), genie(false), stereo(false), bandLimited(false), rateControl(false), audible(true)
 		{
 			for (uint i=0; i < MAX_CHANNELS; ++i)
 				volumes[i] = Channel::DEFAULT_VOLUME;
@@ -963,74 +1130,68 @@ namespace Nes
 		}
 
 		Apu::Synchronizer::Synchronizer()
-		: rate(0) {}
+		: sync(false), rate(0), integral(0) {}
 
 		void Apu::Synchronizer::Resync(uint speed,const Cpu& cpu)
 		{
-			duty = 0;
-			streamed = 0;
+			// only meaningful at normal speed, anything else
+			// is meant to drift away from the output device
 
-			if (speed == 0 || speed == cpu.GetFps())
-				sync = 4;
-			else
-				sync = 0;
+			sync = (speed == 0 || speed == cpu.GetFps());
 		}
 
-		void Apu::Synchronizer::Reset(uint speed,dword sampleRate,const Cpu& cpu)
+		void Apu::Synchronizer::Reset(uint speed,Cycle sampleRate,const Cpu& cpu)
 		{
 			rate = sampleRate;
 			Resync( speed, cpu );
 		}
 
+		void Apu::Synchronizer::Restart()
+		{
+			integral = 0;
+		}
+
 		#ifdef NST_MSVC_OPTIMIZE
 		#pragma optimize("", on)
 		#endif
 
-		NST_SINGLE_CALL dword Apu::Synchronizer::Clock(const dword output,const dword sampleRate,const Cpu& cpu)
+		Cycle Apu::Synchronizer::Clock(const dword queued,const dword target)
 		{
-			/*if (sync)
-			{
-				if (duty >= 60*4)
-					streamed += output;
+			// PI controller on the fill level of the output queue. The proportional
+			// term reacts to jitter, the integral one settles on the constant clock
+			// mismatch between emulation and output device, typically 60.0988 vs 60 Hz.
 
-				if (duty < 60*12)
-				{
-					duty++;
-				}
-				else
-				{
-					duty = 60*4;
+			if (!sync || !rate || !target)
+				return 0;
 
-					dword actualRate = streamed / (60*8) * cpu.GetFps();
-					const dword limit = sampleRate / 21;
+			const double MAX_DEVIATION = 0.005;
+			const double KP = 0.005;
+			const double KI = 0.0001;
 
-					if (actualRate <= sampleRate-limit)
-					{
-						actualRate = sampleRate-limit;
-						sync--;
-					}
-					else if (actualRate >= sampleRate+limit)
-					{
-						actualRate = sampleRate+limit;
-						sync--;
-					}
-					else
-					{
-						sync = (sync > 2 ? sync - 2 : 0);
-					}
+			double error = (double(target) - double(queued)) / target;
 
-					actualRate = actualRate * 9999 / 10000;
-					streamed = 0;
+			if (error > 1)
+				error = 1;
+			else if (error < -1)
+				error = -1;
 
-					if (rate != actualRate)
-					{
-						rate = actualRate;
-						return actualRate;
-					}
-				}
-			}*/
+			integral += error * KI;
 
-			return 0;
+			if (integral > MAX_DEVIATION)
+				integral = MAX_DEVIATION;
+			else if (integral < -MAX_DEVIATION)
+				integral = -MAX_DEVIATION;
+
+			double deviation = error * KP + integral;
+
+			if (deviation > MAX_DEVIATION)
+				deviation = MAX_DEVIATION;
+			else if (deviation < -MAX_DEVIATION)
+				deviation = -MAX_DEVIATION;
+
+			// more samples per frame when the queue runs low
+
+			return Cycle(rate / (1 + deviation) + 0.5);
 		}
 
 		#ifdef NST_MSVC_OPTIMIZE
@@ -1233,7 +1394,11 @@ namespace Nes
 			if (apu.extChannel == this)
 			{
 				apu.extChannel = NULL;
-				apu.UpdateVolumes();
+
+				if (apu.settings.bandLimited)
+					apu.UpdateSettings();
+				else
+					apu.UpdateVolumes();
 			}
 		}
 
@@ -1247,6 +1412,9 @@ namespace Nes
 				apu.UpdateVolumes();
 
 			apu.extChannel = this;
+
+			if (apu.settings.bandLimited)
+				apu.UpdateSettings();
 		}
 
 		void Apu::Channel::GetOscillatorClock(Cycle& rate,uint& fixed) const
@@ -1279,6 +1447,11 @@ namespace Nes
 			return apu.cpu.GetClock(clock);
 		}
 
+		const Api::Callbacks& Apu::Channel::GetCallbacks() const
+		{
+			return apu.cpu.GetCallbacks();
+		}
+
 		dword Apu::Channel::GetSampleRate() const
 		{
 			return apu.settings.rate;
@@ -1319,6 +1492,11 @@ namespace Nes
 			amp = 0;
 		}
 
+		inline idword Apu::Oscillator::Pending() const
+		{
+			return active ? timer : idword(IDLE_CYCLES);
+		}
+
 		void Apu::Oscillator::UpdateSettings(dword r,uint f)
 		{
 			NST_ASSERT( r && f );
@@ -1605,14 +1783,6 @@ namespace Nes
 
 			if (active)
 			{
-				static const byte forms[4][8] =
-				{
-					{0x1F,0x00,0x1F,0x1F,0x1F,0x1F,0x1F,0x1F},
-					{0x1F,0x00,0x00,0x1F,0x1F,0x1F,0x1F,0x1F},
-					{0x1F,0x00,0x00,0x00,0x00,0x1F,0x1F,0x1F},
-					{0x00,0x1F,0x1F,0x00,0x00,0x00,0x00,0x00}
-				};
-
 				const byte* const NST_RESTRICT form = forms[duty];
 
 				if (timer >= 0)
@@ -1656,6 +1826,34 @@ namespace Nes
 			return amp;
 		}
 
+		inline dword Apu::Square::GetLevel() const
+		{
+			return active ? envelope.Volume() >> forms[duty][step] : 0;
+		}
+
+		inline bool Apu::Square::Advance(const idword elapsed)
+		{
+			timer -= elapsed;
+
+			if (timer > 0)
+				return false;
+
+			if (active)
+			{
+				const uint prev = forms[duty][step];
+				step = (step + 1) & 0x7;
+				timer += idword(frequency);
+				return forms[duty][step] != prev;
+			}
+			else
+			{
+				const uint count = dword(-timer) / frequency + 1;
+				step = (step + count) & 0x7;
+				timer += idword(count * frequency);
+				return false;
+			}
+		}
+
 		#ifdef NST_MSVC_OPTIMIZE
 		#pragma optimize("s", on)
 		#endif
@@ -1840,14 +2038,6 @@ namespace Nes
 
 			if (active)
 			{
-				static const byte pyramid[32] =
-				{
-					0x0,0x1,0x2,0x3,0x4,0x5,0x6,0x7,
-					0x8,0x9,0xA,0xB,0xC,0xD,0xE,0xF,
-					0xF,0xE,0xD,0xC,0xB,0xA,0x9,0x8,
-					0x7,0x6,0x5,0x4,0x3,0x2,0x1,0x0
-				};
-
 				dword sum = timer;
 				timer -= idword(rate);
 
@@ -1883,6 +2073,30 @@ namespace Nes
 			return amp;
 		}
 
+		NST_SINGLE_CALL dword Apu::Triangle::GetLevel() const
+		{
+			// a halted triangle holds its last step
+
+			return pyramid[step] * outputVolume * 3;
+		}
+
+		NST_SINGLE_CALL bool Apu::Triangle::Advance(const idword elapsed)
+		{
+			if (active)
+			{
+				timer -= elapsed;
+
+				if (timer <= 0)
+				{
+					step = (step + 1) & 0x1F;
+					timer += idword(frequency);
+					return step & 0xF;
+				}
+			}
+
+			return false;
+		}
+
 		inline uint Apu::Triangle::GetLengthCounter() const
 		{
 			return lengthCounter.GetCount();
@@ -2089,6 +2303,36 @@ namespace Nes
 			return 0;
 		}
 
+		NST_SINGLE_CALL dword Apu::Noise::GetLevel() const
+		{
+			return active && !(bits & 0x4000) ? envelope.Volume() * 2 : 0;
+		}
+
+		NST_SINGLE_CALL bool Apu::Noise::Advance(const idword elapsed)
+		{
+			timer -= elapsed;
+
+			if (timer > 0)
+				return false;
+
+			if (active)
+			{
+				const uint prev = bits;
+				bits = (bits << 1) | ((bits >> 14 ^ bits >> shifter) & 0x1);
+				timer += idword(frequency);
+				return (bits ^ prev) & 0x4000;
+			}
+
+			do
+			{
+				bits = (bits << 1) | ((bits >> 14 ^ bits >> shifter) & 0x1);
+				timer += idword(frequency);
+			}
+			while (timer <= 0);
+
+			return false;
+		}
+
 		inline uint Apu::Noise::GetLengthCounter() const
 		{
 			return lengthCounter.GetCount();
@@ -2302,6 +2546,11 @@ namespace Nes
 			return linSample;
 		}
 
+		NST_SINGLE_CALL dword Apu::Dmc::GetLevel() const
+		{
+			return curSample;
+		}
+
 		void Apu::Dmc::DoDMA(Cpu& cpu,const Cycle clock,const uint readAddress)
 		{
 			NST_VERIFY( !dma.buffered && (!readAddress || !cpu.IsWriteCycle(clock)) );
@@ -2464,6 +2713,7 @@ namespace Nes
 			dcBlocker.Reset();
 
 			buffer.Reset( settings.bits, false );
+			steps.Reset( cycles.rate, cycles.rateCounter );
 		}
 
 		#ifdef NST_MSVC_OPTIMIZE
@@ -2552,6 +2802,18 @@ namespace Nes
 			cycles.frameIrqRepeat = repeat;
 		}
 
+		inline idword Apu::GetSquareLevel() const
+		{
+			const dword dac = square[0].GetLevel() + square[1].GetLevel();
+			return dac ? NLN_SQ_0 / (NLN_SQ_1 / dac + NLN_SQ_2) : 0;
+		}
+
+		inline idword Apu::GetTndLevel() const
+		{
+			const dword dac = triangle.GetLevel() + noise.GetLevel() + dmc.GetLevel();
+			return dac ? NLN_TND_0 / (NLN_TND_1 / dac + NLN_TND_2) : 0;
+		}
+
 		NST_NO_INLINE Apu::Channel::Sample Apu::GetSample()
 		{
 			dword dac[2];
@@ -2566,6 +2828,54 @@ namespace Nes
 			);
 		}
 
+		NST_NO_INLINE void Apu::Synthesize(const Cycle target)
+		{
+			NST_ASSERT( IsSynthesizing() );
+
+			if (cycles.rateCounter < target)
+			{
+				Cycle clock = cycles.rateCounter;
+				cycles.rateCounter = target;
+
+				idword level[2] = { GetSquareLevel(), GetTndLevel() };
+				steps.Update( clock, level[0] + level[1] );
+
+				for (idword left = target - clock;;)
+				{
+					idword elapsed = left;
+
+					elapsed = NST_MIN( elapsed, square[0].Pending() );
+					elapsed = NST_MIN( elapsed, square[1].Pending() );
+					elapsed = NST_MIN( elapsed, triangle.Pending()  );
+					elapsed = NST_MIN( elapsed, noise.Pending()     );
+
+					const uint changed[2] =
+					{
+						uint(square[0].Advance( elapsed )) | uint(square[1].Advance( elapsed )),
+						uint(triangle.Advance( elapsed )) | uint(noise.Advance( elapsed ))
+					};
+
+					left -= elapsed;
+
+					if (!left)
+						break;
+
+					clock += elapsed;
+
+					if (changed[0] | changed[1])
+					{
+						if (changed[0])
+							level[0] = GetSquareLevel();
+
+						if (changed[1])
+							level[1] = GetTndLevel();
+
+						steps.Update( clock, level[0] + level[1] );
+					}
+				}
+			}
+		}
+
 		NES_POKE_AD(Apu,4000)
 		{
 			UpdateLatency();
@@ -30,6 +30,11 @@
 
 namespace Nes
 {
+	namespace Api
+	{
+		class Callbacks;
+	}
+
 	namespace Core
 	{
 		namespace Sound
@@ -69,6 +74,9 @@ namespace Nes
 			void   SetAutoTranspose(bool);
 			void   SetGenie(bool);
 			void   EnableStereo(bool);
+			void   EnableBandLimiting(bool);
+			void   EnableRateControl(bool);
+			uint   UpdateRateControl(dword,dword);
 
 			void SaveState(State::Saver&,dword) const;
 			void LoadState(State::Loader&);
@@ -90,6 +98,7 @@ namespace Nes
 				Cycle GetCpuClockBase() const;
 				uint  GetCpuClockDivider() const;
 				Cycle GetCpuClock(uint=1) const;
+				const Api::Callbacks& GetCallbacks() const;
 				bool  IsMuted() const;
 				bool  IsGenie() const;
 
@@ -254,7 +263,7 @@ namespace Nes
 
 			void Reset(bool,bool);
 			void CalculateOscillatorClock(Cycle&,uint&) const;
-			void Resync(dword);
+			inline bool IsSynthesizing() const;
 			NST_NO_INLINE void ClearBuffers(bool);
 
 			enum
@@ -298,11 +307,16 @@ namespace Nes
 			NES_DECL_PEEK( 40xx );
 
 			NST_NO_INLINE Channel::Sample GetSample();
+			inline idword GetSquareLevel() const;
+			inline idword GetTndLevel() const;
 
 			void NST_FASTCALL SyncOn    (Cycle);
 			void NST_FASTCALL SyncOnExt (Cycle);
+			void NST_FASTCALL SyncSteps (Cycle);
 			void NST_FASTCALL SyncOff   (Cycle);
 
+			NST_NO_INLINE void Synthesize(Cycle);
+
 			NST_NO_INLINE void ClockFrameIRQ(Cycle);
 			NST_NO_INLINE void ClockFrameCounter();
 			NST_NO_INLINE void ClockDmc(Cycle,uint=0);
@@ -311,6 +325,9 @@ namespace Nes
 			template<typename T,bool STEREO>
 			void FlushSound();
 
+			template<typename T,bool STEREO>
+			void FlushSteps();
+
 			void UpdateSettings();
 			void UpdateVolumes();
 
@@ -337,25 +354,26 @@ namespace Nes
 
 			class Synchronizer
 			{
-				uint sync;
-				uint duty;
-				dword streamed;
-				dword rate;
+				ibool sync;
+				Cycle rate;
+				double integral;
 
 			public:
 
 				Synchronizer();
 
-				void Reset(uint,dword,const Cpu&);
+				void Reset(uint,Cycle,const Cpu&);
 				void Resync(uint,const Cpu&);
-				NST_SINGLE_CALL dword Clock(dword,dword,const Cpu&);
+				void Restart();
+				Cycle Clock(dword,dword);
 			};
 
 			class Oscillator
 			{
 				enum
 				{
-					RESET_CYCLES = 2048
+					RESET_CYCLES = 2048,
+					IDLE_CYCLES = 0x7FFFFFFF
 				};
 
 			protected:
@@ -375,6 +393,7 @@ namespace Nes
 			public:
 
 				inline void ClearAmp();
+				inline idword Pending() const;
 			};
 
 			class Square : public Oscillator
@@ -394,6 +413,9 @@ namespace Nes
 
 				dword GetSample();
 
+				inline dword GetLevel() const;
+				inline bool Advance(idword);
+
 				NST_SINGLE_CALL void ClockEnvelope();
 				NST_SINGLE_CALL void ClockSweep(uint);
 
@@ -429,6 +451,8 @@ namespace Nes
 				uint sweepIncrease;
 				word sweepShift;
 				word waveLength;
+
+				static const byte forms[4][8];
 			};
 
 			class Triangle : public Oscillator
@@ -449,6 +473,9 @@ namespace Nes
 
 				NST_SINGLE_CALL dword GetSample();
 
+				NST_SINGLE_CALL dword GetLevel() const;
+				NST_SINGLE_CALL bool Advance(idword);
+
 				NST_SINGLE_CALL void ClockLinearCounter();
 				NST_SINGLE_CALL void ClockLengthCounter();
 
@@ -481,6 +508,8 @@ namespace Nes
 				byte linearCtrl;
 				byte linearCounter;
 				Channel::LengthCounter lengthCounter;
+
+				static const byte pyramid[32];
 			};
 
 			class Noise : public Oscillator
@@ -499,6 +528,9 @@ namespace Nes
 
 				NST_SINGLE_CALL dword GetSample();
 
+				NST_SINGLE_CALL dword GetLevel() const;
+				NST_SINGLE_CALL bool Advance(idword);
+
 				NST_SINGLE_CALL void ClockEnvelope();
 				NST_SINGLE_CALL void ClockLengthCounter();
 
@@ -543,6 +575,7 @@ namespace Nes
 				NST_SINGLE_CALL void Disable(bool,Cpu&);
 
 				NST_SINGLE_CALL dword GetSample();
+				NST_SINGLE_CALL dword GetLevel() const;
 
 				NST_SINGLE_CALL bool ClockDAC();
 				NST_SINGLE_CALL void Update();
@@ -607,6 +640,8 @@ namespace Nes
 				bool transpose;
 				bool genie;
 				bool stereo;
+				bool bandLimited;
+				bool rateControl;
 				bool audible;
 				byte volumes[MAX_CHANNELS];
 			};
@@ -624,6 +659,7 @@ namespace Nes
 			Channel::DcBlocker dcBlocker;
 			Sound::Output* stream;
 			Sound::Buffer buffer;
+			Sound::StepBuffer steps;
 			Settings settings;
 
 		public:
@@ -668,6 +704,16 @@ namespace Nes
 				return settings.stereo;
 			}
 
+			bool IsBandLimiting() const
+			{
+				return settings.bandLimited;
+			}
+
+			bool IsRateControlled() const
+			{
+				return settings.rateControl;
+			}
+
 			bool IsMuted() const
 			{
 				return settings.muted;
@@ -47,7 +47,7 @@ namespace Nes
 		: nmt(NMT_DEFAULT), battery(false), wramAuto(false) {}
 
 		Cartridge::Cartridge(Context& context)
-		: Image(CARTRIDGE), board(NULL), vs(NULL), favoredSystem(context.favoredSystem)
+		: Image(CARTRIDGE), board(NULL), vs(NULL), savefile(context.cpu.GetCallbacks()), favoredSystem(context.favoredSystem)
 		{
 			try
 			{
@@ -101,7 +101,9 @@ namespace Nes
 							chr,
 							context.favoredSystem,
 							context.askProfile,
-							profile
+							profile,
+							false,
+							&context.cpu.GetCallbacks()
 						);
 						break;
 				}
@@ -376,6 +378,23 @@ namespace Nes
 			}
 		}
 
+		void Cartridge::Flush()
+		{
+			savefile.Flush( true );
+
+			try
+			{
+				board->Save( savefile );
+			}
+			catch (...)
+			{
+				savefile.Flush( false );
+				throw;
+			}
+
+			savefile.Flush( false );
+		}
+
 		void Cartridge::SaveState(State::Saver& state,const dword baseChunk) const
 		{
 			state.Begin( baseChunk );
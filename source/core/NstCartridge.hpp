@@ -125,6 +125,8 @@ namespace Nes
 
 		public:
 
+			void Flush();
+
 			const Profile& GetProfile() const
 			{
 				return profile;
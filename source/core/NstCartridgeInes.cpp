@@ -518,22 +518,34 @@ namespace Nes
 						stream.Seek( TRAINER_LENGTH );
 
 					const dword romLength = profile.board.GetPrg() + profile.board.GetChr();
+					const dword available = NST_MIN(stream.Length(),MAX_DB_SEARCH_LENGTH);
 					dword count = 0;
 
+					byte block[MIN_DB_SEARCH_STRIDE];
+
 					for (Checksum it, checksum;;)
 					{
-						const uint data = stream.SafeRead8();
+						// read up to the next stride or the end of the ROM data, whichever comes first
+
+						dword next = (count / MIN_DB_SEARCH_STRIDE + 1) * MIN_DB_SEARCH_STRIDE;
+
+						if (count < romLength && romLength < next)
+							next = romLength;
+
+						if (next > available)
+							next = available;
 
-						if (data <= 0xFF)
+						if (next > count)
 						{
-							const byte in = data;
-							it.Compute( &in, 1 );
+							stream.Read( block, next - count );
+							it.Compute( block, next - count );
+							count = next;
 
-							if (++count % MIN_DB_SEARCH_STRIDE == 0)
+							if (count % MIN_DB_SEARCH_STRIDE == 0)
 								checksum = it;
 						}
 
-						const bool stop = (data > 0xFF || count == MAX_DB_SEARCH_LENGTH);
+						const bool stop = (count == available);
 
 						if (stop || count == romLength)
 						{
@@ -33,7 +33,7 @@
 #include "NstCartridge.hpp"
 #include "NstCartridgeRomset.hpp"
 #include "api/NstApiCartridge.hpp"
-#include "api/NstApiUser.hpp"
+#include "api/NstApiCallbacks.hpp"
 
 namespace Nes
 {
@@ -71,6 +71,7 @@ namespace Nes
 			const bool askProfile;
 			const bool readOnly;
 			const bool patchBypassChecksum;
+			const Api::Callbacks& callbacks;
 
 		public:
 
@@ -85,7 +86,8 @@ namespace Nes
 				const FavoredSystem f,
 				const bool a,
 				Profile& r,
-				const bool o
+				const bool o,
+				const Api::Callbacks* const k
 			)
 			:
 			imageStream         (i),
@@ -97,7 +99,8 @@ namespace Nes
 			patchResult         (e),
 			askProfile          (a),
 			readOnly            (o),
-			patchBypassChecksum (b)
+			patchBypassChecksum (b),
+			callbacks           (k ? *k : Api::Callbacks::defaults)
 			{
 				NST_ASSERT( prg.Empty() && chr.Empty() );
 			}
@@ -711,7 +714,7 @@ namespace Nes
 						}
 					}
 
-					if (askProfile && Api::Cartridge::chooseProfileCallback)
+					if (askProfile && callbacks.cartridgeChooseProfile.Active())
 					{
 						std::vector<std::wstring> names( profiles.size() );
 
@@ -751,7 +754,7 @@ namespace Nes
 							);
 						}
 
-						const uint selected = Api::Cartridge::chooseProfileCallback( &profiles.front(), &names.front(), profiles.size() );
+						const uint selected = callbacks.cartridgeChooseProfile.Active()( &profiles.front(), &names.front(), profiles.size() );
 
 						if (selected < profiles.size())
 							bestMatch = profiles.begin() + selected;
@@ -900,7 +903,7 @@ namespace Nes
 					if (readOnly)
 						continue;
 
-					if (!Api::User::fileIoCallback)
+					if (!callbacks.userFileIo.Active())
 						throw RESULT_ERR_NOT_READY;
 
 					size = 0;
@@ -914,7 +917,7 @@ namespace Nes
 							throw RESULT_ERR_INVALID_FILE;
 
 						Loader loader( it->file.c_str(), rom.Mem(size), it->size );
-						Api::User::fileIoCallback( loader );
+						callbacks.userFileIo.Active()( loader );
 
 						if (!loader.Loaded())
 							throw RESULT_ERR_INVALID_FILE;
@@ -972,7 +975,8 @@ namespace Nes
 			const FavoredSystem favoredSystem,
 			const bool askProfile,
 			Profile& profile,
-			const bool readOnly
+			const bool readOnly,
+			const Api::Callbacks* const callbacks
 		)
 		{
 			Loader loader
@@ -986,7 +990,8 @@ namespace Nes
 				favoredSystem,
 				askProfile,
 				profile,
-				readOnly
+				readOnly,
+				callbacks
 			);
 
 			loader.Load();
@@ -31,6 +31,11 @@
 
 namespace Nes
 {
+	namespace Api
+	{
+		class Callbacks;
+	}
+
 	namespace Core
 	{
 		class Cartridge::Romset
@@ -50,7 +55,8 @@ namespace Nes
 				FavoredSystem,
 				bool,
 				Profile&,
-				bool=false
+				bool=false,
+				const Api::Callbacks* =NULL
 			);
 		};
 	}
@@ -51,8 +51,16 @@ namespace Nes
 
 		void Checksum::Compute(const byte* data,dword size)
 		{
-			crc32 = Crc32::Compute( data, size, crc32 );
-			Sha1::Compute( sha1, data, size );
+			// Both hashes take the same chunk while it's still in cache
+			// so large images only get pulled in from memory once.
+
+			for (dword chunk; size; data += chunk, size -= chunk)
+			{
+				chunk = NST_MIN(size,CHUNK_SIZE);
+
+				crc32 = Crc32::Compute( data, chunk, crc32 );
+				Sha1::Compute( sha1, data, chunk );
+			}
 		}
 
 		void Checksum::Recompute(const byte* data,dword size)
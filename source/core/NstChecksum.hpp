@@ -52,6 +52,11 @@ namespace Nes
 
 		private:
 
+			enum
+			{
+				CHUNK_SIZE = SIZE_8K
+			};
+
 			Sha1::Key sha1;
 			dword crc32;
 
@@ -79,7 +79,7 @@
 	#define NST_UNREACHABLE() __assume(0)
 	#endif
 
-	#if !defined(NST_MM_INTRINSICS) && defined(NST_WIN32) && defined(_M_IX86)
+	#if !defined(NST_MM_INTRINSICS) && defined(NST_WIN32) && (defined(_M_IX86) || defined(_M_X64))
 	#define NST_MM_INTRINSICS
 	#endif
 
@@ -129,6 +129,14 @@
    #define NST_REGCALL __attribute__((regparm(2)))
    #endif
 
+   #if !defined(NST_MM_INTRINSICS) && defined(__SSE2__)
+   #define NST_MM_INTRINSICS
+   #endif
+
+   #if !defined(NST_COMPUTED_GOTO) && !defined(NST_NO_COMPUTED_GOTO)
+   #define NST_COMPUTED_GOTO
+   #endif
+
   #endif
 
  #endif
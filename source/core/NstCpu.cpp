@@ -27,14 +27,12 @@
 #include "NstCpu.hpp"
 #include "NstHook.hpp"
 #include "NstState.hpp"
-#include "api/NstApiUser.hpp"
+#include "api/NstApiCallbacks.hpp"
 
 namespace Nes
 {
 	namespace Core
 	{
-		dword Cpu::logged = 0;
-
 		void (Cpu::*const Cpu::opcodes[0x100])() =
 		{
 			&Cpu::op0x00, &Cpu::op0x01, &Cpu::op0x02, &Cpu::op0x03,
@@ -148,12 +146,15 @@ namespace Nes
 		#pragma warning( disable : 4355 )
 		#endif
 
-		Cpu::Cpu()
+		Cpu::Cpu(Api::Callbacks& c)
 		:
-		model ( CPU_RP2A03 ),
-		apu   ( *this ),
-		map   ( this, &Cpu::Peek_Overflow, &Cpu::Poke_Overflow )
+		model     ( CPU_RP2A03 ),
+		apu       ( *this ),
+		map       ( this, &Cpu::Peek_Overflow, &Cpu::Poke_Overflow ),
+		callbacks ( c )
 		{
+			ram.powerstate = 0;
+
 			cycles.UpdateTable( GetModel() );
 			Reset( false, false );
 		}
@@ -227,6 +228,11 @@ namespace Nes
 				map( 0xFFFC         ).Set( this, &Cpu::Peek_Jam_1,      &Cpu::Poke_Nop        );
 				map( 0xFFFD         ).Set( this, &Cpu::Peek_Jam_2,      &Cpu::Poke_Nop        );
 
+				map( 0x0000, 0x07FF ).SetMemory( ram.mem, RAM_SIZE-1, true );
+				map( 0x0800, 0x0FFF ).SetMemory( ram.mem, RAM_SIZE-1, true );
+				map( 0x1000, 0x17FF ).SetMemory( ram.mem, RAM_SIZE-1, true );
+				map( 0x1800, 0x1FFF ).SetMemory( ram.mem, RAM_SIZE-1, true );
+
 				apu.Reset( hard );
 			}
 			else
@@ -242,6 +248,8 @@ namespace Nes
 		{
 			NST_VERIFY( pc == RESET_VECTOR );
 
+			map.Compact();
+
 			pc = map.Peek16( RESET_VECTOR );
 
 			if (hard)
@@ -497,7 +505,7 @@ namespace Nes
 			if (!(logged & which))
 			{
 				logged |= which;
-				Api::User::eventCallback( Api::User::EVENT_CPU_UNOFFICIAL_OPCODE, code );
+				callbacks.userEvent.Active()( Api::User::EVENT_CPU_UNOFFICIAL_OPCODE, code );
 			}
 		}
 
@@ -745,7 +753,11 @@ namespace Nes
 
 		template<typename T,typename U>
 		Cpu::IoMap::IoMap(Cpu* cpu,T peek,U poke)
-		: Io::Map<SIZE_64K>( cpu, peek, poke ) {}
+		: Io::Map<SIZE_64K>( cpu, peek, poke )
+		#ifdef NST_TRACE
+		, tracer( NULL )
+		#endif
+		{}
 
 		#ifdef NST_MSVC_OPTIMIZE
 		#pragma optimize("", on)
@@ -754,19 +766,35 @@ namespace Nes
 		inline uint Cpu::IoMap::Peek8(const uint address) const
 		{
 			NST_ASSERT( address < FULL_SIZE );
-			return ports[address].Peek( address );
+
+		#ifdef NST_TRACE
+			if (tracer)
+			{
+				const uint data = Peek( address );
+				tracer->Access( Tracer::Entry::READ, address, data );
+				return data;
+			}
+		#endif
+
+			return Peek( address );
 		}
 
 		inline uint Cpu::IoMap::Peek16(const uint address) const
 		{
 			NST_ASSERT( address < FULL_SIZE-1 );
-			return ports[address].Peek( address ) | ports[address + 1].Peek( address + 1 ) << 8;
+			return Peek( address ) | Peek( address + 1 ) << 8;
 		}
 
 		inline void Cpu::IoMap::Poke8(const uint address,const uint data) const
 		{
 			NST_ASSERT( address < FULL_SIZE );
-			ports[address].Poke( address, data );
+
+		#ifdef NST_TRACE
+			if (tracer)
+				tracer->Access( Tracer::Entry::WRITE, address, data );
+		#endif
+
+			Poke( address, data );
 		}
 
 		#ifdef NST_MSVC_OPTIMIZE
@@ -1798,7 +1826,12 @@ namespace Nes
 				jammed = true;
 				interrupt.Reset();
 				NST_DEBUG_MSG("6502 JAM");
-				Api::User::eventCallback( Api::User::EVENT_CPU_JAM );
+				callbacks.userEvent.Active()( Api::User::EVENT_CPU_JAM );
+
+			#ifdef NST_TRACE
+				if (tracer.IsEnabled())
+					callbacks.tracerBreak.Active()( Api::Tracer::BREAK_JAM, pc );
+			#endif
 			}
 		}
 
@@ -1876,6 +1909,14 @@ namespace Nes
 
 			Clock();
 
+		#ifdef NST_TRACE
+			if (tracer.IsEnabled())
+			{
+				RunTrace();
+				return;
+			}
+		#endif
+
 			switch (hooks.Size())
 			{
 				case 0:  Run0(); break;
@@ -1891,6 +1932,10 @@ namespace Nes
 			for (const Hook *hook = hooks.Ptr(), *const end = hook+hooks.Size(); hook != end; ++hook)
 				hook->Execute();
 
+		#ifdef NST_TRACE
+			tracer.EndFrame();
+		#endif
+
 			NST_ASSERT( cycles.count >= cycles.frame && interrupt.nmiClock >= cycles.frame );
 
 			cycles.count -= cycles.frame;
@@ -1958,15 +2003,115 @@ namespace Nes
 			(*this.*opcodes[opcode=FetchPc8()])();
 		}
 
+		#ifdef NST_COMPUTED_GOTO
+
+		// Threaded dispatch. Every opcode gets its own copy of the fetch and jump
+		// to the next one, so the branch predictor sees 256 jump sites instead of
+		// one, and the opcode bodies are inlined into the loop. Same order of events
+		// as ExecuteOp() followed by the hooks.
+
+		#define NES_RUN_OP(hex_,hooks_)                 \
+                                                        \
+		op_##hex_:                                      \
+                                                        \
+			op##hex_();                                 \
+			hooks_                                      \
+                                                        \
+			if (cycles.count >= cycles.round)           \
+				goto round;                             \
+                                                        \
+			cycles.offset = cycles.count;               \
+			goto *ops[opcode=FetchPc8()];
+
+		#define NES_RUN_OP16(hex_,hooks_)               \
+                                                        \
+			NES_RUN_OP( hex_##0, hooks_ )               \
+			NES_RUN_OP( hex_##1, hooks_ )               \
+			NES_RUN_OP( hex_##2, hooks_ )               \
+			NES_RUN_OP( hex_##3, hooks_ )               \
+			NES_RUN_OP( hex_##4, hooks_ )               \
+			NES_RUN_OP( hex_##5, hooks_ )               \
+			NES_RUN_OP( hex_##6, hooks_ )               \
+			NES_RUN_OP( hex_##7, hooks_ )               \
+			NES_RUN_OP( hex_##8, hooks_ )               \
+			NES_RUN_OP( hex_##9, hooks_ )               \
+			NES_RUN_OP( hex_##A, hooks_ )               \
+			NES_RUN_OP( hex_##B, hooks_ )               \
+			NES_RUN_OP( hex_##C, hooks_ )               \
+			NES_RUN_OP( hex_##D, hooks_ )               \
+			NES_RUN_OP( hex_##E, hooks_ )               \
+			NES_RUN_OP( hex_##F, hooks_ )
+
+		#define NES_RUN_LABEL16(hex_)                   \
+                                                        \
+			&&op_##hex_##0, &&op_##hex_##1, &&op_##hex_##2, &&op_##hex_##3, \
+			&&op_##hex_##4, &&op_##hex_##5, &&op_##hex_##6, &&op_##hex_##7, \
+			&&op_##hex_##8, &&op_##hex_##9, &&op_##hex_##A, &&op_##hex_##B, \
+			&&op_##hex_##C, &&op_##hex_##D, &&op_##hex_##E, &&op_##hex_##F
+
+		#define NES_RUN_ROUND(hooks_)                   \
+		{                                               \
+			static const void* const ops[0x100] =       \
+			{                                           \
+				NES_RUN_LABEL16( 0x0 ),                 \
+				NES_RUN_LABEL16( 0x1 ),                 \
+				NES_RUN_LABEL16( 0x2 ),                 \
+				NES_RUN_LABEL16( 0x3 ),                 \
+				NES_RUN_LABEL16( 0x4 ),                 \
+				NES_RUN_LABEL16( 0x5 ),                 \
+				NES_RUN_LABEL16( 0x6 ),                 \
+				NES_RUN_LABEL16( 0x7 ),                 \
+				NES_RUN_LABEL16( 0x8 ),                 \
+				NES_RUN_LABEL16( 0x9 ),                 \
+				NES_RUN_LABEL16( 0xA ),                 \
+				NES_RUN_LABEL16( 0xB ),                 \
+				NES_RUN_LABEL16( 0xC ),                 \
+				NES_RUN_LABEL16( 0xD ),                 \
+				NES_RUN_LABEL16( 0xE ),                 \
+				NES_RUN_LABEL16( 0xF )                  \
+			};                                          \
+                                                        \
+			cycles.offset = cycles.count;               \
+			goto *ops[opcode=FetchPc8()];               \
+                                                        \
+			NES_RUN_OP16( 0x0, hooks_ )                 \
+			NES_RUN_OP16( 0x1, hooks_ )                 \
+			NES_RUN_OP16( 0x2, hooks_ )                 \
+			NES_RUN_OP16( 0x3, hooks_ )                 \
+			NES_RUN_OP16( 0x4, hooks_ )                 \
+			NES_RUN_OP16( 0x5, hooks_ )                 \
+			NES_RUN_OP16( 0x6, hooks_ )                 \
+			NES_RUN_OP16( 0x7, hooks_ )                 \
+			NES_RUN_OP16( 0x8, hooks_ )                 \
+			NES_RUN_OP16( 0x9, hooks_ )                 \
+			NES_RUN_OP16( 0xA, hooks_ )                 \
+			NES_RUN_OP16( 0xB, hooks_ )                 \
+			NES_RUN_OP16( 0xC, hooks_ )                 \
+			NES_RUN_OP16( 0xD, hooks_ )                 \
+			NES_RUN_OP16( 0xE, hooks_ )                 \
+			NES_RUN_OP16( 0xF, hooks_ )                 \
+                                                        \
+		round:;                                         \
+		}
+
+		#else
+
+		#define NES_RUN_ROUND(hooks_)                   \
+                                                        \
+		do                                              \
+		{                                               \
+			ExecuteOp();                                \
+			hooks_                                      \
+		}                                               \
+		while (cycles.count < cycles.round);
+
+		#endif
+
 		void Cpu::Run0()
 		{
 			do
 			{
-				do
-				{
-					ExecuteOp();
-				}
-				while (cycles.count < cycles.round);
+				NES_RUN_ROUND( NST_NOP(); )
 
 				Clock();
 			}
@@ -1979,12 +2124,7 @@ namespace Nes
 
 			do
 			{
-				do
-				{
-					ExecuteOp();
-					hook.Execute();
-				}
-				while (cycles.count < cycles.round);
+				NES_RUN_ROUND( hook.Execute(); )
 
 				Clock();
 			}
@@ -1998,27 +2138,98 @@ namespace Nes
 
 			do
 			{
-				do
-				{
-					ExecuteOp();
+				NES_RUN_ROUND
+				(
+					{
+						const Hook* NST_RESTRICT hook = first;
 
-					const Hook* NST_RESTRICT hook = first;
+						hook->Execute();
 
-					hook->Execute();
+						do
+						{
+							(++hook)->Execute();
+						}
+						while (hook != last);
+					}
+				)
 
-					do
+				Clock();
+			}
+			while (cycles.count < cycles.frame);
+		}
+
+		#undef NES_RUN_ROUND
+
+		#ifdef NST_COMPUTED_GOTO
+		#undef NES_RUN_OP
+		#undef NES_RUN_OP16
+		#undef NES_RUN_LABEL16
+		#endif
+
+		#ifdef NST_TRACE
+
+		void Cpu::RunTrace()
+		{
+			// same as Run2() with the instruction recorded between fetch
+			// and execution, bus accesses are picked up by the map
+
+			map.tracer = &tracer;
+
+			do
+			{
+				do
+				{
+					const uint address = pc;
+
+					// a break callback may turn tracing off, which frees
+					// the buffer, the rest of the frame then runs untraced
+
+					Tracer::Entry* const entry = map.tracer ? &tracer.Instruction
+					(
+						address,
+						cycles.count / cycles.clock[0],
+						a,
+						x,
+						y,
+						sp,
+						flags.Pack()
+					) : NULL;
+
+					cycles.offset = cycles.count;
+					opcode = FetchPc8();
+
+					if (entry)
 					{
-						(++hook)->Execute();
+						entry->data = opcode;
+
+						if (tracer.IsBreakpoint( address ))
+						{
+							callbacks.tracerBreak.Active()( Api::Tracer::BREAK_ADDRESS, address );
+
+							if (!tracer.IsEnabled())
+								map.tracer = NULL;
+						}
 					}
-					while (hook != last);
+
+					(*this.*opcodes[opcode])();
+
+					if (!tracer.IsEnabled())
+						map.tracer = NULL;
+
+					for (const Hook *hook = hooks.Ptr(), *const end = hook+hooks.Size(); hook != end; ++hook)
+						hook->Execute();
 				}
 				while (cycles.count < cycles.round);
 
 				Clock();
 			}
 			while (cycles.count < cycles.frame);
+
+			map.tracer = NULL;
 		}
 
+		#endif
+
 		uint Cpu::Peek(const uint address) const
 		{
 			return map.Peek8( address );
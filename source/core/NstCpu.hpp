@@ -28,6 +28,7 @@
 #include "NstAssert.hpp"
 #include "NstIoMap.hpp"
 #include "NstApu.hpp"
+#include "NstTracer.hpp"
 
 #ifdef NST_PRAGMA_ONCE
 #pragma once
@@ -35,6 +36,11 @@
 
 namespace Nes
 {
+	namespace Api
+	{
+		class Callbacks;
+	}
+
 	namespace Core
 	{
 		class Hook;
@@ -43,7 +49,7 @@ namespace Nes
 		{
 		public:
 
-			Cpu();
+			explicit Cpu(Api::Callbacks&);
 
 			enum
 			{
@@ -95,7 +101,7 @@ namespace Nes
 
 		private:
 
-			static void NotifyOp(const char (&)[4],dword);
+			void NotifyOp(const char (&)[4],dword);
 
 			enum
 			{
@@ -133,6 +139,10 @@ namespace Nes
 			void Run1();
 			void Run2();
 
+		#ifdef NST_TRACE
+			void RunTrace();
+		#endif
+
 			inline void ExecuteOp();
 			inline uint FetchPc8();
 			inline uint FetchPc16();
@@ -445,6 +455,10 @@ namespace Nes
 				inline uint Peek8(uint) const;
 				inline uint Peek16(uint) const;
 				inline void Poke8(uint,uint) const;
+
+			#ifdef NST_TRACE
+				Tracer* tracer;
+			#endif
 			};
 
 			class Linker
@@ -489,8 +503,13 @@ namespace Nes
 			IoMap map;
 			bool cpuOverclocking;
 			uint extraCycles;
+			dword logged;
+			Api::Callbacks& callbacks;
+
+		#ifdef NST_TRACE
+			Tracer tracer;
+		#endif
 
-			static dword logged;
 			static void (Cpu::*const opcodes[0x100])();
 			static const byte writeClocks[0x100];
 
@@ -501,6 +520,23 @@ namespace Nes
 				return apu;
 			}
 
+			Api::Callbacks& GetCallbacks() const
+			{
+				return callbacks;
+			}
+
+		#ifdef NST_TRACE
+			Tracer& GetTracer()
+			{
+				return tracer;
+			}
+
+			const Tracer& GetTracer() const
+			{
+				return tracer;
+			}
+		#endif
+
 			void SetOverclocking(bool overclocking,uint newCycles)
 			{
 				cpuOverclocking = overclocking;
@@ -580,7 +616,7 @@ namespace Nes
 				return ram.mem;
 			}
 
-			Io::Port& Map(Address address)
+			IoMap::Entry Map(Address address)
 			{
 				return map( address );
 			}
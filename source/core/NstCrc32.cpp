@@ -22,40 +22,159 @@
 //
 ////////////////////////////////////////////////////////////////////////////////////////
 
-#include "NstCore.hpp"
+#include "NstAssert.hpp"
 #include "NstCrc32.hpp"
 
+#if defined(NST_MM_INTRINSICS) && (NST_MSVC >= 1500 || NST_GCC >= 409)
+
+#define NST_CRC32_CLMUL
+
+#include <emmintrin.h>
+#include <wmmintrin.h>
+
+#if NST_MSVC
+#include <intrin.h>
+#define NST_CLMUL_TARGET
+#else
+#include <cpuid.h>
+#define NST_CLMUL_TARGET __attribute__((target("sse2,pclmul")))
+#endif
+
+#endif
+
 namespace Nes
 {
 	namespace Core
 	{
 		namespace Crc32
 		{
-			static dword NST_CALL Iterate(uint data,dword crc)
+			struct Lut
 			{
-				struct Lut
-				{
-					dword data[256];
+				dword data[8][256];
 
-					Lut()
+				Lut()
+				{
+					for (uint i=0; i < 256; ++i)
 					{
-						for (uint i=0; i < 256; ++i)
-						{
-							dword n = i;
+						dword n = i;
 
-							for (uint j=0; j < 8; ++j)
-								n = (n >> 1) ^ (((~n & 1) - 1) & 0xEDB88320);
+						for (uint j=0; j < 8; ++j)
+							n = (n >> 1) ^ (((~n & 1) - 1) & 0xEDB88320);
 
-							data[i] = n;
-						}
+						data[0][i] = n;
 					}
-				};
 
+					// tables for slicing eight bytes at a time
+
+					for (uint i=0; i < 256; ++i)
+					{
+						for (uint j=1; j < 8; ++j)
+							data[j][i] = (data[j-1][i] >> 8) ^ data[0][data[j-1][i] & 0xFF];
+					}
+				}
+			};
+
+			static const Lut& GetLut()
+			{
 				static const Lut lut;
+				return lut;
+			}
+
+			static dword NST_CALL Iterate(uint data,dword crc)
+			{
+				return (crc >> 8) ^ GetLut().data[0][(crc ^ data) & 0xFF];
+			}
+
+			static dword Slice(const byte* NST_RESTRICT data,dword length,dword crc)
+			{
+				const Lut& lut = GetLut();
+
+				for (; length >= 8; data += 8, length -= 8)
+				{
+					const dword a = crc ^ (data[0] | uint(data[1]) << 8 | dword(data[2]) << 16 | dword(data[3]) << 24);
+					const dword b = data[4] | uint(data[5]) << 8 | dword(data[6]) << 16 | dword(data[7]) << 24;
+
+					crc =
+					(
+						lut.data[7][a & 0xFF] ^ lut.data[6][a >> 8 & 0xFF] ^ lut.data[5][a >> 16 & 0xFF] ^ lut.data[4][a >> 24] ^
+						lut.data[3][b & 0xFF] ^ lut.data[2][b >> 8 & 0xFF] ^ lut.data[1][b >> 16 & 0xFF] ^ lut.data[0][b >> 24]
+					);
+				}
+
+				for (; length; ++data, --length)
+					crc = (crc >> 8) ^ lut.data[0][(crc ^ *data) & 0xFF];
+
+				return crc;
+			}
 
-				return (crc >> 8) ^ lut.data[(crc ^ data) & 0xFF];
+		#ifdef NST_CRC32_CLMUL
+
+			static bool CanUseClmul()
+			{
+			#if NST_MSVC
+				int info[4];
+				__cpuid( info, 1 );
+				return info[2] & 0x2;
+			#else
+				uint a, b, c, d;
+				return __get_cpuid( 1, &a, &b, &c, &d ) && (c & bit_PCLMUL);
+			#endif
 			}
 
+			// Folds 64 bytes at a time with carry-less multiplies and reduces the
+			// remainder by Barrett reduction. The length must be a multiple of 16
+			// and at least 64. The constants are powers of x modulo the reflected
+			// polynomial, see Intel's "Fast CRC Computation Using PCLMULQDQ".
+
+			NST_CLMUL_TARGET
+			static dword Fold(const byte* NST_RESTRICT data,dword length,dword crc)
+			{
+				NST_ASSERT( length >= 64 && length % 16 == 0 );
+
+				__m128i k = _mm_set_epi32( 0x00000001, 0xC6E41596, 0x00000001, 0x54442BD4 );
+
+				__m128i x0 = _mm_xor_si128( _mm_loadu_si128( reinterpret_cast<const __m128i*>(data + 0x00) ), _mm_cvtsi32_si128( crc ) );
+				__m128i x1 = _mm_loadu_si128( reinterpret_cast<const __m128i*>(data + 0x10) );
+				__m128i x2 = _mm_loadu_si128( reinterpret_cast<const __m128i*>(data + 0x20) );
+				__m128i x3 = _mm_loadu_si128( reinterpret_cast<const __m128i*>(data + 0x30) );
+
+				for (data += 64, length -= 64; length >= 64; data += 64, length -= 64)
+				{
+					x0 = _mm_xor_si128( _mm_xor_si128( _mm_clmulepi64_si128( x0, k, 0x00 ), _mm_clmulepi64_si128( x0, k, 0x11 ) ), _mm_loadu_si128( reinterpret_cast<const __m128i*>(data + 0x00) ) );
+					x1 = _mm_xor_si128( _mm_xor_si128( _mm_clmulepi64_si128( x1, k, 0x00 ), _mm_clmulepi64_si128( x1, k, 0x11 ) ), _mm_loadu_si128( reinterpret_cast<const __m128i*>(data + 0x10) ) );
+					x2 = _mm_xor_si128( _mm_xor_si128( _mm_clmulepi64_si128( x2, k, 0x00 ), _mm_clmulepi64_si128( x2, k, 0x11 ) ), _mm_loadu_si128( reinterpret_cast<const __m128i*>(data + 0x20) ) );
+					x3 = _mm_xor_si128( _mm_xor_si128( _mm_clmulepi64_si128( x3, k, 0x00 ), _mm_clmulepi64_si128( x3, k, 0x11 ) ), _mm_loadu_si128( reinterpret_cast<const __m128i*>(data + 0x30) ) );
+				}
+
+				k = _mm_set_epi32( 0x00000000, 0xCCAA009E, 0x00000001, 0x751997D0 );
+
+				x0 = _mm_xor_si128( _mm_xor_si128( _mm_clmulepi64_si128( x0, k, 0x00 ), _mm_clmulepi64_si128( x0, k, 0x11 ) ), x1 );
+				x0 = _mm_xor_si128( _mm_xor_si128( _mm_clmulepi64_si128( x0, k, 0x00 ), _mm_clmulepi64_si128( x0, k, 0x11 ) ), x2 );
+				x0 = _mm_xor_si128( _mm_xor_si128( _mm_clmulepi64_si128( x0, k, 0x00 ), _mm_clmulepi64_si128( x0, k, 0x11 ) ), x3 );
+
+				for (; length; data += 16, length -= 16)
+					x0 = _mm_xor_si128( _mm_xor_si128( _mm_clmulepi64_si128( x0, k, 0x00 ), _mm_clmulepi64_si128( x0, k, 0x11 ) ), _mm_loadu_si128( reinterpret_cast<const __m128i*>(data) ) );
+
+				// 128 bits down to 64
+
+				const __m128i mask = _mm_set_epi32( 0, ~0, 0, ~0 );
+
+				x0 = _mm_xor_si128( _mm_srli_si128( x0, 8 ), _mm_clmulepi64_si128( x0, k, 0x10 ) );
+				x0 = _mm_xor_si128( _mm_srli_si128( x0, 4 ), _mm_clmulepi64_si128( _mm_and_si128( x0, mask ), _mm_set_epi32( 0, 0, 0x00000001, 0x63CD6124 ), 0x00 ) );
+
+				// Barrett reduction down to 32
+
+				k = _mm_set_epi32( 0x00000001, 0xF7011641, 0x00000001, 0xDB710641 );
+
+				x1 = _mm_clmulepi64_si128( _mm_and_si128( x0, mask ), k, 0x10 );
+				x1 = _mm_clmulepi64_si128( _mm_and_si128( x1, mask ), k, 0x00 );
+				x0 = _mm_xor_si128( x0, x1 );
+
+				return _mm_cvtsi128_si32( _mm_srli_si128( x0, 4 ) );
+			}
+
+		#endif
+
 			dword NST_CALL Compute(uint data,dword crc)
 			{
 				return Iterate( data, crc ^ 0xFFFFFFFF ) ^ 0xFFFFFFFF;
@@ -65,8 +184,21 @@ namespace Nes
 			{
 				crc ^= 0xFFFFFFFF;
 
-				for (const byte* const end=data+length; data != end; ++data)
-					crc = Iterate( *data, crc );
+				dword folded = 0;
+
+			#ifdef NST_CRC32_CLMUL
+
+				static const bool clmul = CanUseClmul();
+
+				if (length >= 64 && clmul)
+				{
+					folded = length & ~dword(15);
+					crc = Fold( data, folded, crc );
+				}
+
+			#endif
+
+				crc = Slice( data + folded, length - folded, crc );
 
 				crc ^= 0xFFFFFFFF;
 
@@ -28,7 +28,7 @@
 #include "NstCrc32.hpp"
 #include "NstState.hpp"
 #include "NstFds.hpp"
-#include "api/NstApiInput.hpp"
+#include "api/NstApiCallbacks.hpp"
 
 namespace Nes
 {
@@ -163,7 +163,7 @@ namespace Nes
 		Fds::Fds(Context& context)
 		:
 		Image         (DISK),
-		disks         (context.stream),
+		disks         (context.stream,context.cpu.GetCallbacks()),
 		adapter       (context.cpu,disks.sides),
 		cpu           (context.cpu),
 		ppu           (context.ppu),
@@ -233,7 +233,7 @@ namespace Nes
 			if (io.led != Api::Fds::MOTOR_OFF)
 			{
 				io.led = Api::Fds::MOTOR_OFF;
-				Api::Fds::driveCallback( Api::Fds::MOTOR_OFF );
+				cpu.GetCallbacks().fdsDrive.Active()( Api::Fds::MOTOR_OFF );
 			}
 
 			return true;
@@ -320,9 +320,9 @@ namespace Nes
 						adapter.Mount( NULL );
 
 						if (prev != Disks::EJECTED)
-							Api::Fds::diskCallback( Api::Fds::DISK_EJECT, prev / 2, prev % 2 );
+							cpu.GetCallbacks().fdsDisk.Active()( Api::Fds::DISK_EJECT, prev / 2, prev % 2 );
 
-						Api::Fds::diskCallback( Api::Fds::DISK_INSERT, disk / 2, disk % 2 );
+						cpu.GetCallbacks().fdsDisk.Active()( Api::Fds::DISK_INSERT, disk / 2, disk % 2 );
 
 						return RESULT_OK;
 					}
@@ -345,7 +345,7 @@ namespace Nes
 
 				adapter.Mount( NULL );
 
-				Api::Fds::diskCallback( Api::Fds::DISK_EJECT, prev / 2, prev % 2 );
+				cpu.GetCallbacks().fdsDisk.Active()( Api::Fds::DISK_EJECT, prev / 2, prev % 2 );
 
 				return RESULT_OK;
 			}
@@ -638,7 +638,8 @@ namespace Nes
 		#pragma optimize("s", on)
 		#endif
 
-		Fds::Disks::Sides::Sides(std::istream& stdStream)
+		Fds::Disks::Sides::Sides(std::istream& stdStream,const Api::Callbacks& callbacks)
+		: file(callbacks)
 		{
 			Stream::In stream( &stdStream );
 
@@ -709,9 +710,9 @@ namespace Nes
 			}
 		}
 
-		Fds::Disks::Disks(std::istream& stream)
+		Fds::Disks::Disks(std::istream& stream,const Api::Callbacks& callbacks)
 		:
-		sides          (stream),
+		sides          (stream,callbacks),
 		crc            (Crc32::Compute( sides[0], sides.count * dword(SIDE_SIZE) )),
 		id             (dword(sides[0][0x0F]) << 24 | dword(sides[0][0x10]) << 16 | uint(sides[0][0x11]) <<  8 | sides[0][0x12]),
 		current        (EJECTED),
@@ -1429,7 +1430,7 @@ namespace Nes
 				if (io.led != led && (io.led != Api::Fds::MOTOR_WRITE || led != Api::Fds::MOTOR_READ))
 				{
 					io.led = led;
-					Api::Fds::driveCallback( static_cast<Api::Fds::Motor>(io.led) );
+					cpu.GetCallbacks().fdsDrive.Active()( static_cast<Api::Fds::Motor>(io.led) );
 				}
 			}
 			else if (!--disks.mounting)
@@ -1490,7 +1491,7 @@ namespace Nes
 			{
 				disks.writeProtected = true;
 				adapter.WriteProtect();
-				Api::Fds::diskCallback( Api::Fds::DISK_NONSTANDARD, disks.current / 2, disks.current % 2 );
+				cpu.GetCallbacks().fdsDisk.Active()( Api::Fds::DISK_NONSTANDARD, disks.current / 2, disks.current % 2 );
 			}
 
 			return data & 0xFF;
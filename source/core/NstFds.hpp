@@ -266,7 +266,7 @@ namespace Nes
 
 			struct Disks
 			{
-				explicit Disks(std::istream&);
+				Disks(std::istream&,const Api::Callbacks&);
 
 				enum
 				{
@@ -278,7 +278,7 @@ namespace Nes
 				{
 				public:
 
-					explicit Sides(std::istream&);
+					Sides(std::istream&,const Api::Callbacks&);
 					~Sides();
 
 					inline byte* operator [] (uint) const;
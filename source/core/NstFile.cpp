@@ -29,7 +29,7 @@
 #include "NstChecksum.hpp"
 #include "NstPatcher.hpp"
 #include "NstFile.hpp"
-#include "api/NstApiUser.hpp"
+#include "api/NstApiCallbacks.hpp"
 
 namespace Nes
 {
@@ -38,13 +38,64 @@ namespace Nes
 
 		struct File::Context
 		{
+			Context()
+			: flushing(false) {}
+
 			Checksum checksum;
 			Vector<byte> data;
+			Vector<byte> saved[DISK+1];
+			bool flushing;
 		};
 
-		File::File()
-		: context( *new Context )
+		File::File(const Api::Callbacks& c)
+		:
+		context   ( *new Context ),
+		callbacks ( c )
+		{
+		}
+
+		void File::Flush(bool flushing) const
+		{
+			context.flushing = flushing;
+		}
+
+		template<typename Block>
+		void File::Track(const Type type,const Block* const block,const uint count) const
 		{
+			// keeps a copy of what the file holds so that a flush
+			// can tell whether the memory has changed since then,
+			// disk images are only written back on power off
+
+			if (type == DISK)
+				return;
+
+			Vector<byte>& saved = context.saved[type];
+			saved.Clear();
+
+			for (const Block* NST_RESTRICT it=block, *const end=block+count; it != end; ++it)
+			{
+				if (it->size)
+					saved.Append( it->data, it->size );
+			}
+		}
+
+		bool File::Modified(const Type type,const SaveBlock* const block,const uint count) const
+		{
+			const Vector<byte>& saved = context.saved[type];
+			dword offset = 0;
+
+			for (const SaveBlock* NST_RESTRICT it=block, *const end=block+count; it != end; ++it)
+			{
+				if (it->size)
+				{
+					if (saved.Size() - offset < it->size || std::memcmp( saved.Begin() + offset, it->data, it->size ))
+						return true;
+
+					offset += it->size;
+				}
+			}
+
+			return offset != saved.Size();
 		}
 
 		File::~File()
@@ -250,13 +301,15 @@ namespace Nes
 
 			{
 				Loader loader( type, loadBlock, loadBlockCount, altered );
-				Api::User::fileIoCallback( loader );
+				callbacks.userFileIo.Active()( loader );
 			}
 
 			context.checksum.Clear();
 
 			for (const LoadBlock* NST_RESTRICT it=loadBlock, *const end=loadBlock+loadBlockCount; it != end; ++it)
 				context.checksum.Compute( it->data, it->size );
+
+			Track( type, loadBlock, loadBlockCount );
 		}
 
 		void File::Load(const Type type,Vector<byte>& buffer,const dword maxsize) const
@@ -360,7 +413,7 @@ namespace Nes
 
 			{
 				Loader loader( type, buffer, maxsize );
-				Api::User::fileIoCallback( loader );
+				callbacks.userFileIo.Active()( loader );
 			}
 
 			if (buffer.Size())
@@ -377,12 +430,20 @@ namespace Nes
 		{
 			NST_ASSERT( saveBlock && saveBlockCount );
 
+			if (context.flushing && !Modified( type, saveBlock, saveBlockCount ))
+				return;
+
+			// the checksum follows whatever was last written, flushed or not,
+			// so that power off doesn't skip data reverted since a flush
+
 			Checksum checksum;
 
 			for (const SaveBlock *NST_RESTRICT it=saveBlock, *const end=saveBlock+saveBlockCount; it != end; ++it)
 				checksum.Compute( it->data, it->size );
 
-			if (checksum != context.checksum)
+			if (!context.flushing && checksum == context.checksum)
+				return;
+
 			{
 				class Saver : public Api::User::File
 				{
@@ -525,8 +586,11 @@ namespace Nes
 				};
 
 				Saver saver( type, saveBlock, saveBlockCount, context.data );
-				Api::User::fileIoCallback( saver );
+				callbacks.userFileIo.Active()( saver );
 			}
+
+			Track( type, saveBlock, saveBlockCount );
+			context.checksum = checksum;
 		}
 	}
 }
@@ -31,6 +31,11 @@
 
 namespace Nes
 {
+	namespace Api
+	{
+		class Callbacks;
+	}
+
 	namespace Core
 	{
 		template<typename T>
@@ -40,10 +45,11 @@ namespace Nes
 		{
 			struct Context;
 			Context& context;
+			const Api::Callbacks& callbacks;
 
 		public:
 
-			File();
+			explicit File(const Api::Callbacks&);
 			~File();
 
 			enum Type
@@ -72,11 +78,16 @@ namespace Nes
 			void Load(Type,byte*,dword) const;
 			void Load(Type,Vector<byte>&,dword) const;
 			void Save(Type,const byte*,dword) const;
+			void Flush(bool) const;
 
 		private:
 
 			void Load(Type,const LoadBlock*,uint,bool* = NULL) const;
 			void Save(Type,const SaveBlock*,uint) const;
+			template<typename Block>
+			void Track(Type,const Block*,uint) const;
+
+			bool Modified(Type,const SaveBlock*,uint) const;
 
 		public:
 
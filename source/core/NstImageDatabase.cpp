@@ -30,6 +30,7 @@
 #include <map>
 #include <algorithm>
 #include "NstLog.hpp"
+#include "NstStream.hpp"
 #include "NstImageDatabase.hpp"
 #include "NstXml.hpp"
 
@@ -78,6 +79,8 @@ namespace Nes
 
 		private:
 
+			friend class Image;
+
 			class String
 			{
 				union
@@ -997,10 +1000,152 @@ namespace Nes
 					}
 				}
 			};
+
+			class Compiler
+			{
+			public:
+
+				Compiler();
+
+				void operator << (const Item*);
+				void Write(std::ostream&,uint) const;
+
+			private:
+
+				struct Less
+				{
+					bool operator () (wcstring a,wcstring b) const
+					{
+						return std::wcscmp( a, b ) < 0;
+					}
+				};
+
+				typedef std::map<wcstring,dword,Less> StringMap;
+
+				void Put8(uint);
+				void Put16(uint);
+				void Put32(dword);
+				void Put(const Hash&);
+				void Put(wcstring);
+				void Put(const Ic&);
+
+				std::vector<dword> hashes;
+				std::vector<byte> records;
+				std::vector<word> strings;
+				StringMap stringMap;
+			};
 		};
 
+		// Compiled database, all values little-endian:
+		//
+		//  header   magic, version, hashing, number of hashes and the section offsets and sizes
+		//  hashes   crc, sha1[5] and record offset per hash, sorted like the items
+		//  records  number of items sharing the hash followed by the items themselves
+		//  strings  null-terminated UTF-16 strings, the empty one at offset 0
+		//
+		// Everything is read in place. Items are only decoded once searched for.
+
+		class ImageDatabase::Image
+		{
+		public:
+
+			explicit Image(std::istream&);
+			Image(const byte*,dword);
+			~Image();
+
+			static bool IsCompiled(std::istream&);
+			const Item* Find(const Hash&,const Item*) const;
+
+			enum
+			{
+				VERSION = 1,
+				HEADER_SIZE = 32,
+				HASH_SIZE = 28
+			};
+
+			static const byte magic[6];
+
+		private:
+
+			class Reader
+			{
+				const byte* const data;
+				const dword size;
+				dword pos;
+
+			public:
+
+				Reader(const byte* d,dword s,dword p=0)
+				: data(d), size(s), pos(p) {}
+
+				uint Read8()
+				{
+					if (pos + 1 > size)
+						throw RESULT_ERR_CORRUPT_FILE;
+
+					return data[pos++];
+				}
+
+				uint Read16()
+				{
+					const uint v = Read8();
+					return v | Read8() << 8;
+				}
+
+				dword Read32()
+				{
+					const dword v = Read16();
+					return v | dword(Read16()) << 16;
+				}
+			};
+
+			typedef std::vector<wchar_t> Strings;
+
+			struct Chain
+			{
+				Item* item;
+				Strings* strings;
+			};
+
+			typedef std::map<dword,Chain> Chains;
+
+			void Validate();
+			Hash GetHash(dword) const;
+			Item* Decode(dword,Strings&) const;
+			dword Decode(Reader&,Strings&) const;
+			void Decode(Reader&,Strings&,Item::Ic::Pins&) const;
+
+			Vector<byte> buffer;
+			const byte* data;
+			dword size;
+			uint hashing;
+			dword numHashes;
+
+			struct
+			{
+				const byte* data;
+				dword size;
+			}   records, strings;
+
+			mutable Chains chains;
+
+		public:
+
+			uint GetHashing() const
+			{
+				return hashing;
+			}
+
+			dword NumHashes() const
+			{
+				return numHashes;
+			}
+		};
+
+		const byte ImageDatabase::Image::magic[6] = {'N','S','T','D','B',0x1A};
+
 		ImageDatabase::ImageDatabase()
-		: enabled(true)
+		: enabled(true), image(NULL)
 		{
 			items.begin = NULL;
 			items.end = NULL;
@@ -1014,7 +1159,7 @@ namespace Nes
 
 		ImageDatabase::Entry ImageDatabase::Search(const Hash& hash,const FavoredSystem favoredSystem) const
 		{
-			if (items.begin)
+			if (items.begin || image)
 			{
 				const Hash searchHash
 				(
@@ -1022,11 +1167,27 @@ namespace Nes
 					( items.hashing & HASHING_CRC  ) ? hash.GetCrc32() : 0UL
 				);
 
-				const Item** item = std::lower_bound( items.begin, items.end, searchHash, Item::Less() );
+				const Item* found = NULL;
 
-				if (item != items.end && (*item)->GetHash() == searchHash)
+				if (items.begin)
 				{
-					for (const Item* it = *item; it; it = it->GetNextSibling())
+					const Item** item = std::lower_bound( items.begin, items.end, searchHash, Item::Less() );
+
+					if (item != items.end && (*item)->GetHash() == searchHash)
+						found = *item;
+				}
+
+				// with a compiled base the XML items are the overrides
+
+				if (image)
+				{
+					if (const Item* const item = image->Find( searchHash, found ))
+						found = item;
+				}
+
+				if (found)
+				{
+					for (const Item* it = found; it; it = it->GetNextSibling())
 					{
 						switch (it->GetSystem())
 						{
@@ -1068,7 +1229,7 @@ namespace Nes
 						}
 					}
 
-					return *item;
+					return found;
 				}
 			}
 
@@ -1182,22 +1343,47 @@ namespace Nes
 		}
 
 		Result ImageDatabase::Load(std::istream& baseStream,std::istream* overrideStream)
+		{
+			return Load( &baseStream, NULL, 0, overrideStream );
+		}
+
+		Result ImageDatabase::Load(const void* data,ulong size,std::istream* overrideStream)
+		{
+			return Load( NULL, data, size, overrideStream );
+		}
+
+		Result ImageDatabase::Load(std::istream* const baseStream,const void* const data,const ulong size,std::istream* const overrideStream)
 		{
 			Unload();
 
 			try
 			{
+				if (!baseStream)
+				{
+					if (size > 0xFFFFFFFF)
+						throw RESULT_ERR_CORRUPT_FILE;
+
+					image = new Image( static_cast<const byte*>(data), size );
+				}
+				else if (Image::IsCompiled( *baseStream ))
+				{
+					image = new Image( *baseStream );
+				}
+
+				if (image)
+					items.hashing = image->GetHashing();
+
 				Xml baseXml, overrideXml;
 				Item::Builder builder;
 
-				for (uint multi=0; multi < (overrideStream ? 2 : 1); ++multi)
+				for (uint multi=(image ? 1 : 0); multi < (overrideStream ? 2 : 1); ++multi)
 				{
 					Xml& xml = (multi ? overrideXml : baseXml);
 
 					try
 					{
-						if (!xml.Read( multi ? *overrideStream : baseStream ))
-							return RESULT_ERR_CORRUPT_FILE;
+						if (!xml.Read( multi ? *overrideStream : *baseStream ))
+							throw RESULT_ERR_CORRUPT_FILE;
 					}
 					catch (...)
 					{
@@ -1205,7 +1391,7 @@ namespace Nes
 					}
 
 					if (!xml.GetRoot().IsType( L"database" ))
-						return RESULT_ERR_INVALID_FILE;
+						throw RESULT_ERR_INVALID_FILE;
 
 					if (const Xml::Attribute attribute=xml.GetRoot().GetAttribute( L"version" ))
 					{
@@ -1611,14 +1797,45 @@ namespace Nes
 			}
 
 			Log() << "Database: "
-                  << (items.end - items.begin)
+                  << dword((items.end - items.begin) + (image ? image->NumHashes() : 0))
                   << " items imported from "
+                  << (image ? "compiled " : "")
                   << (overrideStream ? "internal & external" : "internal")
                   <<  " DB" NST_LINEBREAK;
 
 			return RESULT_OK;
 		}
 
+		Result ImageDatabase::Save(std::ostream& stream) const
+		{
+			if (image || !items.begin)
+				return RESULT_ERR_NOT_READY;
+
+			try
+			{
+				Item::Compiler compiler;
+
+				for (const Item** it=items.begin; it != items.end; ++it)
+					compiler << *it;
+
+				compiler.Write( stream, items.hashing );
+			}
+			catch (Result result)
+			{
+				return result;
+			}
+			catch (const std::bad_alloc&)
+			{
+				return RESULT_ERR_OUT_OF_MEMORY;
+			}
+			catch (...)
+			{
+				return RESULT_ERR_GENERIC;
+			}
+
+			return RESULT_OK;
+		}
+
 		void ImageDatabase::Unload(const bool error)
 		{
 			if (const Item** it=items.begin)
@@ -1639,6 +1856,9 @@ namespace Nes
 
 			strings.Destroy();
 
+			delete image;
+			image = NULL;
+
 			if (error)
 				Log::Flush( "Database: error, aborting.." NST_LINEBREAK );
 		}
@@ -1688,5 +1908,563 @@ namespace Nes
 				delete item;
 			}
 		}
+
+		ImageDatabase::Item::Compiler::Compiler()
+		{
+			strings.push_back( 0 );
+			stringMap.insert( std::pair<wcstring,dword>(L"",0) );
+		}
+
+		void ImageDatabase::Item::Compiler::Put8(const uint data)
+		{
+			records.push_back( data & 0xFF );
+		}
+
+		void ImageDatabase::Item::Compiler::Put16(const uint data)
+		{
+			Put8( data >> 0 );
+			Put8( data >> 8 );
+		}
+
+		void ImageDatabase::Item::Compiler::Put32(const dword data)
+		{
+			Put16( data >> 0 & 0xFFFF );
+			Put16( data >> 16 );
+		}
+
+		void ImageDatabase::Item::Compiler::Put(const Hash& hash)
+		{
+			Put32( hash.GetCrc32() );
+
+			for (uint i=0; i < Hash::SHA1_WORD_LENGTH; ++i)
+				Put32( hash.GetSha1()[i] );
+		}
+
+		void ImageDatabase::Item::Compiler::Put(wcstring string)
+		{
+			const std::pair<StringMap::iterator,bool> entry
+			(
+				stringMap.insert( std::pair<wcstring,dword>(string,strings.size()) )
+			);
+
+			if (entry.second)
+			{
+				for (; *string; ++string)
+					strings.push_back( *string & 0xFFFF );
+
+				strings.push_back( 0 );
+			}
+
+			Put32( entry.first->second );
+		}
+
+		void ImageDatabase::Item::Compiler::Put(const Ic& ic)
+		{
+			Put( ic.package );
+			Put16( ic.pins.size() );
+
+			for (Ic::Pins::const_iterator it(ic.pins.begin()), end(ic.pins.end()); it != end; ++it)
+			{
+				Put16( it->number );
+				Put( it->function );
+			}
+		}
+
+		void ImageDatabase::Item::Compiler::operator << (const Item* const item)
+		{
+			hashes.push_back( item->hash.GetCrc32() );
+
+			for (uint i=0; i < Hash::SHA1_WORD_LENGTH; ++i)
+				hashes.push_back( item->hash.GetSha1()[i] );
+
+			hashes.push_back( records.size() );
+
+			uint count = 0;
+
+			for (const Item* it=item; it; it=it->sibling)
+				++count;
+
+			Put16( count );
+
+			for (const Item* it=item; it; it=it->sibling)
+			{
+				Put( it->dump.by            );
+				Put( it->dump.date          );
+				Put( it->title              );
+				Put( it->altTitle           );
+				Put( it->clss               );
+				Put( it->subClss            );
+				Put( it->catalog            );
+				Put( it->publisher          );
+				Put( it->developer          );
+				Put( it->portDeveloper      );
+				Put( it->region             );
+				Put( it->revision           );
+				Put( it->board              );
+				Put( it->pcb                );
+				Put( it->cic                );
+				Put8( it->dump.state        );
+				Put8( it->system            );
+				Put8( it->cpu               );
+				Put8( it->ppu               );
+				Put8( it->players           );
+				Put8( it->solderPads        );
+				Put8( it->multiRegion       );
+				Put16( it->mapper           );
+
+				for (uint i=0; i < MAX_PERIPHERALS; ++i)
+					Put8( it->peripherals[i] );
+
+				Put16( it->properties.size() );
+
+				for (Properties::const_iterator j(it->properties.begin()), end(it->properties.end()); j != end; ++j)
+				{
+					Put( j->name );
+					Put( j->value );
+				}
+
+				for (uint i=0; i < 2; ++i)
+				{
+					const Roms& roms = (i ? it->chr : it->prg);
+					Put16( roms.size() );
+
+					for (Roms::const_iterator j(roms.begin()), end(roms.end()); j != end; ++j)
+					{
+						Put32( j->id );
+						Put( j->name );
+						Put32( j->size );
+						Put( j->hash );
+						Put( *j );
+					}
+				}
+
+				for (uint i=0; i < 2; ++i)
+				{
+					const Rams& rams = (i ? it->vram : it->wram);
+					Put16( rams.size() );
+
+					for (Rams::const_iterator j(rams.begin()), end(rams.end()); j != end; ++j)
+					{
+						Put32( j->id );
+						Put32( j->size );
+						Put8( j->battery );
+						Put( *j );
+					}
+				}
+
+				Put16( it->chips.size() );
+
+				for (Chips::const_iterator j(it->chips.begin()), end(it->chips.end()); j != end; ++j)
+				{
+					Put( j->type );
+					Put8( j->battery );
+					Put( *j );
+				}
+			}
+		}
+
+		void ImageDatabase::Item::Compiler::Write(std::ostream& stdStream,const uint hashing) const
+		{
+			const dword numHashes = hashes.size() / (Image::HASH_SIZE / 4);
+			const dword recordsOffset = Image::HEADER_SIZE + numHashes * Image::HASH_SIZE;
+			const dword stringsOffset = recordsOffset + records.size();
+
+			Stream::Out stream( &stdStream );
+
+			stream.Write( Image::magic );
+			stream.Write16( Image::VERSION );
+			stream.Write32( hashing );
+			stream.Write32( numHashes );
+			stream.Write32( recordsOffset );
+			stream.Write32( records.size() );
+			stream.Write32( stringsOffset );
+			stream.Write32( strings.size() * 2 );
+
+			for (std::vector<dword>::const_iterator it(hashes.begin()), end(hashes.end()); it != end; ++it)
+				stream.Write32( *it );
+
+			if (!records.empty())
+				stream.Write( &records.front(), records.size() );
+
+			std::vector<byte> pool( strings.size() * 2 );
+
+			for (dword i=0, n=strings.size(); i < n; ++i)
+			{
+				pool[i*2+0] = strings[i] >> 0 & 0xFF;
+				pool[i*2+1] = strings[i] >> 8;
+			}
+
+			stream.Write( &pool.front(), pool.size() );
+		}
+
+		ImageDatabase::Image::Image(std::istream& stdStream)
+		: data(NULL), size(0)
+		{
+			Stream::In stream( &stdStream );
+
+			const ulong length = stream.Length();
+
+			if (length < HEADER_SIZE || length > 0xFFFFFFFF)
+				throw RESULT_ERR_CORRUPT_FILE;
+
+			buffer.Resize( length );
+			stream.Read( buffer.Begin(), length );
+
+			data = buffer.Begin();
+			size = length;
+
+			Validate();
+		}
+
+		ImageDatabase::Image::Image(const byte* d,dword s)
+		: data(d), size(s)
+		{
+			Validate();
+		}
+
+		ImageDatabase::Image::~Image()
+		{
+			for (Chains::const_iterator it(chains.begin()), end(chains.end()); it != end; ++it)
+			{
+				delete it->second.item;
+				delete it->second.strings;
+			}
+		}
+
+		bool ImageDatabase::Image::IsCompiled(std::istream& stdStream)
+		{
+			Stream::In stream( &stdStream );
+
+			if (stream.Length() < HEADER_SIZE)
+				return false;
+
+			byte header[sizeof(magic)];
+			stream.Peek( header, sizeof(header) );
+
+			return std::memcmp( header, magic, sizeof(magic) ) == 0;
+		}
+
+		void ImageDatabase::Image::Validate()
+		{
+			if (!data || size < HEADER_SIZE || std::memcmp( data, magic, sizeof(magic) ))
+				throw RESULT_ERR_INVALID_FILE;
+
+			Reader header( data, HEADER_SIZE, sizeof(magic) );
+
+			if (header.Read16() != VERSION)
+				throw RESULT_ERR_UNSUPPORTED_FILE_VERSION;
+
+			hashing = header.Read32();
+			numHashes = header.Read32();
+
+			const dword recordsOffset = header.Read32();
+			records.size = header.Read32();
+			const dword stringsOffset = header.Read32();
+			strings.size = header.Read32();
+
+			if
+			(
+				!(hashing & (HASHING_SHA1|HASHING_CRC)) || (hashing & ~uint(HASHING_SHA1|HASHING_CRC)) ||
+				numHashes > (size - HEADER_SIZE) / HASH_SIZE ||
+				recordsOffset != HEADER_SIZE + numHashes * HASH_SIZE ||
+				records.size > size - recordsOffset ||
+				stringsOffset != recordsOffset + records.size ||
+				strings.size != size - stringsOffset ||
+				strings.size < 2 || strings.size % 2 ||
+				data[stringsOffset] || data[stringsOffset+1] ||
+				data[size-2] || data[size-1]
+			)
+				throw RESULT_ERR_CORRUPT_FILE;
+
+			records.data = data + recordsOffset;
+			strings.data = data + stringsOffset;
+		}
+
+		ImageDatabase::Hash ImageDatabase::Image::GetHash(const dword index) const
+		{
+			NST_ASSERT( index < numHashes );
+
+			Reader reader( data, size, HEADER_SIZE + index * HASH_SIZE );
+
+			const dword crc = reader.Read32();
+			dword sha1[Hash::SHA1_WORD_LENGTH];
+
+			for (uint i=0; i < Hash::SHA1_WORD_LENGTH; ++i)
+				sha1[i] = reader.Read32();
+
+			return Hash( sha1, crc );
+		}
+
+		const ImageDatabase::Item* ImageDatabase::Image::Find(const Hash& hash,const Item* const overrides) const
+		{
+			dword first = 0;
+
+			for (dword count=numHashes; count; )
+			{
+				const dword step = count / 2;
+
+				if (GetHash( first + step ) < hash)
+				{
+					first += step + 1;
+					count -= step + 1;
+				}
+				else
+				{
+					count = step;
+				}
+			}
+
+			if (first == numHashes || !(GetHash( first ) == hash))
+				return NULL;
+
+			Chains::const_iterator it( chains.find( first ) );
+
+			if (it == chains.end())
+			{
+				Chain chain;
+
+				chain.item = NULL;
+				chain.strings = new Strings;
+
+				try
+				{
+					chain.item = Decode( first, *chain.strings );
+
+					// same merging as when both databases are XML
+
+					for (const Item* override=overrides; override; override=override->sibling)
+					{
+						Item* const item = new Item( *override );
+						item->sibling = NULL;
+
+						if (!chain.item->Add( item ))
+							delete item;
+					}
+
+					it = chains.insert( Chains::value_type(first,chain) ).first;
+				}
+				catch (Result)
+				{
+					// corrupt record, treat as not found
+					delete chain.strings;
+					return NULL;
+				}
+				catch (...)
+				{
+					delete chain.item;
+					delete chain.strings;
+					throw;
+				}
+			}
+
+			return it->second.item;
+		}
+
+		dword ImageDatabase::Image::Decode(Reader& reader,Strings& lut) const
+		{
+			const dword offset = reader.Read32();
+
+			if (!offset)
+				return 0;
+
+			if (offset >= strings.size / 2)
+				throw RESULT_ERR_CORRUPT_FILE;
+
+			const dword id = lut.size();
+
+			for (const byte* it=strings.data + offset * 2; it[0] | it[1]; it += 2)
+				lut.push_back( it[0] | uint(it[1]) << 8 );
+
+			lut.push_back( L'\0' );
+
+			return id;
+		}
+
+		void ImageDatabase::Image::Decode(Reader& reader,Strings& lut,Item::Ic::Pins& pins) const
+		{
+			for (uint count=reader.Read16(); count; --count)
+			{
+				const uint number = reader.Read16();
+				const dword function = Decode( reader, lut );
+
+				if (number < MIN_IC_PINS || number > MAX_IC_PINS)
+					throw RESULT_ERR_CORRUPT_FILE;
+
+				pins.push_back( Item::Ic::Pin(number,function) );
+			}
+		}
+
+		ImageDatabase::Item* ImageDatabase::Image::Decode(const dword index,Strings& lut) const
+		{
+			const Hash hash( GetHash(index) );
+
+			Reader reader( records.data, records.size, Reader( data, size, HEADER_SIZE + index * HASH_SIZE + HASH_SIZE - 4 ).Read32() );
+
+			uint count = reader.Read16();
+
+			if (!count)
+				throw RESULT_ERR_CORRUPT_FILE;
+
+			lut.push_back( L'\0' );
+
+			Item* first = NULL;
+			Item* last = NULL;
+
+			try
+			{
+				do
+				{
+					const dword dumpBy        = Decode( reader, lut );
+					const dword dumpDate      = Decode( reader, lut );
+					const dword title         = Decode( reader, lut );
+					const dword altTitle      = Decode( reader, lut );
+					const dword clss          = Decode( reader, lut );
+					const dword subClss       = Decode( reader, lut );
+					const dword catalog       = Decode( reader, lut );
+					const dword publisher     = Decode( reader, lut );
+					const dword developer     = Decode( reader, lut );
+					const dword portDeveloper = Decode( reader, lut );
+					const dword region        = Decode( reader, lut );
+					const dword revision      = Decode( reader, lut );
+					const dword board         = Decode( reader, lut );
+					const dword pcb           = Decode( reader, lut );
+					const dword cic           = Decode( reader, lut );
+
+					const Profile::Dump::State dumpState = static_cast<Profile::Dump::State>(reader.Read8());
+					const Profile::System::Type system = static_cast<Profile::System::Type>(reader.Read8());
+					const Profile::System::Cpu cpu = static_cast<Profile::System::Cpu>(reader.Read8());
+					const Profile::System::Ppu ppu = static_cast<Profile::System::Ppu>(reader.Read8());
+					const uint players = reader.Read8();
+					const uint solderPads = reader.Read8();
+					const bool multiRegion = reader.Read8();
+					const uint mapper = reader.Read16();
+
+					byte peripherals[Item::MAX_PERIPHERALS];
+
+					for (uint i=0; i < Item::MAX_PERIPHERALS; ++i)
+						peripherals[i] = reader.Read8();
+
+					Item::Properties properties;
+
+					for (uint n=reader.Read16(); n; --n)
+					{
+						const dword name = Decode( reader, lut );
+						const dword value = Decode( reader, lut );
+
+						properties.push_back( Item::Property(name,value) );
+					}
+
+					Item::Roms roms[2];
+
+					for (uint i=0; i < 2; ++i)
+					{
+						for (uint n=reader.Read16(); n; --n)
+						{
+							const dword id = reader.Read32();
+							const dword name = Decode( reader, lut );
+							const dword length = reader.Read32();
+
+							dword crc = reader.Read32();
+							dword sha1[Hash::SHA1_WORD_LENGTH];
+
+							for (uint j=0; j < Hash::SHA1_WORD_LENGTH; ++j)
+								sha1[j] = reader.Read32();
+
+							const dword package = Decode( reader, lut );
+
+							Item::Ic::Pins pins;
+							Decode( reader, lut, pins );
+
+							roms[i].push_back( Item::Rom(id,name,length,package,pins,Hash(sha1,crc)) );
+						}
+					}
+
+					Item::Rams rams[2];
+
+					for (uint i=0; i < 2; ++i)
+					{
+						for (uint n=reader.Read16(); n; --n)
+						{
+							const dword id = reader.Read32();
+							const dword length = reader.Read32();
+							const bool battery = reader.Read8();
+							const dword package = Decode( reader, lut );
+
+							Item::Ic::Pins pins;
+							Decode( reader, lut, pins );
+
+							rams[i].push_back( Item::Ram(id,length,battery,package,pins) );
+						}
+					}
+
+					Item::Chips chips;
+
+					for (uint n=reader.Read16(); n; --n)
+					{
+						const dword type = Decode( reader, lut );
+						const bool battery = reader.Read8();
+						const dword package = Decode( reader, lut );
+
+						Item::Ic::Pins pins;
+						Decode( reader, lut, pins );
+
+						chips.push_back( Item::Chip(type,battery,package,pins) );
+					}
+
+					Item* const item = new Item
+					(
+						hash,
+						dumpBy,
+						dumpDate,
+						dumpState,
+						title,
+						altTitle,
+						clss,
+						subClss,
+						catalog,
+						publisher,
+						developer,
+						portDeveloper,
+						region,
+						properties,
+						players,
+						peripherals,
+						system,
+						cpu,
+						ppu,
+						revision,
+						board,
+						pcb,
+						mapper,
+						roms[0],
+						roms[1],
+						rams[0],
+						rams[1],
+						chips,
+						cic,
+						solderPads
+					);
+
+					item->multiRegion = multiRegion;
+
+					if (last)
+						last->sibling = item;
+					else
+						first = item;
+
+					last = item;
+				}
+				while (--count);
+			}
+			catch (...)
+			{
+				delete first;
+				throw;
+			}
+
+			first->Finalize( &lut.front() );
+
+			return first;
+		}
 	}
 }
@@ -39,6 +39,7 @@ namespace Nes
 		class ImageDatabase
 		{
 			class Item;
+			class Image;
 
 		public:
 
@@ -100,10 +101,13 @@ namespace Nes
 			};
 
 			Entry Search(const Hash&,FavoredSystem) const;
+			Result Save(std::ostream&) const;
 
 		private:
 
 			Result Load(std::istream&,std::istream*);
+			Result Load(const void*,ulong,std::istream*);
+			Result Load(std::istream*,const void*,ulong,std::istream*);
 			void Unload(bool);
 
 			typedef Vector<wchar_t> Strings;
@@ -132,6 +136,7 @@ namespace Nes
 			}   items;
 
 			Strings strings;
+			Image* image;
 
 		public:
 
@@ -145,6 +150,16 @@ namespace Nes
 				return Load( baseStream, &overrideStream );
 			}
 
+			Result Load(const void* data,ulong size)
+			{
+				return Load( data, size, NULL );
+			}
+
+			Result Load(const void* data,ulong size,std::istream& overrideStream)
+			{
+				return Load( data, size, &overrideStream );
+			}
+
 			void Unload()
 			{
 				Unload( false );
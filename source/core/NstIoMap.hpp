@@ -45,81 +45,391 @@ namespace Nes
 				{
 					SIZE = N,
 					OVERFLOW_SIZE = 0x100,
-					FULL_SIZE = SIZE + OVERFLOW_SIZE
+					FULL_SIZE = SIZE + OVERFLOW_SIZE,
+					PAGE_SIZE = 0x100,
+					NUM_PAGES = FULL_SIZE / PAGE_SIZE
 				};
 
-			protected:
+			private:
 
-				Port ports[FULL_SIZE];
+				NST_COMPILE_ASSERT( SIZE % PAGE_SIZE == 0 && OVERFLOW_SIZE == PAGE_SIZE );
+
+				// Addresses are decoded through a page table. A page served by a single
+				// port keeps a copy of it, others point to a block of per-address ports
+				// shared by all pages of equal layout. Pages of plain memory can also be
+				// read or written through the bank pointer behind them, which follows any
+				// bank switching by itself, until their reader or writer is changed.
+
+				struct Block
+				{
+					Port ports[PAGE_SIZE];
+					dword refs;
+				};
+
+				struct Page
+				{
+					const Port* ports;
+					uint mask;
+					const byte* const* peek;
+					byte* const* poke;
+					dword bank;
+					Block* block;
+					byte* memory;
+					Port port;
+				};
+
+				Page pages[NUM_PAGES];
 
 			public:
 
+				class Entry;
+				class Section;
+
+			private:
+
+				friend class Entry;
+				friend class Section;
+
+				Map(const Map&);
+				void operator = (const Map&);
+
+				Port* Modify(Page&);
+				void Assign(Address,const Port&);
+				void Assign(Address,Address,const Port&);
+				void SetMemory(Address,Address,byte*,byte* const*,dword,bool);
+
+				static void Release(Page&);
+
+			public:
+
+				class Entry
+				{
+					Map& map;
+					const Address address;
+
+				public:
+
+					Entry(Map& m,Address a)
+					: map(m), address(a) {}
+
+					template<typename A,typename B,typename C>
+					void Set(A a,B b,C c)
+					{
+						Port port( map[address] );
+						port.Set( a, b, c );
+						map.Assign( address, port );
+					}
+
+					template<typename A,typename B>
+					void Set(A a,B b)
+					{
+						Port port( map[address] );
+						port.Set( a, b );
+						map.Assign( address, port );
+					}
+
+					template<typename A>
+					void Set(A a)
+					{
+						Port port( map[address] );
+						port.Set( a );
+						map.Assign( address, port );
+					}
+
+					void operator = (const Port& port)
+					{
+						map.Assign( address, port );
+					}
+
+					bool operator == (const Port& port) const
+					{
+						return map[address] == port;
+					}
+
+					operator const Port& () const
+					{
+						return map[address];
+					}
+				};
+
 				class Section
 				{
-					Port* NST_RESTRICT port;
-					const Port* const end;
+					Map& map;
+					const Address first;
+					const Address last;
 
 				public:
 
-					Section(Port* b,const Port* e)
-					: port(b), end(e) {}
+					Section(Map& m,Address f,Address l)
+					: map(m), first(f), last(l) {}
 
 					template<typename A,typename B,typename C>
 					void Set(A a,B b,C c)
 					{
-						do
-						{
-							port->Set( a, b, c );
-						}
-						while (++port != end);
+						Port port;
+						port.Set( a, b, c );
+						map.Assign( first, last, port );
 					}
 
 					template<typename A,typename B>
 					void Set(A a,B b)
 					{
-						do
+						for (Address address=first; address <= last; ++address)
 						{
-							port->Set( a, b );
+							Port port( map[address] );
+							port.Set( a, b );
+							map.Assign( address, port );
 						}
-						while (++port != end);
 					}
 
 					template<typename A>
 					void Set(A a)
 					{
-						do
+						for (Address address=first; address <= last; ++address)
 						{
-							port->Set( a );
+							Port port( map[address] );
+							port.Set( a );
+							map.Assign( address, port );
 						}
-						while (++port != end);
+					}
+
+					void SetMemory(byte* const* slot,dword bank,bool writable)
+					{
+						map.SetMemory( first, last, NULL, slot, bank, writable );
+					}
+
+					void SetMemory(byte* memory,dword bank,bool writable)
+					{
+						map.SetMemory( first, last, memory, NULL, bank, writable );
 					}
 				};
 
 				template<typename A,typename B,typename C>
 				Map(A a,B b,C c)
 				{
-					for (dword i=SIZE; i < FULL_SIZE; ++i)
-						ports[i].Set( a, b, c );
+					for (uint i=0; i < NUM_PAGES; ++i)
+					{
+						Page& page = pages[i];
+
+						page.port.Set( a, b, c );
+						page.ports = &page.port;
+						page.mask = 0;
+						page.peek = NULL;
+						page.poke = NULL;
+						page.bank = 0;
+						page.block = NULL;
+						page.memory = NULL;
+					}
 				}
 
+				~Map();
+
+				void Compact();
+
 				const Port& operator [] (Address address) const
 				{
 					NST_ASSERT( address < FULL_SIZE );
-					return ports[address];
+
+					const Page& page = pages[address / PAGE_SIZE];
+					return page.ports[address & page.mask];
 				}
 
-				Port& operator () (Address address)
+				Entry operator () (Address address)
 				{
 					NST_ASSERT( address < FULL_SIZE );
-					return ports[address];
+					return Entry( *this, address );
 				}
 
 				Section operator () (Address first,Address last)
 				{
 					NST_ASSERT( first <= last && last < SIZE );
-					return Section( ports + first, ports + last + 1 );
+					return Section( *this, first, last );
+				}
+
+				uint Peek(Address address) const
+				{
+					NST_ASSERT( address < FULL_SIZE );
+
+					const Page& page = pages[address / PAGE_SIZE];
+
+					if (page.peek)
+						return (*page.peek)[address & page.bank];
+
+					return page.ports[address & page.mask].Peek( address );
+				}
+
+				void Poke(Address address,Data data) const
+				{
+					NST_ASSERT( address < FULL_SIZE );
+
+					const Page& page = pages[address / PAGE_SIZE];
+
+					if (page.poke)
+						(*page.poke)[address & page.bank] = data;
+					else
+						page.ports[address & page.mask].Poke( address, data );
 				}
 			};
+
+			template<dword N>
+			Map<N>::~Map()
+			{
+				for (uint i=0; i < NUM_PAGES; ++i)
+					Release( pages[i] );
+			}
+
+			template<dword N>
+			void Map<N>::Release(Page& page)
+			{
+				if (page.block && !--page.block->refs)
+					delete page.block;
+
+				page.block = NULL;
+				page.ports = &page.port;
+				page.mask = 0;
+			}
+
+			template<dword N>
+			Port* Map<N>::Modify(Page& page)
+			{
+				if (!page.block || page.block->refs > 1)
+				{
+					Block* const block = new Block;
+					block->refs = 1;
+
+					for (uint i=0; i < PAGE_SIZE; ++i)
+						block->ports[i] = page.ports[i & page.mask];
+
+					if (page.block)
+						page.block->refs--;
+
+					page.block = block;
+					page.ports = block->ports;
+					page.mask = PAGE_SIZE-1;
+				}
+
+				return page.block->ports;
+			}
+
+			template<dword N>
+			void Map<N>::Assign(const Address address,const Port& port)
+			{
+				Page& page = pages[address / PAGE_SIZE];
+				const Port& old = page.ports[address & page.mask];
+
+				if (!(old == port))
+				{
+					if (!old.SameReader( port ))
+						page.peek = NULL;
+
+					if (!old.SameWriter( port ))
+						page.poke = NULL;
+
+					Modify( page )[address % PAGE_SIZE] = port;
+				}
+			}
+
+			template<dword N>
+			void Map<N>::Assign(Address address,const Address last,const Port& port)
+			{
+				while (address <= last)
+				{
+					Page& page = pages[address / PAGE_SIZE];
+					const Address next = (address / PAGE_SIZE + 1) * PAGE_SIZE;
+
+					if (address % PAGE_SIZE == 0 && next - 1 <= last)
+					{
+						// a direct page has the same reader or writer at every address
+
+						if (!page.ports[0].SameReader( port ))
+							page.peek = NULL;
+
+						if (!page.ports[0].SameWriter( port ))
+							page.poke = NULL;
+
+						Release( page );
+						page.port = port;
+					}
+					else
+					{
+						for (const Address end = NST_MIN(next-1,last); address <= end; ++address)
+							Assign( address, port );
+					}
+
+					address = next;
+				}
+			}
+
+			template<dword N>
+			void Map<N>::SetMemory(const Address first,const Address last,byte* const memory,byte* const* const slot,const dword bank,const bool writable)
+			{
+				// the ports of the range must read, and write if writable, plain memory
+				// the same way or the direct access would change what the CPU sees
+
+				NST_ASSERT( first % PAGE_SIZE == 0 && last % PAGE_SIZE == PAGE_SIZE-1 && last < SIZE );
+				NST_ASSERT( (memory || slot) && (bank & (bank+1)) == 0 && bank >= PAGE_SIZE-1 );
+
+				for (uint i=first / PAGE_SIZE; i <= last / PAGE_SIZE; ++i)
+				{
+					Page& page = pages[i];
+
+					page.memory = memory;
+					page.peek = slot ? slot : &page.memory;
+					page.poke = writable ? (slot ? slot : &page.memory) : NULL;
+					page.bank = bank;
+				}
+			}
+
+			template<dword N>
+			void Map<N>::Compact()
+			{
+				// fold pages that were set up one address at a time back into
+				// single ports or blocks shared with other pages
+
+				for (uint i=0; i < NUM_PAGES; ++i)
+				{
+					Page& page = pages[i];
+
+					if (!page.block)
+						continue;
+
+					uint same = 1;
+
+					while (same < PAGE_SIZE && page.block->ports[same] == page.block->ports[0])
+						++same;
+
+					if (same == PAGE_SIZE)
+					{
+						const Port port( page.block->ports[0] );
+						Release( page );
+						page.port = port;
+						continue;
+					}
+
+					for (uint j=0; j < i; ++j)
+					{
+						const Block* const block = pages[j].block;
+
+						if (block && block != page.block)
+						{
+							uint k = 0;
+
+							while (k < PAGE_SIZE && block->ports[k] == page.block->ports[k])
+								++k;
+
+							if (k == PAGE_SIZE)
+							{
+								Release( page );
+								page.block = pages[j].block;
+								page.block->refs++;
+								page.ports = page.block->ports;
+								page.mask = PAGE_SIZE-1;
+								break;
+							}
+						}
+					}
+				}
+			}
 		}
 	}
 }
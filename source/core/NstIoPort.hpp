@@ -117,6 +117,16 @@ namespace Nes
 				{
 					return component == p.component && reader == p.reader && writer == p.writer;
 				}
+
+				bool SameReader(const Port& p) const
+				{
+					return component == p.component && reader == p.reader;
+				}
+
+				bool SameWriter(const Port& p) const
+				{
+					return component == p.component && writer == p.writer;
+				}
 			};
 
 			#define NES_DECL_PEEK(a_) Data NST_FASTCALL Peek_##a_(Address)
@@ -193,6 +203,16 @@ namespace Nes
 				{
 					return component == p.component && reader == p.reader && writer == p.writer;
 				}
+
+				bool SameReader(const Port& p) const
+				{
+					return component == p.component && reader == p.reader;
+				}
+
+				bool SameWriter(const Port& p) const
+				{
+					return component == p.component && writer == p.writer;
+				}
 			};
 
 			#define NES_DECL_PEEK(a_)                                                        \
@@ -47,13 +47,16 @@ namespace Nes
 		:
 		state         (Api::Machine::NTSC),
 		frame         (0),
+		stateSize     (0),
+		cpu           (callbacks),
 		extPort       (new Input::AdapterTwo( *new Input::Pad(cpu,0), *new Input::Pad(cpu,1) )),
 		expPort       (new Input::Device( cpu )),
 		image         (NULL),
 		cheats        (NULL),
 		homebrew      (NULL),
 		imageDatabase (NULL),
-		ppu           (cpu)
+		ppu           (cpu),
+		renderer      (callbacks)
 		{
 		}
 
@@ -138,7 +141,7 @@ namespace Nes
 
 			UpdateModels();
 
-			Api::Machine::eventCallback( Api::Machine::EVENT_LOAD, context.result );
+			callbacks.machineEvent.Active()( Api::Machine::EVENT_LOAD, context.result );
 
 			return context.result;
 		}
@@ -154,10 +157,11 @@ namespace Nes
 
 			Image::Unload( image );
 			image = NULL;
+			stateSize = 0;
 
 			state &= (Api::Machine::NTSC|Api::Machine::PAL);
 
-			Api::Machine::eventCallback( Api::Machine::EVENT_UNLOAD, result );
+			callbacks.machineEvent.Active()( Api::Machine::EVENT_UNLOAD, result );
 
 			return result;
 		}
@@ -179,6 +183,8 @@ namespace Nes
 				ppuModel = (region == REGION_NTSC ? PPU_RP2C02 : PPU_RP2C07);
 			}
 
+			stateSize = 0;
+
 			cpu.SetModel( cpuModel );
 			UpdateVideo( ppuModel, GetColorMode() );
 
@@ -243,6 +249,7 @@ namespace Nes
 		{
 			if (state & Api::Machine::ON)
 			{
+				renderer.FinishBlit();
 				tracker.PowerOff();
 
 				if (image && !image->PowerOff() && NES_SUCCEEDED(result))
@@ -254,7 +261,7 @@ namespace Nes
 				state &= ~uint(Api::Machine::ON);
 				frame = 0;
 
-				Api::Machine::eventCallback( Api::Machine::EVENT_POWER_OFF, result );
+				callbacks.machineEvent.Active()( Api::Machine::EVENT_POWER_OFF, result );
 			}
 
 			return result;
@@ -268,6 +275,7 @@ namespace Nes
 			try
 			{
 				frame = 0;
+				stateSize = 0;
 				cpu.Reset( hard );
 
 				if (!(state & Api::Machine::SOUND))
@@ -312,12 +320,12 @@ namespace Nes
 
 				if (state & Api::Machine::ON)
 				{
-					Api::Machine::eventCallback( hard ? Api::Machine::EVENT_RESET_HARD : Api::Machine::EVENT_RESET_SOFT );
+					callbacks.machineEvent.Active()( hard ? Api::Machine::EVENT_RESET_HARD : Api::Machine::EVENT_RESET_SOFT );
 				}
 				else
 				{
 					state |= Api::Machine::ON;
-					Api::Machine::eventCallback( Api::Machine::EVENT_POWER_ON );
+					callbacks.machineEvent.Active()( Api::Machine::EVENT_POWER_ON );
 				}
 			}
 			catch (...)
@@ -343,11 +351,13 @@ namespace Nes
 
 			UpdateModels();
 
-			Api::Machine::eventCallback( (state & Api::Machine::NTSC) ? Api::Machine::EVENT_MODE_NTSC : Api::Machine::EVENT_MODE_PAL );
+			callbacks.machineEvent.Active()( (state & Api::Machine::NTSC) ? Api::Machine::EVENT_MODE_NTSC : Api::Machine::EVENT_MODE_PAL );
 		}
 
 		void Machine::InitializeInputDevices() const
 		{
+			stateSize = 0;
+
 			if (state & Api::Machine::GAME)
 			{
 				const bool arcade = state & Api::Machine::VS;
@@ -389,6 +399,37 @@ namespace Nes
 			saver.End();
 		}
 
+		dword Machine::SaveState(byte* const data,const dword length) const
+		{
+			stateSize = 0;
+
+			State::Saver saver( data, length );
+			SaveState( saver );
+
+			return stateSize = saver.Size();
+		}
+
+		dword Machine::GetStateSize() const
+		{
+			if (!stateSize)
+				SaveState( NULL, 0 );
+
+			return stateSize;
+		}
+
+		dword Machine::HashState() const
+		{
+			if ((state & (Api::Machine::GAME|Api::Machine::ON)) <= Api::Machine::ON)
+				return 0;
+
+			dword crc = 0;
+
+			State::Saver saver( crc );
+			SaveState( saver );
+
+			return crc;
+		}
+
 		bool Machine::LoadState(State::Loader& loader,const bool resetOnError)
 		{
 			NST_ASSERT( (state & (Api::Machine::GAME|Api::Machine::ON)) > Api::Machine::ON );
@@ -410,7 +451,7 @@ namespace Nes
 							(
 								loader.CheckCrc() && !(state & Api::Machine::DISK) &&
 								crc && crc != image->GetPrgCrc() &&
-								Api::User::questionCallback( Api::User::QUESTION_NST_PRG_CRC_FAIL_CONTINUE ) == Api::User::ANSWER_NO
+								callbacks.userQuestion.Active()( Api::User::QUESTION_NST_PRG_CRC_FAIL_CONTINUE ) == Api::User::ANSWER_NO
 							)
 							{
 								for (uint i=0; i < 2; ++i)
@@ -518,13 +559,22 @@ namespace Nes
 				if (cheats)
 					cheats->BeginFrame( tracker.IsFrameLocked() );
 
+				profiler.Begin( Profiler::CPU_EXECUTE_FRAME );
 				cpu.ExecuteFrame( sound );
+				profiler.End( Profiler::CPU_EXECUTE_FRAME );
+
+				profiler.Begin( Profiler::PPU_END_FRAME );
 				ppu.EndFrame();
+				profiler.End( Profiler::PPU_END_FRAME );
 
 				renderer.bgColor = ppu.output.bgColor;
 
 				if (video)
+				{
+					profiler.Begin( Profiler::RENDERER_BLIT );
 					renderer.Blit( *video, ppu.GetScreen(), ppu.GetBurstPhase() );
+					profiler.End( Profiler::RENDERER_BLIT );
+				}
 
 				cpu.EndFrame();
 
@@ -540,7 +590,9 @@ namespace Nes
 			{
 				static_cast<Nsf*>(image)->BeginFrame();
 
+				profiler.Begin( Profiler::CPU_EXECUTE_FRAME );
 				cpu.ExecuteFrame( sound );
+				profiler.End( Profiler::CPU_EXECUTE_FRAME );
 				cpu.EndFrame();
 
 				image->VSync();
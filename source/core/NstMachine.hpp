@@ -31,6 +31,7 @@
 #include "NstPpu.hpp"
 #include "NstTracker.hpp"
 #include "NstVideoRenderer.hpp"
+#include "api/NstApiCallbacks.hpp"
 
 #ifdef NST_PRAGMA_ONCE
 #pragma once
@@ -66,6 +67,57 @@ namespace Nes
 		{
 		public:
 
+			class Profiler
+			{
+			public:
+
+				enum Section
+				{
+					CPU_EXECUTE_FRAME,
+					PPU_END_FRAME,
+					RENDERER_BLIT,
+					NUM_SECTIONS
+				};
+
+				typedef void (NST_CALLBACK *Callback) (void*,Section,bool);
+
+			#ifdef NST_PROFILE
+
+				Profiler()
+				: callback(NULL), userdata(NULL) {}
+
+				void Set(Callback c,void* d)
+				{
+					callback = c;
+					userdata = d;
+				}
+
+				void Begin(Section section) const
+				{
+					if (callback)
+						callback( userdata, section, true );
+				}
+
+				void End(Section section) const
+				{
+					if (callback)
+						callback( userdata, section, false );
+				}
+
+			private:
+
+				Callback callback;
+				void* userdata;
+
+			#else
+
+				void Set(Callback,void*) {}
+				void Begin(Section) const {}
+				void End(Section) const {}
+
+			#endif
+			};
+
 			Machine();
 			~Machine();
 
@@ -101,6 +153,9 @@ namespace Nes
 			void   SwitchMode();
 			bool   LoadState(State::Loader&,bool);
 			void   SaveState(State::Saver&) const;
+			dword  SaveState(byte*,dword) const;
+			dword  GetStateSize() const;
+			dword  HashState() const;
 			void   InitializeInputDevices() const;
 			Result UpdateColorMode();
 			Result UpdateColorMode(ColorMode);
@@ -123,8 +178,10 @@ namespace Nes
 
 			uint state;
 			dword frame;
+			mutable dword stateSize;
 
 		public:
+			Api::Callbacks callbacks;
 			Cpu cpu;
 			Input::Adapter* extPort;
 			Input::Device* expPort;
@@ -135,6 +192,7 @@ namespace Nes
 			Tracker tracker;
 			Ppu ppu;
 			Video::Renderer renderer;
+			Profiler profiler;
 
 			uint Is(uint a) const
 			{
@@ -276,6 +276,11 @@ namespace Nes
 				return pages.mem[page];
 			}
 
+			byte* const* PagePointer(uint page) const
+			{
+				return pages.mem + page;
+			}
+
 			void Poke(uint address,uint data)
 			{
 				const uint page = address >> MEM_PAGE_SHIFT;
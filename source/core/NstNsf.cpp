@@ -30,7 +30,7 @@
 #include "board/NstBoardKonami.hpp"
 #include "board/NstBoardNamcot.hpp"
 #include "board/NstBoardSunsoft.hpp"
-#include "api/NstApiNsf.hpp"
+#include "api/NstApiCallbacks.hpp"
 #include "NstNsf.hpp"
 
 namespace Nes
@@ -578,7 +578,7 @@ namespace Nes
 						apu.ClearBuffers();
 					}
 
-					Api::Nsf::eventCallback( Api::Nsf::EVENT_SELECT_SONG );
+					cpu.GetCallbacks().nsfEvent.Active()( Api::Nsf::EVENT_SELECT_SONG );
 
 					return RESULT_OK;
 				}
@@ -596,7 +596,7 @@ namespace Nes
 				routine.nmi = Routine::NMI;
 				routine.playing = true;
 
-				Api::Nsf::eventCallback( Api::Nsf::EVENT_PLAY_SONG );
+				cpu.GetCallbacks().nsfEvent.Active()( Api::Nsf::EVENT_PLAY_SONG );
 
 				return RESULT_OK;
 			}
@@ -612,7 +612,7 @@ namespace Nes
 				routine.nmi = Routine::NMI;
 				apu.ClearBuffers();
 
-				Api::Nsf::eventCallback( Api::Nsf::EVENT_STOP_SONG );
+				cpu.GetCallbacks().nsfEvent.Active()( Api::Nsf::EVENT_STOP_SONG );
 
 				return RESULT_OK;
 			}
@@ -262,6 +262,8 @@ namespace Nes
 			oam.visible = oam.output;
 			oam.mask = 0;
 
+			std::memset( oam.line, 0, Oam::LINE_SIZE );
+
 			output.target = NULL;
 
 			hActiveHook.Unset();
@@ -340,12 +342,16 @@ namespace Nes
 			if (cycles.hClock == HCLOCK_BOOT)
 				state.Begin( AsciiId<'P','O','W'>::V ).Write8( 0x0 ).End();
 
+			if (cycles.reset)
+				state.Begin( AsciiId<'R','S','T'>::V ).Write32( cycles.reset ).End();
+
 			state.End();
 		}
 
 		void Ppu::LoadState(State::Loader& state)
 		{
 			cycles.hClock = HCLOCK_DUMMY;
+			cycles.reset = 0;
 			regs.frame = 0;
 			output.burstPhase = 0;
 
@@ -397,6 +403,11 @@ namespace Nes
 
 						cycles.hClock = HCLOCK_BOOT;
 						break;
+
+					case AsciiId<'R','S','T'>::V:
+
+						cycles.reset = state.Read32();
+						break;
 				}
 
 				state.End();
@@ -1165,7 +1176,7 @@ namespace Nes
 			dst[7] = src[1][3];
 		}
 
-		NST_SINGLE_CALL void Ppu::LoadTiles()
+		NST_FORCE_INLINE void Ppu::LoadTiles()
 		{
 			const byte* const NST_RESTRICT src[] =
 			{
@@ -1356,26 +1367,48 @@ namespace Nes
 					(pattern0 << 8 & 0x5500) | (pattern1 << 9 & 0xAA00)
 				);
 
-				Oam::Output* const NST_RESTRICT entry = oam.visible++;
+				byte pixels[8];
 
-				entry->pixels[( a^=6 )] = ( p       ) & 0x3;
-				entry->pixels[( a^=2 )] = ( p >>= 2 ) & 0x3;
-				entry->pixels[( a^=6 )] = ( p >>= 2 ) & 0x3;
-				entry->pixels[( a^=2 )] = ( p >>= 2 ) & 0x3;
-				entry->pixels[( a^=7 )] = ( p >>= 2 ) & 0x3;
-				entry->pixels[( a^=2 )] = ( p >>= 2 ) & 0x3;
-				entry->pixels[( a^=6 )] = ( p >>= 2 ) & 0x3;
-				entry->pixels[( a^=2 )] = ( p >>= 2 );
+				pixels[( a^=6 )] = ( p       ) & 0x3;
+				pixels[( a^=2 )] = ( p >>= 2 ) & 0x3;
+				pixels[( a^=6 )] = ( p >>= 2 ) & 0x3;
+				pixels[( a^=2 )] = ( p >>= 2 ) & 0x3;
+				pixels[( a^=7 )] = ( p >>= 2 ) & 0x3;
+				pixels[( a^=2 )] = ( p >>= 2 ) & 0x3;
+				pixels[( a^=6 )] = ( p >>= 2 ) & 0x3;
+				pixels[( a^=2 )] = ( p >>= 2 );
 
 				const uint attribute = buffer[2];
 
-				entry->x       = buffer[3];
-				entry->palette = Palette::SPRITE_OFFSET + ((attribute & Oam::COLOR) << 2);
-				entry->behind  = (attribute & Oam::BEHIND) ? 0x3 : 0x0;
-				entry->zero    = (buffer == oam.buffer && oam.spriteZeroInLine) ? 0x3 : 0x0;
+				const uint flags =
+				(
+					(Palette::SPRITE_OFFSET + ((attribute & Oam::COLOR) << 2)) |
+					((attribute & Oam::BEHIND) ? Oam::LINE_BEHIND : 0) |
+					((buffer == oam.buffer && oam.spriteZeroInLine) ? Oam::LINE_ZERO : 0)
+				);
+
+				// sprites come in priority order, so the first
+				// opaque pixel to land on a dot is the one shown
+
+				*oam.visible++ = buffer[3];
+				byte* const NST_RESTRICT line = oam.line + buffer[3];
+
+				for (uint i=0; i < 8; ++i)
+				{
+					if (pixels[i] && !line[i])
+						line[i] = flags | pixels[i];
+				}
 			}
 		}
 
+		NST_FORCE_INLINE void Ppu::ClearSprites()
+		{
+			for (const byte* NST_RESTRICT x=oam.output, *const end=oam.visible; x != end; ++x)
+				std::memset( oam.line + *x, 0, 8 );
+
+			oam.visible = oam.output;
+		}
+
 		void Ppu::LoadExtendedSprites()
 		{
 			const byte* NST_RESTRICT buffer = oam.buffer + (8*4);
@@ -1397,34 +1430,33 @@ namespace Nes
 			while (buffer != oam.buffered);
 		}
 
-		NST_FORCE_INLINE void Ppu::RenderPixel()
+		NST_FORCE_INLINE uint Ppu::MixSprites(const uint clock,uint pixel)
 		{
-			uint clock;
-			uint pixel = tiles.pixels[((clock=cycles.hClock++) + scroll.xFine) & 15] & tiles.mask;
+			const uint sprite = oam.line[clock] & oam.mask;
 
-			for (const Oam::Output* NST_RESTRICT sprite=oam.output, *const end=oam.visible; sprite != end; ++sprite)
+			if (sprite)
 			{
-				uint x = clock - sprite->x;
-
-				if (x > 7)
-					continue;
-
-				x = sprite->pixels[x] & oam.mask;
-
-				if (x)
+				if (pixel)
 				{
-					if (pixel & sprite->zero)
+					if (sprite & Oam::LINE_ZERO)
 						regs.status |= Regs::STATUS_SP_ZERO_HIT;
 
-					if (!(pixel & sprite->behind))
-						pixel = sprite->palette + x;
-
-					break;
+					if (sprite & Oam::LINE_BEHIND)
+						return pixel;
 				}
+
+				pixel = sprite & Oam::LINE_PIXEL;
 			}
 
+			return pixel;
+		}
+
+		NST_FORCE_INLINE void Ppu::RenderPixel()
+		{
+			const uint clock = cycles.hClock++;
+
 			Video::Screen::Pixel* const NST_RESTRICT target = output.target++;
-			*target = output.palette[pixel];
+			*target = output.palette[MixSprites( clock, tiles.pixels[(clock + scroll.xFine) & 15] & tiles.mask )];
 		}
 
 		NST_SINGLE_CALL void Ppu::RenderPixel255()
@@ -1432,26 +1464,85 @@ namespace Nes
 			cycles.hClock = 256;
 			uint pixel = tiles.pixels[(255 + scroll.xFine) & 15] & tiles.mask;
 
-			for (const Oam::Output* NST_RESTRICT sprite=oam.output, *const end=oam.visible; sprite != end; ++sprite)
+			if (const uint sprite = oam.line[255] & oam.mask)
 			{
-				uint x = 255U - sprite->x;
+				if (!(pixel && (sprite & Oam::LINE_BEHIND)))
+					pixel = sprite & Oam::LINE_PIXEL;
+			}
 
-				if (x > 7)
-					continue;
+			Video::Screen::Pixel* const NST_RESTRICT target = output.target++;
+			*target = output.palette[pixel];
+		}
+
+		NST_FORCE_INLINE void Ppu::RenderTile()
+		{
+			// Same fetches in the same order as the dot by dot path for one tile,
+			// with the clock stepped along for the address line and sprite evaluation.
+			// The pixels only depend on the tile loaded at its first dot and on
+			// sprites set up during the previous h-blank, so all 8 go out at once.
 
-				x = sprite->pixels[x] & oam.mask;
+			NST_ASSERT( cycles.hClock < 248 && !(cycles.hClock & 7) );
 
-				if (x)
-				{
-					if (!(pixel & sprite->behind))
-						pixel = sprite->palette + x;
+			const uint clock = cycles.hClock;
 
-					break;
-				}
+			LoadTiles();
+			EvaluateSpritesEven();
+			OpenName();
+			FetchName();
+			EvaluateSpritesOdd();
+
+			cycles.hClock = clock + 2;
+
+			EvaluateSpritesEven();
+			OpenAttribute();
+			FetchAttribute();
+			EvaluateSpritesOdd();
+			scroll.ClockX();
+
+			cycles.hClock = clock + 4;
+
+			EvaluateSpritesEven();
+			OpenPattern( io.pattern | 0x0 );
+			FetchBgPattern0();
+			EvaluateSpritesOdd();
+
+			cycles.hClock = clock + 6;
+
+			EvaluateSpritesEven();
+			OpenPattern( io.pattern | 0x8 );
+			FetchBgPattern1();
+			EvaluateSpritesOdd();
+
+			cycles.hClock = clock + 8;
+
+			const byte* const NST_RESTRICT src = tiles.pixels;
+			const uint fine = clock + scroll.xFine;
+			const uint mask = tiles.mask;
+
+			const Video::Screen::Pixel* const NST_RESTRICT palette = output.palette;
+			Video::Screen::Pixel* const NST_RESTRICT dst = output.target;
+			output.target += 8;
+
+			const byte* const NST_RESTRICT sprites = oam.line + clock;
+
+			if (!((sprites[0] | sprites[1] | sprites[2] | sprites[3] | sprites[4] | sprites[5] | sprites[6] | sprites[7]) & oam.mask))
+			{
+				dst[0] = palette[src[(fine + 0) & 15] & mask];
+				dst[1] = palette[src[(fine + 1) & 15] & mask];
+				dst[2] = palette[src[(fine + 2) & 15] & mask];
+				dst[3] = palette[src[(fine + 3) & 15] & mask];
+				dst[4] = palette[src[(fine + 4) & 15] & mask];
+				dst[5] = palette[src[(fine + 5) & 15] & mask];
+				dst[6] = palette[src[(fine + 6) & 15] & mask];
+				dst[7] = palette[src[(fine + 7) & 15] & mask];
+			}
+			else for (uint i=0; i < 8; ++i)
+			{
+				dst[i] = palette[MixSprites( clock + i, src[(fine + i) & 15] & mask )];
 			}
 
-			Video::Screen::Pixel* const NST_RESTRICT target = output.target++;
-			*target = output.palette[pixel];
+			tiles.mask = tiles.show[0];
+			oam.mask = oam.show[0];
 		}
 
 		NST_NO_INLINE void Ppu::Run()
@@ -1840,7 +1931,7 @@ namespace Nes
 					VBlank1:
 
 						regs.status = (regs.status & 0xFF) | (regs.status >> 1 & Regs::STATUS_VBLANK);
-						oam.visible = oam.output;
+						ClearSprites();
 						cycles.hClock = HCLOCK_VBLANK_2;
 
 						if (cycles.count <= HCLOCK_VBLANK_2)
@@ -1898,6 +1989,21 @@ namespace Nes
 					case 248:
 					HActive:
 
+						// the rest of the line goes through the batched path when nothing
+						// can look in on it before it's done, when the CPU is kept in step
+						// after every instruction it won't be long enough to be worth it
+
+						if (cycles.count > 255)
+						{
+							while (cycles.hClock < 248)
+							{
+								RenderTile();
+
+								if (cycles.hClock == 64)
+									goto HActive64;
+							}
+						}
+
 						LoadTiles();
 						EvaluateSpritesEven();
 						OpenName();
@@ -2199,6 +2305,7 @@ namespace Nes
 							goto HActive;
 
 					case 64:
+					HActive64:
 
 						NST_VERIFY( regs.oam == 0 );
 						oam.address = regs.oam & Oam::OFFSET_TO_0_1;
@@ -2231,7 +2338,7 @@ namespace Nes
 							hBlankHook.Execute();
 
 						scroll.ResetX();
-						oam.visible = oam.output;
+						ClearSprites();
 						cycles.hClock = 258;
 
 						if (cycles.count <= 258)
@@ -3118,7 +3225,7 @@ namespace Nes
 						if (hBlankHook)
 							hBlankHook.Execute();
 
-						oam.visible = oam.output;
+						ClearSprites();
 						cycles.hClock = 258;
 
 						if (cycles.count <= 258)
@@ -210,10 +210,13 @@ namespace Nes
 			NST_FORCE_INLINE uint OpenSprite() const;
 			NST_FORCE_INLINE uint OpenSprite(const byte* NST_RESTRICT) const;
 			NST_FORCE_INLINE  void LoadSprite(uint,uint,const byte* NST_RESTRICT);
+			NST_FORCE_INLINE void ClearSprites();
 			NST_SINGLE_CALL void PreLoadTiles();
-			NST_SINGLE_CALL void LoadTiles();
+			NST_FORCE_INLINE void LoadTiles();
+			NST_FORCE_INLINE uint MixSprites(uint,uint);
 			NST_FORCE_INLINE void RenderPixel();
 			NST_SINGLE_CALL void RenderPixel255();
+			NST_FORCE_INLINE void RenderTile();
 			NST_NO_INLINE void Run();
 
 			struct Regs
@@ -331,16 +334,11 @@ namespace Nes
 					Y_FLIP           = 0x80,
 					XFINE            = 0x07,
 					RANGE_MSB        = 0x08,
-					TILE_LSB         = 0x01
-				};
-
-				struct Output
-				{
-					byte x;
-					byte behind;
-					byte zero;
-					byte palette;
-					byte pixels[8];
+					TILE_LSB         = 0x01,
+					LINE_SIZE        = 256 + 8,
+					LINE_PIXEL       = 0x1F,
+					LINE_BEHIND      = 0x20,
+					LINE_ZERO        = 0x40
 				};
 
 				typedef void (Ppu::*Phase)();
@@ -349,7 +347,7 @@ namespace Nes
 				byte buffer[MAX_LINE_SPRITES * 4];
 
 				const byte* limit;
-				Output* visible;
+				byte* visible;
 				Phase phase;
 				uint latch;
 				uint index;
@@ -361,7 +359,8 @@ namespace Nes
 				bool spriteZeroInLine;
 				bool spriteLimit;
 
-				Output output[MAX_LINE_SPRITES];
+				byte output[MAX_LINE_SPRITES];
+				byte line[LINE_SIZE];
 			};
 
 			struct NameTable
@@ -32,6 +32,22 @@
 #include "NstAssert.hpp"
 #include "NstSha1.hpp"
 
+#if defined(NST_MM_INTRINSICS) && (NST_MSVC >= 1900 || NST_GCC >= 409)
+
+#define NST_SHA1_SHANI
+
+#include <immintrin.h>
+
+#if NST_MSVC
+#include <intrin.h>
+#define NST_SHANI_TARGET
+#else
+#include <cpuid.h>
+#define NST_SHANI_TARGET __attribute__((target("sse2,ssse3,sha")))
+#endif
+
+#endif
+
 namespace Nes
 {
 	namespace Core
@@ -46,7 +62,7 @@ namespace Nes
 			#define NST_R3(p,v,w,x,y,z,i) z = (z + (((w | x) & y) | (w & x)) + NST_BLK(p,i) + 0x8F1BBCDC + NST_ROL(v,5)) & 0xFFFFFFFF; w = NST_ROL(w,30)
 			#define NST_R4(p,v,w,x,y,z,i) z = (z + (w ^ x ^ y)               + NST_BLK(p,i) + 0xCA62C1D6 + NST_ROL(v,5)) & 0xFFFFFFFF; w = NST_ROL(w,30)
 
-			static void Transform(dword* const NST_RESTRICT state,const byte* const NST_RESTRICT buffer)
+			static void NST_CALL TransformBlock(dword* const NST_RESTRICT state,const byte* const NST_RESTRICT buffer)
 			{
 				dword p[16];
 
@@ -95,6 +111,135 @@ namespace Nes
 			#undef NST_R3
 			#undef NST_R4
 
+			static void NST_CALL TransformBlocks(dword* const NST_RESTRICT state,const byte* NST_RESTRICT buffer,dword blocks)
+			{
+				for (; blocks; buffer += 64, --blocks)
+					TransformBlock( state, buffer );
+			}
+
+		#ifdef NST_SHA1_SHANI
+
+			static bool CanUseShaNi()
+			{
+			#if NST_MSVC
+				int info[4];
+				__cpuid( info, 0 );
+
+				if (info[0] < 7)
+					return false;
+
+				__cpuid( info, 1 );
+
+				if (!(info[2] & 0x200))
+					return false;
+
+				__cpuidex( info, 7, 0 );
+				return info[1] & 0x20000000;
+			#else
+				uint a, b, c, d;
+
+				if (__get_cpuid_max( 0, NULL ) < 7 || !__get_cpuid( 1, &a, &b, &c, &d ) || !(c & bit_SSSE3))
+					return false;
+
+				__cpuid_count( 7, 0, a, b, c, d );
+				return b & 0x20000000;
+			#endif
+			}
+
+			// Four rounds with the message schedule of the rounds ahead interleaved,
+			// following Intel's reference code. The schedule for rounds past the end
+			// is computed needlessly on the last few steps, which keeps them uniform.
+
+			#define NST_SHANI_4(e0,e1,m0,m1,m2,m3,f)       \
+				e0 = _mm_sha1nexte_epu32( e0, m0 );        \
+				e1 = abcd;                                 \
+				m1 = _mm_sha1msg2_epu32( m1, m0 );         \
+				abcd = _mm_sha1rnds4_epu32( abcd, e0, f ); \
+				m3 = _mm_sha1msg1_epu32( m3, m0 );         \
+				m2 = _mm_xor_si128( m2, m0 )
+
+			NST_SHANI_TARGET
+			static void NST_CALL TransformShaNi(dword* const NST_RESTRICT state,const byte* NST_RESTRICT buffer,dword blocks)
+			{
+				const __m128i order = _mm_set_epi8( 0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15 );
+
+				__m128i abcd = _mm_shuffle_epi32( _mm_loadu_si128( reinterpret_cast<const __m128i*>(state) ), 0x1B );
+				__m128i e0 = _mm_set_epi32( state[4], 0, 0, 0 );
+
+				for (; blocks; buffer += 64, --blocks)
+				{
+					const __m128i abcdSave = abcd;
+					const __m128i eSave = e0;
+
+					__m128i e1;
+					__m128i m0 = _mm_shuffle_epi8( _mm_loadu_si128( reinterpret_cast<const __m128i*>(buffer + 0x00) ), order );
+					__m128i m1 = _mm_shuffle_epi8( _mm_loadu_si128( reinterpret_cast<const __m128i*>(buffer + 0x10) ), order );
+					__m128i m2 = _mm_shuffle_epi8( _mm_loadu_si128( reinterpret_cast<const __m128i*>(buffer + 0x20) ), order );
+					__m128i m3 = _mm_shuffle_epi8( _mm_loadu_si128( reinterpret_cast<const __m128i*>(buffer + 0x30) ), order );
+
+					e0 = _mm_add_epi32( e0, m0 );
+					e1 = abcd;
+					abcd = _mm_sha1rnds4_epu32( abcd, e0, 0 );
+
+					e1 = _mm_sha1nexte_epu32( e1, m1 );
+					e0 = abcd;
+					abcd = _mm_sha1rnds4_epu32( abcd, e1, 0 );
+					m0 = _mm_sha1msg1_epu32( m0, m1 );
+
+					e0 = _mm_sha1nexte_epu32( e0, m2 );
+					e1 = abcd;
+					abcd = _mm_sha1rnds4_epu32( abcd, e0, 0 );
+					m1 = _mm_sha1msg1_epu32( m1, m2 );
+					m0 = _mm_xor_si128( m0, m2 );
+
+					NST_SHANI_4( e1, e0, m3, m0, m1, m2, 0 );
+					NST_SHANI_4( e0, e1, m0, m1, m2, m3, 0 );
+					NST_SHANI_4( e1, e0, m1, m2, m3, m0, 1 );
+					NST_SHANI_4( e0, e1, m2, m3, m0, m1, 1 );
+					NST_SHANI_4( e1, e0, m3, m0, m1, m2, 1 );
+					NST_SHANI_4( e0, e1, m0, m1, m2, m3, 1 );
+					NST_SHANI_4( e1, e0, m1, m2, m3, m0, 1 );
+					NST_SHANI_4( e0, e1, m2, m3, m0, m1, 2 );
+					NST_SHANI_4( e1, e0, m3, m0, m1, m2, 2 );
+					NST_SHANI_4( e0, e1, m0, m1, m2, m3, 2 );
+					NST_SHANI_4( e1, e0, m1, m2, m3, m0, 2 );
+					NST_SHANI_4( e0, e1, m2, m3, m0, m1, 2 );
+					NST_SHANI_4( e1, e0, m3, m0, m1, m2, 3 );
+					NST_SHANI_4( e0, e1, m0, m1, m2, m3, 3 );
+					NST_SHANI_4( e1, e0, m1, m2, m3, m0, 3 );
+					NST_SHANI_4( e0, e1, m2, m3, m0, m1, 3 );
+					NST_SHANI_4( e1, e0, m3, m0, m1, m2, 3 );
+
+					e0 = _mm_sha1nexte_epu32( e0, eSave );
+					abcd = _mm_add_epi32( abcd, abcdSave );
+				}
+
+				_mm_storeu_si128( reinterpret_cast<__m128i*>(state), _mm_shuffle_epi32( abcd, 0x1B ) );
+				state[4] = _mm_cvtsi128_si32( _mm_srli_si128( e0, 12 ) );
+			}
+
+			#undef NST_SHANI_4
+
+		#endif
+
+			typedef void (NST_CALL *Transformer)(dword* NST_RESTRICT,const byte* NST_RESTRICT,dword);
+
+			static Transformer GetTransformer()
+			{
+			#ifdef NST_SHA1_SHANI
+				if (CanUseShaNi())
+					return TransformShaNi;
+			#endif
+
+				return TransformBlocks;
+			}
+
+			static void Transform(dword* const NST_RESTRICT state,const byte* const NST_RESTRICT buffer,const dword blocks)
+			{
+				static const Transformer transformer = GetTransformer();
+				transformer( state, buffer, blocks );
+			}
+
 			void NST_CALL Compute(Key& key,const byte* data,dword length)
 			{
 				if (length)
@@ -160,10 +305,10 @@ namespace Nes
 					i = 64 - j;
 
 					std::memcpy( buffer+j, data, i );
-					Transform( state, buffer );
+					Transform( state, buffer, 1 );
 
-					for (; i + 63 < length; i += 64)
-						Transform( state, data+i );
+					Transform( state, data+i, (length-i) / 64 );
+					i += (length-i) & ~dword(63);
 
 					j = 0;
 				}
@@ -197,10 +342,7 @@ namespace Nes
 				end[page+62] = count >> (8  - 3) & 0xFF;
 				end[page+63] = count << (     3) & 0xFF;
 
-				Transform( final, end );
-
-				if (page)
-					Transform( final, end+64 );
+				Transform( final, end, page ? 2 : 1 );
 			}
 
 			Key::Digest Key::GetDigest() const
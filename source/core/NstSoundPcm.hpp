@@ -49,6 +49,8 @@ namespace Nes
 
 				void Play(const iword*,dword,dword);
 
+				using Apu::Channel::GetCallbacks;
+
 			private:
 
 				void Reset();
@@ -26,7 +26,7 @@
 #include "NstCpu.hpp"
 #include "NstChips.hpp"
 #include "NstSoundPlayer.hpp"
-#include "api/NstApiUser.hpp"
+#include "api/NstApiCallbacks.hpp"
 
 namespace Nes
 {
@@ -195,7 +195,7 @@ namespace Nes
 
 							try
 							{
-								Api::User::fileIoCallback( loader );
+								player->GetCallbacks().userFileIo.Active()( loader );
 							}
 							catch (...)
 							{
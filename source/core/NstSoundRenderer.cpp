@@ -22,7 +22,9 @@
 //
 ////////////////////////////////////////////////////////////////////////////////////////
 
+#include <cmath>
 #include <algorithm>
+#include <cstring>
 #include "NstCpu.hpp"
 #include "NstSoundRenderer.hpp"
 
@@ -58,9 +60,117 @@ namespace Nes
 					std::fill( output, output+SIZE, iword(0) );
 			}
 
+			const StepBuffer::Kernel StepBuffer::kernel;
+
+			StepBuffer::Kernel::Kernel()
+			{
+				// Blackman windowed sinc, one set of taps per sub-sample phase. Every
+				// set sums up to exactly one step so that the integrated output can't drift.
+
+				const double pi = 3.141592653589793;
+				const double cutoff = 0.9;
+
+				for (uint phase=0; phase < PHASES; ++phase)
+				{
+					double impulse[WIDTH];
+					double sum = 0;
+
+					for (uint i=0; i < WIDTH; ++i)
+					{
+						const double x = double(int(i) - int(WIDTH/2) + 1) - double(phase) / PHASES;
+						const double window = 0.42 + 0.5 * std::cos( pi * x / (WIDTH/2) ) + 0.08 * std::cos( 2 * pi * x / (WIDTH/2) );
+
+						impulse[i] = (x == 0 ? cutoff : std::sin( pi * cutoff * x ) / (pi * x)) * window;
+						sum += impulse[i];
+					}
+
+					int total = 0;
+
+					for (uint i=0; i < WIDTH; ++i)
+					{
+						const double tap = impulse[i] * (1UL << KERNEL_BITS) / sum;
+						taps[phase][i] = iword(tap < 0 ? tap - 0.5 : tap + 0.5);
+						total += taps[phase][i];
+					}
+
+					taps[phase][WIDTH/2] += iword(int(1UL << KERNEL_BITS) - total);
+				}
+			}
+
+			StepBuffer::StepBuffer()
+			: buffer(new idword [SIZE+WIDTH])
+			{
+				Reset( 1, 0 );
+			}
+
+			StepBuffer::~StepBuffer()
+			{
+				delete [] buffer;
+			}
+
+			void StepBuffer::Reset(const dword rate,const Cycle clock)
+			{
+				NST_ASSERT( rate );
+
+				factor = ((qaword(1) << FRACTION_BITS) + rate / 2) / rate;
+				offset = qaword(0) - clock * factor;
+				read = 0;
+				level = 0;
+				integrator = 0;
+
+				std::fill( buffer, buffer+SIZE+WIDTH, idword(0) );
+			}
+
 			#ifdef NST_MSVC_OPTIMIZE
 			#pragma optimize("", on)
 			#endif
+
+			uint StepBuffer::Available(const Cycle clock) const
+			{
+				return dword((offset + clock * factor) >> FRACTION_BITS) - read;
+			}
+
+			Cycle StepBuffer::Required(const uint count) const
+			{
+				return ((qaword(read + count) << FRACTION_BITS) - offset + factor - 1) / factor;
+			}
+
+			void StepBuffer::SetRate(const dword rate,const Cycle clock)
+			{
+				NST_ASSERT( rate );
+
+				// rescale around the current position so that no step moves
+
+				const qaword prev = factor;
+				factor = ((qaword(1) << FRACTION_BITS) + rate / 2) / rate;
+				offset += clock * prev - clock * factor;
+			}
+
+			void StepBuffer::EndFrame(const Cycle frame,const Cycle clock)
+			{
+				uint available = Available( clock );
+
+				if (available > LIMIT)
+				{
+					for (uint skip=available-LIMIT; skip; --skip)
+						integrator += buffer[read++];
+
+					available = LIMIT;
+				}
+
+				if (read)
+				{
+					const uint length = available + WIDTH;
+
+					std::memmove( buffer, buffer + read, sizeof(idword) * length );
+					std::fill( buffer + length, buffer + length + read, idword(0) );
+
+					offset -= qaword(read) << FRACTION_BITS;
+					read = 0;
+				}
+
+				offset += frame * factor;
+			}
 		}
 	}
 }
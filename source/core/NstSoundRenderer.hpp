@@ -61,6 +61,7 @@ namespace Nes
 
 				void Reset(uint,bool=true);
 				void operator >> (Block&);
+				inline uint Length() const;
 
 				template<typename,uint>
 				class Renderer;
@@ -157,6 +158,57 @@ namespace Nes
 				inline void operator << (Sample);
 				NST_FORCE_INLINE bool operator << (Block&);
 			};
+
+			class StepBuffer
+			{
+			public:
+
+				StepBuffer();
+				~StepBuffer();
+
+				enum
+				{
+					SIZE = 0x8000,
+					LIMIT = Buffer::SIZE
+				};
+
+				void  Reset(dword,Cycle);
+				void  EndFrame(Cycle,Cycle);
+				uint  Available(Cycle) const;
+				Cycle Required(uint) const;
+
+				inline void Update(Cycle,idword);
+				inline Sample Read();
+				inline Sample Hold() const;
+				void SetRate(dword,Cycle);
+
+			private:
+
+				enum
+				{
+					WIDTH = 16,
+					PHASE_BITS = 6,
+					PHASES = 1U << PHASE_BITS,
+					KERNEL_BITS = 13,
+					FRACTION_BITS = 32
+				};
+
+				struct Kernel
+				{
+					Kernel();
+
+					iword taps[PHASES][WIDTH];
+				};
+
+				static const Kernel kernel;
+
+				qaword offset;
+				qaword factor;
+				uint read;
+				idword level;
+				idword integrator;
+				idword* const NST_RESTRICT buffer;
+			};
 		}
 	}
 }
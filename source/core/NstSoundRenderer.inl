@@ -49,6 +49,11 @@ namespace Nes
 				}
 			}
 
+			inline uint Buffer::Length() const
+			{
+				return (dword(pos) + SIZE - start) & MASK;
+			}
+
 			inline Buffer::Block::Block(uint l)
 			: length(l) {}
 
@@ -180,6 +185,39 @@ namespace Nes
 
 				return dst != end;
 			}
+
+			inline void StepBuffer::Update(const Cycle clock,const idword amplitude)
+			{
+				if (const idword delta = amplitude - level)
+				{
+					level = amplitude;
+
+					const qaword pos = offset + clock * factor;
+					const dword index = dword(pos >> FRACTION_BITS);
+
+					NST_VERIFY( index < SIZE );
+
+					if (index < SIZE)
+					{
+						const iword* const NST_RESTRICT taps = kernel.taps[dword(pos >> (FRACTION_BITS-PHASE_BITS)) & (PHASES-1)];
+						idword* const NST_RESTRICT dst = buffer + index;
+
+						for (uint i=0; i < WIDTH; ++i)
+							dst[i] += taps[i] * delta;
+					}
+				}
+			}
+
+			inline Sample StepBuffer::Read()
+			{
+				integrator += buffer[read++];
+				return signed_shr( integrator, KERNEL_BITS );
+			}
+
+			inline Sample StepBuffer::Hold() const
+			{
+				return signed_shr( integrator, KERNEL_BITS );
+			}
 		}
 	}
 }
@@ -57,6 +57,27 @@ namespace Nes
 				}
 			}
 
+			Saver::Saver(byte* mem,dword capacity)
+			: stream(mem,capacity), chunks(CHUNK_RESERVE), useCompression(false), internal(false)
+			{
+				chunks.SetTo(1);
+				chunks.Front() = 0;
+			}
+
+			Saver::Saver(Vector<byte>& vector,bool i)
+			: stream(vector), chunks(CHUNK_RESERVE), useCompression(false), internal(i)
+			{
+				chunks.SetTo(1);
+				chunks.Front() = 0;
+			}
+
+			Saver::Saver(dword& crc)
+			: stream(crc), chunks(CHUNK_RESERVE), useCompression(false), internal(false)
+			{
+				chunks.SetTo(1);
+				chunks.Front() = 0;
+			}
+
 			Saver::~Saver()
 			{
 				NST_VERIFY( chunks.Size() == 1 );
@@ -158,6 +179,12 @@ namespace Nes
 				chunks.SetTo(0);
 			}
 
+			Loader::Loader(const byte* mem,dword length,bool c)
+			: stream(mem,length), chunks(CHUNK_RESERVE), checkCrc(c)
+			{
+				chunks.SetTo(0);
+			}
+
 			Loader::~Loader()
 			{
 				NST_VERIFY( chunks.Size() <= 1 );
@@ -213,6 +240,19 @@ namespace Nes
 					stream.Seek( back );
 			}
 
+			void Loader::Seek(dword length)
+			{
+				NST_ASSERT( chunks.Size() );
+
+				// back or forth to where the open chunk had this many bytes left
+
+				if (const idword distance = idword(chunks.Back()) - idword(length))
+				{
+					stream.Seek( distance );
+					chunks.Back() = length;
+				}
+			}
+
 			void Loader::CheckRead(dword length)
 			{
 				if (chunks.Back() >= length)
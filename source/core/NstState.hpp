@@ -46,6 +46,9 @@ namespace Nes
 			public:
 
 				Saver(StdStream,bool,bool,dword=0);
+				Saver(byte*,dword);
+				Saver(Vector<byte>&,bool);
+				explicit Saver(dword&);
 				~Saver();
 
 				Saver& Begin(dword);
@@ -92,6 +95,16 @@ namespace Nes
 				{
 					return internal;
 				}
+
+				dword Size() const
+				{
+					return stream.Size();
+				}
+
+				dword Length() const
+				{
+					return chunks.Back();
+				}
 			};
 
 			class Loader
@@ -99,6 +112,7 @@ namespace Nes
 			public:
 
 				Loader(StdStream,bool);
+				Loader(const byte*,dword,bool);
 				~Loader();
 
 				dword Begin();
@@ -112,6 +126,7 @@ namespace Nes
 				void  Uncompress(byte*,dword);
 				void  End();
 				void  End(dword);
+				void  Seek(dword);
 
 				template<uint N>
 				class Data
@@ -22,8 +22,10 @@
 //
 ////////////////////////////////////////////////////////////////////////////////////////
 
+#include <cstring>
 #include <iostream>
 #include "NstVector.hpp"
+#include "NstCrc32.hpp"
 #include "NstStream.hpp"
 
 namespace Nes
@@ -34,6 +36,9 @@ namespace Nes
 		{
 			void In::Clear()
 			{
+				if (!stream)
+					return;
+
 				std::istream& ref = *static_cast<std::istream*>(stream);
 
 				if (!ref.bad())
@@ -49,6 +54,16 @@ namespace Nes
 			{
 				NST_ASSERT( data && size );
 
+				if (!stream)
+				{
+					if (length - pos < size)
+						throw RESULT_ERR_CORRUPT_FILE;
+
+					std::memcpy( data, mem + pos, size );
+					pos += size;
+					return;
+				}
+
 				SafeRead( data, size );
 
 				if (!*static_cast<std::istream*>(stream))
@@ -90,6 +105,9 @@ namespace Nes
 
 			uint In::SafeRead8()
 			{
+				if (!stream)
+					return pos < length ? mem[pos++] : ~0U;
+
 				byte data;
 				SafeRead( &data, 1 );
 				return *static_cast<std::istream*>(stream) ? data : ~0U;
@@ -101,6 +119,15 @@ namespace Nes
 
 			void In::Seek(idword distance)
 			{
+				if (!stream)
+				{
+					if (distance < 0 ? dword(-distance) > pos : dword(distance) > length - pos)
+						throw RESULT_ERR_CORRUPT_FILE;
+
+					pos += distance;
+					return;
+				}
+
 				Clear();
 
 				if (!static_cast<std::istream*>(stream)->seekg( distance, std::ios::cur ))
@@ -109,6 +136,9 @@ namespace Nes
 
 			ulong In::Length()
 			{
+				if (!stream)
+					return length - pos;
+
 				Clear();
 
 				std::istream& ref = *static_cast<std::istream*>(stream);
@@ -281,6 +311,9 @@ namespace Nes
 
 			bool In::Eof()
 			{
+				if (!stream)
+					return pos == length;
+
 				std::istream& ref = *static_cast<std::istream*>(stream);
 				return ref.eof() || (ref.peek(), ref.eof());
 			}
@@ -289,6 +322,40 @@ namespace Nes
 			{
 				NST_VERIFY( data && size );
 
+				if (!stream)
+				{
+					if (mem)
+					{
+						if (capacity - pos < size)
+							throw RESULT_ERR_OUT_OF_MEMORY;
+
+						std::memcpy( mem + pos, data, size );
+					}
+					else if (vector)
+					{
+						if (pos == vector->Size())
+						{
+							vector->Append( data, size );
+						}
+						else
+						{
+							NST_ASSERT( pos + size <= vector->Size() );
+							std::memcpy( vector->Begin() + pos, data, size );
+						}
+					}
+					else if (crc)
+					{
+						*crc = Crc32::Compute( data, size, *crc );
+					}
+
+					pos += size;
+
+					if (top < pos)
+						top = pos;
+
+					return;
+				}
+
 				if (!static_cast<std::ostream*>(stream)->write( reinterpret_cast<const char*>(data), size ))
 					throw RESULT_ERR_CORRUPT_FILE;
 			}
@@ -352,6 +419,9 @@ namespace Nes
 
 			void Out::Clear()
 			{
+				if (!stream)
+					return;
+
 				std::ostream& ref = *static_cast<std::ostream*>(stream);
 
 				if (!ref.bad())
@@ -360,6 +430,15 @@ namespace Nes
 
 			void Out::Seek(idword distance)
 			{
+				if (!stream)
+				{
+					if (distance < 0 ? dword(-distance) > pos : dword(distance) > top - pos)
+						throw RESULT_ERR_CORRUPT_FILE;
+
+					pos += distance;
+					return;
+				}
+
 				Clear();
 
 				if (!static_cast<std::ostream*>(stream)->seekp( distance, std::ios::cur ))
@@ -368,6 +447,13 @@ namespace Nes
 
 			bool Out::SeekEnd()
 			{
+				if (!stream)
+				{
+					const bool advanced = (pos != top);
+					pos = top;
+					return advanced;
+				}
+
 				Clear();
 
 				std::ostream& ref = *static_cast<std::ostream*>(stream);
@@ -47,6 +47,9 @@ namespace Nes
 			class In
 			{
 				StdStream const stream;
+				const byte* const mem;
+				dword pos;
+				const dword length;
 
 				void SafeRead(byte*,dword);
 				void Clear();
@@ -54,11 +57,17 @@ namespace Nes
 			public:
 
 				explicit In(StdStream s)
-				: stream(s)
+				: stream(s), mem(NULL), pos(0), length(0)
 				{
 					NST_ASSERT( stream );
 				}
 
+				In(const byte* m,dword l)
+				: stream(NULL), mem(m), pos(0), length(l)
+				{
+					NST_ASSERT( mem );
+				}
+
 				static dword AsciiToC(char* NST_RESTRICT,const byte* NST_RESTRICT,dword);
 
 				void  Read(byte*,dword);
@@ -98,17 +107,43 @@ namespace Nes
 			class Out
 			{
 				StdStream const stream;
+				byte* const mem;
+				Vector<byte>* const vector;
+				dword* const crc;
+				dword pos;
+				dword top;
+				const dword capacity;
 
 				void Clear();
 
 			public:
 
 				explicit Out(StdStream s)
-				: stream(s)
+				: stream(s), mem(NULL), vector(NULL), crc(NULL), pos(0), top(0), capacity(0)
 				{
 					NST_ASSERT( stream );
 				}
 
+				// memory backed, only counts the written size if NULL
+
+				Out(byte* m,dword c)
+				: stream(NULL), mem(m), vector(NULL), crc(NULL), pos(0), top(0), capacity(c) {}
+
+				// memory backed, appends to the vector
+
+				explicit Out(Vector<byte>& v)
+				: stream(NULL), mem(NULL), vector(&v), crc(NULL), pos(0), top(0), capacity(0) {}
+
+				// folds everything written into a running CRC, nothing is stored
+
+				explicit Out(dword& c)
+				: stream(NULL), mem(NULL), vector(NULL), crc(&c), pos(0), top(0), capacity(0) {}
+
+				dword Size() const
+				{
+					return top;
+				}
+
 				void Write(const byte*,dword);
 				void Write8(uint);
 				void Write16(uint);
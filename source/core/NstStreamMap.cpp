@@ -0,0 +1,252 @@
+////////////////////////////////////////////////////////////////////////////////////////
+//
+// Nestopia - NES/Famicom emulator written in C++
+//
+// Copyright (C) 2003-2008 Martin Freij
+//
+// This file is part of Nestopia.
+//
+// Nestopia is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// Nestopia is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Nestopia; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+////////////////////////////////////////////////////////////////////////////////////////
+
+#include "NstCore.hpp"
+
+#ifndef NST_NO_MMAP
+#if defined(NST_WIN32)
+#define NST_MAP_WIN32
+#elif defined(__unix__) || defined(__APPLE__)
+#define NST_MAP_POSIX
+#endif
+#endif
+
+#if defined(NST_MAP_WIN32)
+#include <windows.h>
+#elif defined(NST_MAP_POSIX)
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#else
+#include <cstdio>
+#include <new>
+#endif
+
+#include "NstAssert.hpp"
+#include "NstStreamMap.hpp"
+
+namespace Nes
+{
+	namespace Core
+	{
+		namespace Stream
+		{
+			#ifdef NST_MSVC_OPTIMIZE
+			#pragma optimize("s", on)
+			#endif
+
+			MemoryBuffer::MemoryBuffer(const void* mem,ulong length)
+			{
+				char* const begin = const_cast<char*>(static_cast<const char*>(mem));
+				setg( begin, begin, begin + (begin ? length : 0) );
+			}
+
+			MemoryBuffer::pos_type MemoryBuffer::seekoff(off_type offset,std::ios_base::seekdir dir,std::ios_base::openmode mode)
+			{
+				if (!(mode & std::ios_base::in))
+					return pos_type(off_type(-1));
+
+				char* base;
+
+				switch (dir)
+				{
+					case std::ios_base::beg: base = eback(); break;
+					case std::ios_base::cur: base = gptr();  break;
+					case std::ios_base::end: base = egptr(); break;
+					default: return pos_type(off_type(-1));
+				}
+
+				if (offset < eback() - base || offset > egptr() - base)
+					return pos_type(off_type(-1));
+
+				setg( eback(), base + offset, egptr() );
+
+				return pos_type(off_type(gptr() - eback()));
+			}
+
+			MemoryBuffer::pos_type MemoryBuffer::seekpos(pos_type pos,std::ios_base::openmode mode)
+			{
+				return seekoff( off_type(pos), std::ios_base::beg, mode );
+			}
+
+			std::streamsize MemoryBuffer::showmanyc()
+			{
+				return egptr() - gptr();
+			}
+
+			MemoryIn::MemoryIn(const void* mem,ulong length)
+			:
+			MemoryBuffer (mem,length),
+			std::istream (static_cast<MemoryBuffer*>(this))
+			{}
+
+			FileMap::FileMap(const char* path)
+			: data(NULL), size(0), handle(NULL)
+			{
+				NST_ASSERT( path );
+
+				#if defined(NST_MAP_WIN32)
+
+				const HANDLE file = ::CreateFileA( path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL );
+
+				if (file == INVALID_HANDLE_VALUE)
+					throw RESULT_ERR_CORRUPT_FILE;
+
+				LARGE_INTEGER length;
+
+				if (!::GetFileSizeEx( file, &length ) || length.HighPart)
+				{
+					::CloseHandle( file );
+					throw RESULT_ERR_CORRUPT_FILE;
+				}
+
+				if (length.LowPart)
+				{
+					handle = ::CreateFileMappingA( file, NULL, PAGE_READONLY, 0, 0, NULL );
+					::CloseHandle( file );
+
+					if (!handle)
+						throw RESULT_ERR_OUT_OF_MEMORY;
+
+					data = static_cast<const byte*>(::MapViewOfFile( handle, FILE_MAP_READ, 0, 0, 0 ));
+
+					if (!data)
+					{
+						::CloseHandle( handle );
+						throw RESULT_ERR_OUT_OF_MEMORY;
+					}
+
+					size = length.LowPart;
+				}
+				else
+				{
+					::CloseHandle( file );
+				}
+
+				#elif defined(NST_MAP_POSIX)
+
+				const int file = ::open( path, O_RDONLY );
+
+				if (file < 0)
+					throw RESULT_ERR_CORRUPT_FILE;
+
+				struct stat st;
+
+				if (::fstat( file, &st ) || st.st_size < 0 || qaword(st.st_size) > 0xFFFFFFFF)
+				{
+					::close( file );
+					throw RESULT_ERR_CORRUPT_FILE;
+				}
+
+				if (st.st_size)
+				{
+					void* const map = ::mmap( NULL, st.st_size, PROT_READ, MAP_PRIVATE, file, 0 );
+					::close( file );
+
+					if (map == MAP_FAILED)
+						throw RESULT_ERR_OUT_OF_MEMORY;
+
+					data = static_cast<const byte*>(map);
+					size = st.st_size;
+				}
+				else
+				{
+					::close( file );
+				}
+
+				#else
+
+				// no mapping available, read it in one go instead
+
+				std::FILE* const file = std::fopen( path, "rb" );
+
+				if (!file)
+					throw RESULT_ERR_CORRUPT_FILE;
+
+				long length = -1;
+
+				if (!std::fseek( file, 0, SEEK_END ))
+					length = std::ftell( file );
+
+				if (length < 0 || std::fseek( file, 0, SEEK_SET ))
+				{
+					std::fclose( file );
+					throw RESULT_ERR_CORRUPT_FILE;
+				}
+
+				if (length)
+				{
+					byte* const buffer = new (std::nothrow) byte [length];
+
+					if (!buffer)
+					{
+						std::fclose( file );
+						throw RESULT_ERR_OUT_OF_MEMORY;
+					}
+
+					if (std::fread( buffer, 1, length, file ) != ulong(length))
+					{
+						delete [] buffer;
+						std::fclose( file );
+						throw RESULT_ERR_CORRUPT_FILE;
+					}
+
+					data = buffer;
+					size = length;
+				}
+
+				std::fclose( file );
+
+				#endif
+			}
+
+			FileMap::~FileMap()
+			{
+				#if defined(NST_MAP_WIN32)
+
+				if (data)
+				{
+					::UnmapViewOfFile( data );
+					::CloseHandle( handle );
+				}
+
+				#elif defined(NST_MAP_POSIX)
+
+				if (data)
+					::munmap( const_cast<byte*>(data), size );
+
+				#else
+
+				delete [] data;
+
+				#endif
+			}
+
+			#ifdef NST_MSVC_OPTIMIZE
+			#pragma optimize("", on)
+			#endif
+		}
+	}
+}
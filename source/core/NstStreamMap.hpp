@@ -0,0 +1,89 @@
+////////////////////////////////////////////////////////////////////////////////////////
+//
+// Nestopia - NES/Famicom emulator written in C++
+//
+// Copyright (C) 2003-2008 Martin Freij
+//
+// This file is part of Nestopia.
+//
+// Nestopia is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// Nestopia is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Nestopia; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef NST_STREAMMAP_H
+#define NST_STREAMMAP_H
+
+#include <istream>
+
+#ifdef NST_PRAGMA_ONCE
+#pragma once
+#endif
+
+namespace Nes
+{
+	namespace Core
+	{
+		namespace Stream
+		{
+			class MemoryBuffer : public std::streambuf
+			{
+			public:
+
+				MemoryBuffer(const void*,ulong);
+
+			protected:
+
+				pos_type seekoff(off_type,std::ios_base::seekdir,std::ios_base::openmode);
+				pos_type seekpos(pos_type,std::ios_base::openmode);
+				std::streamsize showmanyc();
+			};
+
+			class MemoryIn : private MemoryBuffer, public std::istream
+			{
+			public:
+
+				MemoryIn(const void*,ulong);
+			};
+
+			class FileMap
+			{
+			public:
+
+				explicit FileMap(const char*);
+				~FileMap();
+
+			private:
+
+				const byte* data;
+				ulong size;
+				void* handle;
+
+			public:
+
+				const byte* Data() const
+				{
+					return data;
+				}
+
+				ulong Size() const
+				{
+					return size;
+				}
+			};
+		}
+	}
+}
+
+#endif
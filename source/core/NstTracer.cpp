@@ -0,0 +1,196 @@
+////////////////////////////////////////////////////////////////////////////////////////
+//
+// Nestopia - NES/Famicom emulator written in C++
+//
+// Copyright (C) 2003-2008 Martin Freij
+//
+// This file is part of Nestopia.
+//
+// Nestopia is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// Nestopia is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Nestopia; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+////////////////////////////////////////////////////////////////////////////////////////
+
+#include "NstCore.hpp"
+
+#ifdef NST_TRACE
+
+#include <cstdio>
+#include <cstring>
+#include <ostream>
+#include "NstAssert.hpp"
+#include "NstTracer.hpp"
+
+namespace Nes
+{
+	namespace Core
+	{
+		#ifdef NST_MSVC_OPTIMIZE
+		#pragma optimize("s", on)
+		#endif
+
+		Tracer::Tracer()
+		:
+		entries     (NULL),
+		capacity    (0),
+		pos         (0),
+		wrapped     (false),
+		frame       (0),
+		cycle       (0),
+		breakpoints (NULL)
+		{}
+
+		Tracer::~Tracer()
+		{
+			delete [] entries;
+			delete [] breakpoints;
+		}
+
+		void Tracer::Enable(const dword size)
+		{
+			NST_ASSERT( size );
+
+			if (capacity != size)
+			{
+				Entry* const next = new Entry [size];
+				delete [] entries;
+				entries = next;
+				capacity = size;
+			}
+
+			Clear();
+		}
+
+		void Tracer::Disable()
+		{
+			delete [] entries;
+			entries = NULL;
+			capacity = 0;
+
+			Clear();
+		}
+
+		void Tracer::Clear()
+		{
+			pos = 0;
+			wrapped = false;
+			frame = 0;
+			cycle = 0;
+		}
+
+		void Tracer::SetBreakpoint(const uint address,const bool state)
+		{
+			NST_ASSERT( address <= 0xFFFF );
+
+			if (!breakpoints)
+			{
+				if (!state)
+					return;
+
+				breakpoints = new byte [0x10000 / 8];
+				std::memset( breakpoints, 0, 0x10000 / 8 );
+			}
+
+			if (state)
+				breakpoints[address >> 3] |= 1U << (address & 7);
+			else
+				breakpoints[address >> 3] &= ~(1U << (address & 7));
+		}
+
+		void Tracer::ClearBreakpoints()
+		{
+			delete [] breakpoints;
+			breakpoints = NULL;
+		}
+
+		dword Tracer::Read(Entry* output,dword count) const
+		{
+			const dword size = Size();
+
+			if (count > size)
+				count = size;
+
+			// oldest of the last 'count' entries
+
+			dword i = (wrapped ? pos + capacity : pos) - count;
+
+			for (dword n=count; n; --n)
+			{
+				if (i >= capacity)
+					i -= capacity;
+
+				*output++ = entries[i++];
+			}
+
+			return count;
+		}
+
+		void Tracer::Dump(std::ostream& stream) const
+		{
+			dword i = wrapped ? pos : 0;
+
+			for (dword n=Size(); n; --n)
+			{
+				if (i == capacity)
+					i = 0;
+
+				const Entry& entry = entries[i++];
+
+				char line[64];
+
+				if (entry.type == Entry::INSTRUCTION)
+				{
+					std::sprintf
+					(
+						line,
+						"%8lu %5u  %04X  %02X  A:%02X X:%02X Y:%02X P:%02X SP:%02X\n",
+						ulong(entry.frame),
+						uint(entry.cycle),
+						uint(entry.address),
+						uint(entry.data),
+						uint(entry.a),
+						uint(entry.x),
+						uint(entry.y),
+						uint(entry.p),
+						uint(entry.sp)
+					);
+				}
+				else
+				{
+					std::sprintf
+					(
+						line,
+						"%8lu %5u        %c %04X = %02X\n",
+						ulong(entry.frame),
+						uint(entry.cycle),
+						entry.type == Entry::WRITE ? 'W' : 'R',
+						uint(entry.address),
+						uint(entry.data)
+					);
+				}
+
+				stream << line;
+
+				if (!stream)
+					throw RESULT_ERR_CORRUPT_FILE;
+			}
+		}
+
+		#ifdef NST_MSVC_OPTIMIZE
+		#pragma optimize("", on)
+		#endif
+	}
+}
+
+#endif
@@ -0,0 +1,146 @@
+////////////////////////////////////////////////////////////////////////////////////////
+//
+// Nestopia - NES/Famicom emulator written in C++
+//
+// Copyright (C) 2003-2008 Martin Freij
+//
+// This file is part of Nestopia.
+//
+// Nestopia is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// Nestopia is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Nestopia; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef NST_TRACER_H
+#define NST_TRACER_H
+
+#ifdef NST_PRAGMA_ONCE
+#pragma once
+#endif
+
+#ifdef NST_TRACE
+
+#include "api/NstApiTracer.hpp"
+
+namespace Nes
+{
+	namespace Core
+	{
+		class Tracer
+		{
+		public:
+
+			typedef Api::Tracer::Entry Entry;
+
+			Tracer();
+			~Tracer();
+
+			void Enable(dword);
+			void Disable();
+			void Clear();
+			void ClearBreakpoints();
+			void SetBreakpoint(uint,bool);
+			dword Read(Entry*,dword) const;
+			void Dump(std::ostream&) const;
+
+		private:
+
+			Entry& Next()
+			{
+				Entry& entry = entries[pos];
+
+				if (++pos == capacity)
+				{
+					pos = 0;
+					wrapped = true;
+				}
+
+				return entry;
+			}
+
+			Entry* entries;
+			dword capacity;
+			dword pos;
+			bool wrapped;
+			dword frame;
+			word cycle;
+			byte* breakpoints;
+
+		public:
+
+			bool IsEnabled() const
+			{
+				return entries;
+			}
+
+			bool IsBreakpoint(uint address) const
+			{
+				return breakpoints && (breakpoints[address >> 3] & (1U << (address & 7)));
+			}
+
+			dword Size() const
+			{
+				return wrapped ? capacity : pos;
+			}
+
+			void EndFrame()
+			{
+				frame++;
+			}
+
+			Entry& Instruction(uint address,uint clock,uint a,uint x,uint y,uint sp,uint p)
+			{
+				cycle = clock;
+
+				Entry& entry = Next();
+
+				entry.frame = frame;
+				entry.cycle = cycle;
+				entry.address = address;
+				entry.type = Entry::INSTRUCTION;
+				entry.data = 0;
+				entry.a = a;
+				entry.x = x;
+				entry.y = y;
+				entry.sp = sp;
+				entry.p = p;
+
+				return entry;
+			}
+
+			void Access(uint type,uint address,uint data)
+			{
+				if (address >= 0x2000 && (address < 0x8000 || type == Entry::WRITE))
+				{
+					Entry& entry = Next();
+
+					entry.frame = frame;
+					entry.cycle = cycle;
+					entry.address = address;
+					entry.type = type;
+					entry.data = data;
+					entry.a = 0;
+					entry.x = 0;
+					entry.y = 0;
+					entry.sp = 0;
+					entry.p = 0;
+				}
+			}
+		};
+	}
+}
+
+#endif
+
+#endif
@@ -26,8 +26,10 @@
 #include "NstMachine.hpp"
 #include "NstTrackerMovie.hpp"
 #include "NstTrackerRewinder.hpp"
+#include "NstTrackerRunAhead.hpp"
 #include "NstImage.hpp"
 #include "api/NstApiMachine.hpp"
+#include "api/NstApiRewinder.hpp"
 
 namespace Nes
 {
@@ -39,16 +41,24 @@ namespace Nes
 
 		Tracker::Tracker()
 		:
-		frame           (0),
-		rewinderSound   (false),
-		rewinderEnabled (NULL),
-		rewinder        (NULL),
-		movie           (NULL)
+		frame              (0),
+		rewinderSound      (false),
+		rewinderDeltas     (false),
+		rewinderKeys       (Api::Rewinder::DEFAULT_SECONDS),
+		rewinderBudget     (0),
+		rewinderEnabled    (NULL),
+		rewinder           (NULL),
+		runAheadFrames     (0),
+		runAheadPreemptive (false),
+		runAhead           (NULL),
+		movieHashes        (false),
+		movie              (NULL)
 		{}
 
 		Tracker::~Tracker()
 		{
 			delete rewinder;
+			delete runAhead;
 			delete movie;
 		}
 
@@ -66,6 +76,9 @@ namespace Nes
 		{
 			frame = 0;
 
+			if (runAhead)
+				runAhead->Reset();
+
 			if (rewinder)
 			{
 				rewinder->Reset();
@@ -83,6 +96,9 @@ namespace Nes
 
 		void Tracker::Resync(bool excludeFrame) const
 		{
+			if (runAhead)
+				runAhead->Reset();
+
 			if (rewinder)
 			{
 				rewinder->Reset();
@@ -128,8 +144,54 @@ namespace Nes
 				rewinder->Reset();
 		}
 
+		void Tracker::SetRewinderStorage(bool deltas,uint keys,dword budget)
+		{
+			if (rewinder)
+				rewinder->SetStorage( deltas, keys, budget );
+
+			rewinderDeltas = deltas;
+			rewinderKeys = keys;
+			rewinderBudget = budget;
+		}
+
+		dword Tracker::GetRewinderMemoryUsage() const
+		{
+			return rewinder ? rewinder->GetMemoryUsage() : 0;
+		}
+
+		void Tracker::SetRunAhead(Machine& emulator,uint frames,bool preemptive)
+		{
+			delete runAhead;
+			runAhead = NULL;
+			runAheadFrames = 0;
+
+			if (frames)
+			{
+				runAhead = new RunAhead
+				(
+					emulator,
+					&Machine::Execute,
+					&Machine::LoadState,
+					&Machine::SaveState,
+					frames,
+					preemptive
+				);
+			}
+
+			runAheadFrames = frames;
+			runAheadPreemptive = preemptive;
+		}
+
+		dword Tracker::NumRunAheadRollbacks() const
+		{
+			return runAhead ? runAhead->NumRollbacks() : 0;
+		}
+
 		void Tracker::UpdateRewinderState(bool enable)
 		{
+			if (runAhead)
+				runAhead->Reset();
+
 			if (enable && rewinderEnabled && !movie)
 			{
 				if (!rewinder)
@@ -143,7 +205,10 @@ namespace Nes
 						rewinderEnabled->cpu,
 						rewinderEnabled->cpu.GetApu(),
 						rewinderEnabled->ppu,
-						rewinderSound
+						rewinderSound,
+						rewinderDeltas,
+						rewinderKeys,
+						rewinderBudget
 					);
 				}
 			}
@@ -172,12 +237,13 @@ namespace Nes
 						emulator,
 						&Machine::LoadState,
 						&Machine::SaveState,
+						&Machine::HashState,
 						emulator.cpu,
 						emulator.Is(Api::Machine::CARTRIDGE) ? emulator.image->GetPrgCrc() : 0
 					);
 				}
 
-				if (movie->Play( stream ))
+				if (movie->Play( stream, movieHashes ))
 				{
 					if (emulator.Is(Api::Machine::ON))
 						emulator.Reset( true );
@@ -225,12 +291,57 @@ namespace Nes
 						emulator,
 						&Machine::LoadState,
 						&Machine::SaveState,
+						&Machine::HashState,
 						emulator.cpu,
 						emulator.image->GetPrgCrc()
 					);
 				}
 
-				return movie->Record( stream, append ) ? RESULT_OK : RESULT_NOP;
+				return movie->Record( stream, append, movieHashes ) ? RESULT_OK : RESULT_NOP;
+			}
+			catch (Result r)
+			{
+				result = r;
+			}
+			catch (const std::bad_alloc&)
+			{
+				result = RESULT_ERR_OUT_OF_MEMORY;
+			}
+			catch (...)
+			{
+				result = RESULT_ERR_GENERIC;
+			}
+
+			StopMovie();
+
+			return result;
+		}
+
+		Result Tracker::SeekMovie(Machine& machine,const dword target)
+		{
+			if (!IsMoviePlaying())
+				return RESULT_ERR_NOT_READY;
+
+			Result result;
+
+			try
+			{
+				dword skip;
+
+				if (!movie->Seek( target, skip ))
+					return RESULT_ERR_INVALID_PARAM;
+
+				// catch up from the keyframe without video and sound
+
+				for (; skip && IsMoviePlaying(); --skip)
+				{
+					result = Execute( machine, NULL, NULL, NULL );
+
+					if (NES_FAILED(result))
+						return result;
+				}
+
+				return RESULT_OK;
 			}
 			catch (Result r)
 			{
@@ -258,6 +369,11 @@ namespace Nes
 			UpdateRewinderState( true );
 		}
 
+		void Tracker::EnableMovieHashes(bool enable)
+		{
+			movieHashes = enable;
+		}
+
 		#ifdef NST_MSVC_OPTIMIZE
 		#pragma optimize("", on)
 		#endif
@@ -287,6 +403,11 @@ namespace Nes
 			return movie && movie->IsRecording();
 		}
 
+		dword Tracker::GetMovieFrame() const
+		{
+			return movie ? movie->GetFrame() : 0;
+		}
+
 		bool Tracker::IsLocked(bool excludeFrame) const
 		{
 			return IsRewinding() || (!excludeFrame && IsMoviePlaying());
@@ -329,6 +450,11 @@ namespace Nes
 								input = NULL;
 							}
 						}
+						else if (runAhead)
+						{
+							runAhead->Execute( video, sound, input );
+							return RESULT_OK;
+						}
 					}
 
 					machine.Execute( video, sound, input );
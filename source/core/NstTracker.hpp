@@ -69,15 +69,22 @@ namespace Nes
 			Result EnableRewinder(Machine*);
 			void   EnableRewinderSound(bool);
 			void   ResetRewinder() const;
+			void   SetRewinderStorage(bool,uint,dword);
+			dword  GetRewinderMemoryUsage() const;
+			void   SetRunAhead(Machine&,uint,bool);
+			dword  NumRunAheadRollbacks() const;
 			Result StartRewinding() const;
 			Result StopRewinding() const;
 			bool   IsRewinding() const;
 
 			Result PlayMovie(Machine&,std::istream&);
 			Result RecordMovie(Machine&,std::iostream&,bool);
+			Result SeekMovie(Machine&,dword);
 			void   StopMovie();
+			void   EnableMovieHashes(bool);
 			bool   IsMoviePlaying() const;
 			bool   IsMovieRecording() const;
+			dword  GetMovieFrame() const;
 
 		private:
 
@@ -85,11 +92,19 @@ namespace Nes
 
 			class Movie;
 			class Rewinder;
+			class RunAhead;
 
 			dword frame;
 			ibool rewinderSound;
+			ibool rewinderDeltas;
+			uint rewinderKeys;
+			dword rewinderBudget;
 			Machine* rewinderEnabled;
 			Rewinder* rewinder;
+			uint runAheadFrames;
+			ibool runAheadPreemptive;
+			RunAhead* runAhead;
+			ibool movieHashes;
 			Movie* movie;
 
 		public:
@@ -104,6 +119,36 @@ namespace Nes
 				return rewinderSound;
 			}
 
+			bool IsRewinderUsingDeltas() const
+			{
+				return rewinderDeltas;
+			}
+
+			uint NumRewinderKeys() const
+			{
+				return rewinderKeys;
+			}
+
+			dword GetRewinderBudget() const
+			{
+				return rewinderBudget;
+			}
+
+			uint NumRunAheadFrames() const
+			{
+				return runAheadFrames;
+			}
+
+			bool IsRunAheadPreemptive() const
+			{
+				return runAheadPreemptive;
+			}
+
+			bool AreMovieHashesEnabled() const
+			{
+				return movieHashes;
+			}
+
 			bool IsFrameLocked() const
 			{
 				return movie;
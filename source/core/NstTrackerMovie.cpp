@@ -28,8 +28,7 @@
 #include "NstState.hpp"
 #include "NstTrackerMovie.hpp"
 #include "NstZlib.hpp"
-#include "api/NstApiMovie.hpp"
-#include "api/NstApiUser.hpp"
+#include "api/NstApiCallbacks.hpp"
 
 namespace Nes
 {
@@ -39,6 +38,176 @@ namespace Nes
 		#pragma optimize("s", on)
 		#endif
 
+		class Tracker::Movie::Index
+		{
+		public:
+
+			Index();
+
+			void Build(State::Loader&,dword);
+			void Save(State::Saver&) const;
+
+			struct Key
+			{
+				dword frame;
+				dword offset;
+			};
+
+			const Key* Find(dword) const;
+
+		private:
+
+			void Load(State::Loader&);
+
+			Vector<Key> keys;
+			dword frames;
+
+		public:
+
+			void Add(dword offset)
+			{
+				const Key key = { frames, offset };
+				keys.Append( key );
+			}
+
+			void Advance(dword count)
+			{
+				frames += count;
+			}
+
+			dword Frames() const
+			{
+				return frames;
+			}
+
+			dword LastKey() const
+			{
+				return keys.Size() ? keys.Back().frame : 0;
+			}
+		};
+
+		Tracker::Movie::Index::Index()
+		: frames(0) {}
+
+		void Tracker::Movie::Index::Build(State::Loader& state,const dword length)
+		{
+			const dword resume = state.Length();
+
+			keys.Clear();
+			frames = 0;
+
+			// an index chunk covers every key before it, so only the keys
+			// recorded after the last one have to be looked into
+
+			dword last = 0;
+
+			state.Seek( length );
+
+			for (;;)
+			{
+				const dword left = state.Length();
+				const dword chunk = state.Begin();
+
+				if (!chunk)
+					break;
+
+				if (chunk == AsciiId<'I','D','X'>::V)
+					last = left;
+
+				state.End();
+			}
+
+			if (last)
+			{
+				state.Seek( last );
+				state.Begin();
+				Load( state );
+				state.End();
+			}
+			else
+			{
+				state.Seek( length );
+			}
+
+			for (;;)
+			{
+				const dword left = state.Length();
+				const dword chunk = state.Begin();
+
+				if (!chunk)
+					break;
+
+				if (chunk == AsciiId<'K','E','Y'>::V)
+				{
+					dword count = 0;
+
+					while (const dword subChunk = state.Begin())
+					{
+						if (subChunk == AsciiId<'S','A','V'>::V)
+						{
+							Add( length - left );
+						}
+						else if (subChunk == AsciiId<'L','E','N'>::V)
+						{
+							count = state.Read32() + 1;
+						}
+
+						state.End();
+					}
+
+					frames += count;
+				}
+
+				state.End();
+			}
+
+			state.Seek( resume );
+		}
+
+		void Tracker::Movie::Index::Load(State::Loader& state)
+		{
+			frames = state.Read32();
+			const dword count = state.Read32();
+
+			if (count > state.Length() / 8)
+				throw RESULT_ERR_CORRUPT_FILE;
+
+			keys.Resize( count );
+
+			for (dword i=0; i < count; ++i)
+			{
+				keys[i].frame = state.Read32();
+				keys[i].offset = state.Read32();
+
+				if (keys[i].frame > frames || (i && keys[i].frame < keys[i-1].frame))
+					throw RESULT_ERR_CORRUPT_FILE;
+			}
+		}
+
+		void Tracker::Movie::Index::Save(State::Saver& state) const
+		{
+			if (keys.Size())
+			{
+				state.Begin( AsciiId<'I','D','X'>::V ).Write32( frames ).Write32( keys.Size() );
+
+				for (const Key* it=keys.Begin(), *const end=keys.End(); it != end; ++it)
+					state.Write32( it->frame ).Write32( it->offset );
+
+				state.End();
+			}
+		}
+
+		const Tracker::Movie::Index::Key* Tracker::Movie::Index::Find(const dword frame) const
+		{
+			for (dword i=keys.Size(); i; --i)
+			{
+				if (keys[i-1].frame <= frame)
+					return &keys[i-1];
+			}
+
+			return NULL;
+		}
+
 		class Tracker::Movie::Player
 		{
 		public:
@@ -81,22 +250,44 @@ namespace Nes
 
 			const Io::Port* ports[2];
 			dword frame;
+			dword played;
 			Buffer buffers[2];
 			Loader state;
 			Cpu& cpu;
+			const dword length;
+			ibool indexed;
+			Index index;
+			const ibool verify;
+			ibool desynced;
+			dword hash;
+			Vector<dword> hashes;
 
 		public:
 
-			static dword Validate(std::istream& stream,const Cpu& cpu,dword prgCrc)
+			static dword Validate(std::istream& stream,const Cpu& cpu,dword prgCrc,Index& index)
 			{
 				Loader state( stream );
-				return Validate( state, cpu, prgCrc, true );
+
+				const dword length = Validate( state, cpu, prgCrc, false );
+
+				index.Build( state, length );
+				state.End( length );
+
+				return length;
 			}
 
-			Player(std::istream& stream,Cpu& c,const dword prgCrc)
-			: frame(0), state(stream), cpu(c)
+			Player(std::istream& stream,Cpu& c,const dword prgCrc,const bool v)
+			:
+			frame    (0),
+			played   (0),
+			state    (stream),
+			cpu      (c),
+			length   (Validate(state,c,prgCrc,false)),
+			indexed  (false),
+			verify   (v),
+			desynced (false),
+			hash     (0)
 			{
-				Validate( state, cpu, prgCrc, false );
 				Relink();
 			}
 
@@ -110,9 +301,52 @@ namespace Nes
 				state.End();
 			}
 
-			bool Execute(Machine& emulator,EmuLoadState loadState)
+			dword GetFrame() const
+			{
+				return played;
+			}
+
+			bool Seek(const dword target,dword& skip)
+			{
+				if (!indexed)
+				{
+					index.Build( state, length );
+					indexed = true;
+				}
+
+				if (target > index.Frames())
+					return false;
+
+				const Index::Key* const key = index.Find( target );
+
+				if (target < played || (key && target - key->frame < target - played))
+				{
+					if (!key || key->offset >= length)
+						throw RESULT_ERR_CORRUPT_FILE;
+
+					// the next frame loads the keyframe state
+
+					state.Seek( length - key->offset );
+
+					for (uint i=0; i < 2; ++i)
+					{
+						buffers[i].pos = 0;
+						buffers[i].Clear();
+					}
+
+					frame = 0;
+					played = key->frame;
+					desynced = false;
+				}
+
+				skip = target - played;
+
+				return true;
+			}
+
+			bool Execute(Machine& emulator,EmuLoadState loadState,EmuHashState hashState)
 			{
-				NST_ASSERT( loadState );
+				NST_ASSERT( loadState && hashState );
 
 				if (buffers[0].pos > buffers[0].Size() || buffers[1].pos > buffers[1].Size())
 					throw RESULT_ERR_CORRUPT_FILE;
@@ -135,6 +369,9 @@ namespace Nes
 							buffers[i].Clear();
 						}
 
+						hash = 0;
+						hashes.Clear();
+
 						while (const dword subChunk = state.Begin())
 						{
 							switch (subChunk)
@@ -159,6 +396,22 @@ namespace Nes
 									frame = state.Read32();
 									NST_VERIFY( frame <= 0xFFFFF );
 									break;
+
+								case AsciiId<'H','S','H'>::V:
+
+									if (verify)
+									{
+										const dword count = state.Read32();
+
+										if (count > state.Length() / 4)
+											throw RESULT_ERR_CORRUPT_FILE;
+
+										hashes.Resize( count );
+
+										for (dword i=0; i < count; ++i)
+											hashes[i] = state.Read32();
+									}
+									break;
 							}
 
 							state.End();
@@ -177,6 +430,17 @@ namespace Nes
 					}
 				}
 
+				// only the first frame to go astray is reported, every
+				// frame after it is bound to differ as well
+
+				if (!desynced && hash < hashes.Size() && hashes[hash++] != (emulator.*hashState)())
+				{
+					desynced = true;
+					cpu.GetCallbacks().movieEvent.Active()( Api::Movie::EVENT_PLAYING_DESYNC );
+				}
+
+				++played;
+
 				return true;
 			}
 		};
@@ -227,7 +491,7 @@ namespace Nes
 			if (region != cpu.GetRegion())
 				throw RESULT_ERR_WRONG_MODE;
 
-			if (crc && prgCrc && crc != prgCrc && Api::User::questionCallback( Api::User::QUESTION_NSV_PRG_CRC_FAIL_CONTINUE ) == Api::User::ANSWER_NO)
+			if (crc && prgCrc && crc != prgCrc && cpu.GetCallbacks().userQuestion.Active()( Api::User::QUESTION_NSV_PRG_CRC_FAIL_CONTINUE ) == Api::User::ANSWER_NO)
 				throw RESULT_ERR_INVALID_CRC;
 
 			return length;
@@ -284,7 +548,8 @@ namespace Nes
 			enum
 			{
 				BAD_FRAME = dword(~0UL),
-				MAX_BUFFER_BLOCK = SIZE_1K * 8192UL
+				MAX_BUFFER_BLOCK = SIZE_1K * 8192UL,
+				KEYFRAME_INTERVAL = 600
 			};
 
 			typedef Vector<byte> Buffer;
@@ -307,13 +572,16 @@ namespace Nes
 			ibool resync;
 			dword frame;
 			Buffer buffers[2];
+			Index index;
 			Saver state;
 			Cpu& cpu;
+			const ibool hashed;
+			Vector<dword> hashes;
 
 		public:
 
-			Recorder(std::iostream& stream,Cpu& c,const dword prgCrc,const bool append)
-			: resync(true), frame(0), state(stream,append ? Player::Validate(stream,c,prgCrc) : 0), cpu(c)
+			Recorder(std::iostream& stream,Cpu& c,const dword prgCrc,const bool append,const bool h)
+			: resync(true), frame(0), state(stream,append ? Player::Validate(stream,c,prgCrc,index) : 0), cpu(c), hashed(h)
 			{
 				if (!append)
 				{
@@ -342,23 +610,37 @@ namespace Nes
 			void Stop()
 			{
 				EndKey();
+				index.Save( state );
 
 				state.End();
 			}
 
-			void Execute(Machine& machine,EmuSaveState saveState)
+			dword GetFrame() const
+			{
+				return frame != BAD_FRAME ? index.Frames() + frame : index.Frames();
+			}
+
+			void Execute(Machine& machine,EmuSaveState saveState,EmuHashState hashState)
 			{
-				NST_ASSERT( saveState );
+				NST_ASSERT( saveState && hashState );
 
 				if (frame == BAD_FRAME)
 					throw RESULT_ERR_OUT_OF_MEMORY;
 
+				// periodic keyframes to seek to when played back
+
+				if (index.Frames() + frame >= index.LastKey() + KEYFRAME_INTERVAL)
+					resync = true;
+
 				if (resync || buffers[0].Size() >= MAX_BUFFER_BLOCK || buffers[1].Size() >= MAX_BUFFER_BLOCK)
 				{
 					EndKey();
 					BeginKey( machine, saveState );
 				}
 
+				if (hashed)
+					hashes.Append( (machine.*hashState)() );
+
 				++frame;
 			}
 		};
@@ -377,12 +659,16 @@ namespace Nes
 
 		void Tracker::Movie::Recorder::BeginKey(Machine& machine,EmuSaveState saveState)
 		{
+			const dword key = state.Length();
+
 			state.Begin( AsciiId<'K','E','Y'>::V );
 
 			if (resync)
 			{
 				resync = false;
 
+				index.Add( key );
+
 				state.Begin( AsciiId<'S','A','V'>::V );
 				(machine.*saveState)( state );
 				state.End();
@@ -397,6 +683,7 @@ namespace Nes
 			if (frame)
 			{
 				state.Begin( AsciiId<'L','E','N'>::V ).Write32( frame-1 ).End();
+				index.Advance( frame );
 				frame = 0;
 
 				for (uint i=0; i < 2; ++i)
@@ -408,6 +695,17 @@ namespace Nes
 					}
 				}
 
+				if (hashes.Size())
+				{
+					state.Begin( AsciiId<'H','S','H'>::V ).Write32( hashes.Size() );
+
+					for (const dword* it=hashes.Begin(), *const end=hashes.End(); it != end; ++it)
+						state.Write32( *it );
+
+					state.End();
+					hashes.Clear();
+				}
+
 				state.End();
 			}
 		}
@@ -444,13 +742,14 @@ namespace Nes
 		#pragma optimize("s", on)
 		#endif
 
-		Tracker::Movie::Movie(Machine& e,EmuLoadState l,EmuSaveState s,Cpu& c,dword crc)
+		Tracker::Movie::Movie(Machine& e,EmuLoadState l,EmuSaveState s,EmuHashState h,Cpu& c,dword crc)
 		:
 		player    (NULL),
 		recorder  (NULL),
 		emulator  (e),
 		saveState (s),
 		loadState (l),
+		hashState (h),
 		cpu       (c),
 		prgCrc    (crc)
 		{
@@ -461,7 +760,7 @@ namespace Nes
 			Stop();
 		}
 
-		bool Tracker::Movie::Record(std::iostream& stream,const bool append)
+		bool Tracker::Movie::Record(std::iostream& stream,const bool append,const bool hashed)
 		{
 			if (!Zlib::AVAILABLE)
 				throw RESULT_ERR_UNSUPPORTED;
@@ -474,14 +773,14 @@ namespace Nes
 
 			Stop();
 
-			recorder = new Recorder( stream, cpu, prgCrc, append );
+			recorder = new Recorder( stream, cpu, prgCrc, append, hashed );
 
-			Api::Movie::eventCallback( Api::Movie::EVENT_RECORDING );
+			cpu.GetCallbacks().movieEvent.Active()( Api::Movie::EVENT_RECORDING );
 
 			return true;
 		}
 
-		bool Tracker::Movie::Play(std::istream& stream)
+		bool Tracker::Movie::Play(std::istream& stream,const bool verify)
 		{
 			if (!Zlib::AVAILABLE)
 				throw RESULT_ERR_UNSUPPORTED;
@@ -494,9 +793,9 @@ namespace Nes
 
 			Stop();
 
-			player = new Player( stream, cpu, prgCrc );
+			player = new Player( stream, cpu, prgCrc, verify );
 
-			Api::Movie::eventCallback( Api::Movie::EVENT_PLAYING );
+			cpu.GetCallbacks().movieEvent.Active()( Api::Movie::EVENT_PLAYING );
 
 			return true;
 		}
@@ -538,14 +837,14 @@ namespace Nes
 					delete recorder;
 					recorder = NULL;
 
-					Api::Movie::eventCallback( Api::Movie::EVENT_RECORDING_STOPPED, result );
+					cpu.GetCallbacks().movieEvent.Active()( Api::Movie::EVENT_RECORDING_STOPPED, result );
 				}
 				else
 				{
 					delete player;
 					player = NULL;
 
-					Api::Movie::eventCallback( Api::Movie::EVENT_PLAYING_STOPPED, result );
+					cpu.GetCallbacks().movieEvent.Active()( Api::Movie::EVENT_PLAYING_STOPPED, result );
 
 					if (NES_FAILED(result))
 						return false;
@@ -575,6 +874,19 @@ namespace Nes
 				recorder->Resync();
 		}
 
+		bool Tracker::Movie::Seek(const dword frame,dword& skip)
+		{
+			if (!player)
+				throw RESULT_ERR_NOT_READY;
+
+			return player->Seek( frame, skip );
+		}
+
+		dword Tracker::Movie::GetFrame() const
+		{
+			return player ? player->GetFrame() : recorder ? recorder->GetFrame() : 0;
+		}
+
 		#ifdef NST_MSVC_OPTIMIZE
 		#pragma optimize("", on)
 		#endif
@@ -587,10 +899,10 @@ namespace Nes
 			{
 				if (recorder)
 				{
-					recorder->Execute( emulator, saveState );
+					recorder->Execute( emulator, saveState, hashState );
 					return true;
 				}
-				else if (player && player->Execute( emulator, loadState ))
+				else if (player && player->Execute( emulator, loadState, hashState ))
 				{
 					return true;
 				}
@@ -37,23 +37,27 @@ namespace Nes
 		{
 			typedef bool (Machine::*EmuLoadState)(State::Loader&,bool);
 			typedef void (Machine::*EmuSaveState)(State::Saver&) const;
+			typedef dword (Machine::*EmuHashState)() const;
 
 		public:
 
-			Movie(Machine&,EmuLoadState,EmuSaveState,Cpu&,dword);
+			Movie(Machine&,EmuLoadState,EmuSaveState,EmuHashState,Cpu&,dword);
 			~Movie();
 
-			bool Play(std::istream&);
-			bool Record(std::iostream&,bool);
+			bool Play(std::istream&,bool);
+			bool Record(std::iostream&,bool,bool);
 			void Stop();
 			void Resync();
 			void Reset();
 			bool Execute();
+			bool Seek(dword,dword&);
+			dword GetFrame() const;
 
 		private:
 
 			bool Stop(Result);
 
+			class Index;
 			class Player;
 			class Recorder;
 
@@ -62,6 +66,7 @@ namespace Nes
 			Machine& emulator;
 			const EmuSaveState saveState;
 			const EmuLoadState loadState;
+			const EmuHashState hashState;
 			Cpu& cpu;
 			const dword prgCrc;
 
@@ -29,7 +29,7 @@
 #include "NstMachine.hpp"
 #include "NstState.hpp"
 #include "NstTrackerRewinder.hpp"
-#include "api/NstApiRewinder.hpp"
+#include "api/NstApiCallbacks.hpp"
 #include "NstZlib.hpp"
 
 namespace Nes
@@ -86,19 +86,26 @@ namespace Nes
 
 		class Tracker::Rewinder::ReverseSound::Mutex
 		{
+			Api::Callbacks& callbacks;
 			Output::LockCallback funcLock;
 			void* userLock;
 			Output::UnlockCallback funcUnlock;
 			void* userUnlock;
+			const bool localLock;
+			const bool localUnlock;
 
 		public:
 
-			Mutex()
+			explicit Mutex(Api::Callbacks& c)
+			:
+			callbacks   ( c ),
+			localLock   ( c.soundLock.IsLocal() ),
+			localUnlock ( c.soundUnlock.IsLocal() )
 			{
-				Output::lockCallback.Get( funcLock, userLock );
-				Output::unlockCallback.Get( funcUnlock, userUnlock );
-				Output::lockCallback.Set( NULL, NULL );
-				Output::unlockCallback.Set( NULL, NULL );
+				callbacks.soundLock.Active().Get( funcLock, userLock );
+				callbacks.soundUnlock.Active().Get( funcUnlock, userUnlock );
+				callbacks.soundLock.Set( NULL, NULL );
+				callbacks.soundUnlock.Set( NULL, NULL );
 			}
 
 			bool Lock(Output& output) const
@@ -114,8 +121,15 @@ namespace Nes
 
 			~Mutex()
 			{
-				Output::lockCallback.Set( funcLock, userLock );
-				Output::unlockCallback.Set( funcUnlock, userUnlock );
+				if (localLock)
+					callbacks.soundLock.Set( funcLock, userLock );
+				else
+					callbacks.soundLock.Unset();
+
+				if (localUnlock)
+					callbacks.soundUnlock.Set( funcUnlock, userUnlock );
+				else
+					callbacks.soundUnlock.Unset();
 			}
 		};
 
@@ -145,9 +159,27 @@ namespace Nes
 		apu     (a)
 		{}
 
-		Tracker::Rewinder::Rewinder(Machine& e,EmuExecute x,EmuLoadState l,EmuSaveState s,Cpu& c,const Apu& a,Ppu& p,bool b)
+		Tracker::Rewinder::Rewinder
+		(
+			Machine& e,
+			EmuExecute x,
+			EmuLoadState l,
+			EmuSaveState s,
+			Cpu& c,
+			const Apu& a,
+			Ppu& p,
+			bool b,
+			bool d,
+			uint n,
+			dword m
+		)
 		:
 		rewinding    (false),
+		keys         (NULL),
+		numKeys      (0),
+		deltas       (false),
+		budget       (0),
+		headKey      (NULL),
 		sound        (a,b),
 		video        (p),
 		emulator     (e),
@@ -157,7 +189,7 @@ namespace Nes
 		cpu          (c),
 		ppu          (p)
 		{
-			Reset( true );
+			SetStorage( d, n, m );
 		}
 
 		Tracker::Rewinder::ReverseVideo::~ReverseVideo()
@@ -173,6 +205,26 @@ namespace Nes
 		Tracker::Rewinder::~Rewinder()
 		{
 			LinkPorts( false );
+			delete [] keys;
+		}
+
+		void Tracker::Rewinder::SetStorage(bool d,uint n,dword m)
+		{
+			NST_ASSERT( n >= 2 );
+
+			if (numKeys != n)
+			{
+				Key* const k = new Key [n];
+
+				delete [] keys;
+				keys = k;
+				numKeys = n;
+			}
+
+			deltas = d;
+			budget = m;
+
+			Reset( true );
 		}
 
 		void Tracker::Rewinder::LinkPorts(bool on)
@@ -206,7 +258,7 @@ namespace Nes
 
 		void Tracker::Rewinder::Key::Reset()
 		{
-			stream.str( std::string() );
+			state.Destroy();
 			input.Reset();
 		}
 
@@ -218,16 +270,20 @@ namespace Nes
 			if (rewinding)
 			{
 				rewinding = false;
-				Api::Rewinder::stateCallback( Api::Rewinder::STOPPED );
+				cpu.GetCallbacks().rewinderState.Active()( Api::Rewinder::STOPPED );
 			}
 
 			uturn = false;
 			frame = LAST_FRAME;
-			key = keys + LAST_KEY;
+			key = keys + (numKeys-1);
 
-			for (uint i=0; i < NUM_FRAMES; ++i)
+			for (uint i=0; i < numKeys; ++i)
 				keys[i].Reset();
 
+			headKey = NULL;
+			head.Destroy();
+			next.Destroy();
+
 			LinkPorts( on );
 		}
 
@@ -389,6 +445,11 @@ namespace Nes
 			return pos != BAD_POS;
 		}
 
+		inline dword Tracker::Rewinder::Key::Input::Size() const
+		{
+			return buffer.Capacity();
+		}
+
 		inline uint Tracker::Rewinder::Key::Input::Put(const uint data)
 		{
 			if (pos != BAD_POS)
@@ -436,25 +497,14 @@ namespace Nes
 			input.ResumeForward();
 		}
 
-		void Tracker::Rewinder::Key::BeginForward(Machine& emulator,EmuSaveState saveState,EmuLoadState loadState)
+		inline dword Tracker::Rewinder::Key::Size() const
 		{
-			NST_ASSERT( !saveState || !loadState );
+			return state.Capacity() + input.Size();
+		}
 
+		inline void Tracker::Rewinder::Key::BeginForward()
+		{
 			input.BeginForward();
-
-			if (saveState)
-			{
-				stream.clear();
-				stream.seekp( 0, std::stringstream::beg );
-				stream.clear();
-
-				State::Saver saver( &static_cast<std::ostream&>(stream), false, true );
-				(emulator.*saveState)( saver );
-			}
-			else if (loadState)
-			{
-				TurnForward( emulator, loadState );
-			}
 		}
 
 		void Tracker::Rewinder::Key::EndForward()
@@ -463,21 +513,10 @@ namespace Nes
 				Reset();
 		}
 
-		void Tracker::Rewinder::Key::TurnForward(Machine& emulator,EmuLoadState loadState)
-		{
-			stream.clear();
-			stream.seekg( 0, std::stringstream::beg );
-			stream.clear();
-
-			State::Loader loader( &static_cast<std::istream&>(stream), false );
-			(emulator.*loadState)( loader, true );
-		}
-
-		void Tracker::Rewinder::Key::BeginBackward(Machine& emulator,EmuLoadState loadState)
+		void Tracker::Rewinder::Key::BeginBackward()
 		{
 			NST_VERIFY( CanRewind() );
 
-			TurnForward( emulator, loadState );
 			input.BeginBackward();
 		}
 
@@ -498,7 +537,7 @@ namespace Nes
 
 		inline Tracker::Rewinder::Key* Tracker::Rewinder::PrevKey(Key* k)
 		{
-			return (k != keys ? k-1 : keys+LAST_KEY);
+			return (k != keys ? k-1 : keys+(numKeys-1));
 		}
 
 		inline Tracker::Rewinder::Key* Tracker::Rewinder::PrevKey()
@@ -508,7 +547,7 @@ namespace Nes
 
 		inline Tracker::Rewinder::Key* Tracker::Rewinder::NextKey(Key* k)
 		{
-			return (k != keys+LAST_KEY ? k+1 : keys);
+			return (k != keys+(numKeys-1) ? k+1 : keys);
 		}
 
 		inline Tracker::Rewinder::Key* Tracker::Rewinder::NextKey()
@@ -516,6 +555,241 @@ namespace Nes
 			return NextKey( key );
 		}
 
+		void Tracker::Rewinder::EncodeDelta(const Vector<byte>& a,const Vector<byte>& b,Vector<byte>& delta)
+		{
+			// Layout: the two state sizes, then a sequence of (skip, length, bytes)
+			// runs of the XOR between both states, run lengths stored as 7-bit varints.
+			// XOR being symmetric, the same delta turns either state into the other.
+
+			class Writer
+			{
+				Vector<byte>& out;
+
+			public:
+
+				explicit Writer(Vector<byte>& v)
+				: out(v) {}
+
+				void Put(dword count)
+				{
+					for (; count >= 0x80; count >>= 7)
+						out.Append( byte(count | 0x80) );
+
+					out.Append( byte(count) );
+				}
+			};
+
+			const dword sizeA = a.Size();
+			const dword sizeB = b.Size();
+			const dword length = (sizeA > sizeB ? sizeA : sizeB);
+
+			delta.Clear();
+			delta.Reserve( 16 );
+
+			Writer writer( delta );
+			writer.Put( sizeA );
+			writer.Put( sizeB );
+
+			struct Xor
+			{
+				static uint At(const Vector<byte>& a,const Vector<byte>& b,dword i)
+				{
+					return (i < a.Size() ? a[i] : 0U) ^ (i < b.Size() ? b[i] : 0U);
+				}
+			};
+
+			for (dword i=0; i < length; )
+			{
+				const dword skip = i;
+
+				while (i < length && !Xor::At( a, b, i ))
+					++i;
+
+				if (i == length)
+					break;
+
+				const dword start = i;
+
+				while (i < length && (Xor::At( a, b, i ) || (i+1 < length && Xor::At( a, b, i+1 ))))
+					++i;
+
+				writer.Put( start - skip );
+				writer.Put( i - start );
+
+				for (dword j=start; j < i; ++j)
+					delta.Append( byte(Xor::At( a, b, j )) );
+			}
+
+			delta.Defrag();
+		}
+
+		void Tracker::Rewinder::ApplyDelta(const Vector<byte>& delta,Vector<byte>& data)
+		{
+			class Reader
+			{
+				const Vector<byte>& in;
+				dword pos;
+
+			public:
+
+				explicit Reader(const Vector<byte>& v)
+				: in(v), pos(0) {}
+
+				dword Get()
+				{
+					dword count = 0;
+
+					for (uint shift=0; shift < 32; shift += 7)
+					{
+						if (pos == in.Size())
+							throw RESULT_ERR_CORRUPT_FILE;
+
+						const uint data = in[pos++];
+						count |= dword(data & 0x7F) << shift;
+
+						if (!(data & 0x80))
+							return count;
+					}
+
+					throw RESULT_ERR_CORRUPT_FILE;
+				}
+
+				const byte* Take(dword length)
+				{
+					if (in.Size() - pos < length)
+						throw RESULT_ERR_CORRUPT_FILE;
+
+					pos += length;
+					return in.Begin() + (pos - length);
+				}
+
+				bool End() const
+				{
+					return pos == in.Size();
+				}
+			};
+
+			Reader reader( delta );
+
+			const dword sizeA = reader.Get();
+			const dword sizeB = reader.Get();
+			const dword size = data.Size();
+
+			if (size != sizeA && size != sizeB)
+				throw RESULT_ERR_CORRUPT_FILE;
+
+			const dword length = (sizeA > sizeB ? sizeA : sizeB);
+
+			if (size < length)
+			{
+				data.Resize( length );
+				std::memset( data.Begin() + size, 0, length - size );
+			}
+
+			for (dword i=0; !reader.End(); )
+			{
+				i += reader.Get();
+				const dword count = reader.Get();
+
+				if (i > length || length - i < count)
+					throw RESULT_ERR_CORRUPT_FILE;
+
+				const byte* NST_RESTRICT src = reader.Take( count );
+
+				for (byte* NST_RESTRICT dst = data.Begin() + i, *const end = dst + count; dst != end; ++dst, ++src)
+					*dst ^= *src;
+
+				i += count;
+			}
+
+			data.SetTo( size == sizeA ? sizeB : sizeA );
+		}
+
+		void Tracker::Rewinder::SaveKey(Key* const target)
+		{
+			if (!deltas)
+			{
+				target->state.Clear();
+
+				State::Saver saver( target->state, true );
+				(emulator.*emuSaveState)( saver );
+			}
+			else
+			{
+				next.Clear();
+
+				{
+					State::Saver saver( next, true );
+					(emulator.*emuSaveState)( saver );
+				}
+
+				Key* const prev = PrevKey( target );
+
+				if (headKey == prev)
+					EncodeDelta( head, next, prev->state );
+				else
+					prev->Invalidate();
+
+				target->state.Destroy();
+				Vector<byte>::Swap( head, next );
+				headKey = target;
+			}
+
+			TrimKeys();
+		}
+
+		void Tracker::Rewinder::LoadKey(Key* const target)
+		{
+			const Vector<byte>* data = &target->state;
+
+			if (deltas)
+			{
+				if (headKey != target)
+				{
+					if (headKey && target == PrevKey( headKey ))
+						ApplyDelta( target->state, head );
+					else if (headKey && target == NextKey( headKey ))
+						ApplyDelta( headKey->state, head );
+					else
+						throw RESULT_ERR_CORRUPT_FILE;
+
+					headKey = target;
+				}
+
+				data = &head;
+			}
+
+			if (!data->Size())
+				throw RESULT_ERR_CORRUPT_FILE;
+
+			State::Loader loader( data->Begin(), data->Size(), false );
+			(emulator.*emuLoadState)( loader, true );
+		}
+
+		void Tracker::Rewinder::TrimKeys()
+		{
+			if (budget)
+			{
+				dword usage = GetMemoryUsage();
+
+				for (Key* k=NextKey(); usage > budget && k != PrevKey(); k=NextKey( k ))
+				{
+					usage -= k->Size();
+					k->Reset();
+				}
+			}
+		}
+
+		dword Tracker::Rewinder::GetMemoryUsage() const
+		{
+			dword usage = head.Capacity() + next.Capacity();
+
+			for (uint i=0; i < numKeys; ++i)
+				usage += keys[i].Size();
+
+			return usage;
+		}
+
 		inline void Tracker::Rewinder::ReverseVideo::Flush(const Mutex& mutex)
 		{
 			mutex.Flush( (*buffer)[frame] );
@@ -662,7 +936,8 @@ namespace Nes
 						frame = 0;
 						key->EndForward();
 						key = NextKey();
-						key->BeginForward( emulator, emuSaveState, NULL );
+						key->BeginForward();
+						SaveKey( key );
 					}
 				}
 				else
@@ -676,7 +951,8 @@ namespace Nes
 
 						if (prev->CanRewind())
 						{
-							prev->BeginBackward( emulator, emuLoadState );
+							LoadKey( prev );
+							prev->BeginBackward();
 							key = prev;
 						}
 						else
@@ -685,9 +961,10 @@ namespace Nes
 
 							key->Invalidate();
 							key = NextKey();
-							key->BeginForward( emulator, NULL, emuLoadState );
+							key->BeginForward();
+							LoadKey( key );
 
-							Api::Rewinder::stateCallback( Api::Rewinder::STOPPED );
+							cpu.GetCallbacks().rewinderState.Active()( Api::Rewinder::STOPPED );
 
 							LinkPorts();
 						}
@@ -699,7 +976,7 @@ namespace Nes
 						video.Flush( videoMutex );
 						video.Store();
 
-						const ReverseSound::Mutex soundMutex;
+						const ReverseSound::Mutex soundMutex( cpu.GetCallbacks() );
 						sound.Flush( soundOut, soundMutex );
 						soundOut = sound.Store();
 
@@ -719,7 +996,7 @@ namespace Nes
 
 		void Tracker::Rewinder::ChangeDirection()
 		{
-			Api::Rewinder::stateCallback( Api::Rewinder::PREPARING );
+			cpu.GetCallbacks().rewinderState.Active()( Api::Rewinder::PREPARING );
 
 			uturn = false;
 
@@ -733,12 +1010,13 @@ namespace Nes
 				video.Begin();
 				sound.Begin();
 
-				key->BeginBackward( emulator, emuLoadState );
+				LoadKey( key );
+				key->BeginBackward();
 				LinkPorts();
 
 				{
 					const ReverseVideo::Mutex videoMutex( video );
-					const ReverseSound::Mutex soundMutex;
+					const ReverseSound::Mutex soundMutex( cpu.GetCallbacks() );
 
 					for (uint i=0; i < NUM_FRAMES; ++i)
 					{
@@ -758,7 +1036,7 @@ namespace Nes
 						throw RESULT_ERR_CORRUPT_FILE;
 				}
 
-				Api::Rewinder::stateCallback( Api::Rewinder::REWINDING );
+				cpu.GetCallbacks().rewinderState.Active()( Api::Rewinder::REWINDING );
 			}
 			else
 			{
@@ -768,7 +1046,7 @@ namespace Nes
 					{
 						frame = 0;
 						key = NextKey();
-						key->TurnForward( emulator, emuLoadState );
+						LoadKey( key );
 					}
 
 					(emulator.*emuExecute)( NULL, NULL, NULL );
@@ -781,7 +1059,7 @@ namespace Nes
 				video.End();
 				sound.End();
 
-				Api::Rewinder::stateCallback( Api::Rewinder::STOPPED );
+				cpu.GetCallbacks().rewinderState.Active()( Api::Rewinder::STOPPED );
 			}
 		}
 
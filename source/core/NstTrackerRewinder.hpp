@@ -25,7 +25,6 @@
 #ifndef NST_TRACKER_REWINDER_H
 #define NST_TRACKER_REWINDER_H
 
-#include <sstream>
 #include "api/NstApiSound.hpp"
 
 #ifndef NST_VECTOR_H
@@ -48,23 +47,31 @@ namespace Nes
 
 		public:
 
-			Rewinder(Machine&,EmuExecute,EmuLoadState,EmuSaveState,Cpu&,const Apu&,Ppu&,bool);
+			Rewinder(Machine&,EmuExecute,EmuLoadState,EmuSaveState,Cpu&,const Apu&,Ppu&,bool,bool,uint,dword);
 			~Rewinder();
 
 			Result Start();
 			Result Stop();
 			void   Execute(Video::Output*,Sound::Output*,Input::Controllers*);
+			void   SetStorage(bool,uint,dword);
+			dword  GetMemoryUsage() const;
 
 		private:
 
+			class Key;
+
 			void Reset(bool);
 			void LinkPorts(bool=true);
 			void ChangeDirection();
+			void SaveKey(Key*);
+			void LoadKey(Key*);
+			void TrimKeys();
+
+			static void EncodeDelta(const Vector<byte>&,const Vector<byte>&,Vector<byte>&);
+			static void ApplyDelta(const Vector<byte>&,Vector<byte>&);
 
 			enum
 			{
-				NUM_KEYS = 60,
-				LAST_KEY = NUM_KEYS-1,
 				NUM_FRAMES = 60,
 				LAST_FRAME = NUM_FRAMES-1
 			};
@@ -99,10 +106,10 @@ namespace Nes
 					inline void ResumeForward();
 					inline bool CanRewind() const;
 					inline void Invalidate();
+					inline dword Size() const;
 				};
 
 				Input input;
-				std::stringstream stream;
 
 			public:
 
@@ -110,9 +117,9 @@ namespace Nes
 				~Key();
 
 				void Reset();
-				void BeginForward(Machine&,EmuSaveState,EmuLoadState);
+				inline void BeginForward();
 				void EndForward();
-				void BeginBackward(Machine&,EmuLoadState);
+				void BeginBackward();
 				inline void EndBackward();
 
 				inline uint Put(uint);
@@ -120,8 +127,10 @@ namespace Nes
 
 				inline bool CanRewind() const;
 				inline void ResumeForward();
-				inline void TurnForward(Machine&,EmuLoadState);
 				inline void Invalidate();
+				inline dword Size() const;
+
+				Vector<byte> state;
 			};
 
 			class ReverseVideo
@@ -214,7 +223,14 @@ namespace Nes
 			const Io::Port* ports[2];
 
 			Key* key;
-			Key keys[NUM_KEYS];
+			Key* keys;
+			uint numKeys;
+			bool deltas;
+			dword budget;
+
+			Key* headKey;
+			Vector<byte> head;
+			Vector<byte> next;
 
 			ReverseSound sound;
 			ReverseVideo video;
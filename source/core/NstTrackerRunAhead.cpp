@@ -0,0 +1,157 @@
+////////////////////////////////////////////////////////////////////////////////////////
+//
+// Nestopia - NES/Famicom emulator written in C++
+//
+// Copyright (C) 2003-2008 Martin Freij
+//
+// This file is part of Nestopia.
+//
+// Nestopia is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// Nestopia is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Nestopia; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+////////////////////////////////////////////////////////////////////////////////////////
+
+#include <cstring>
+#include "NstMachine.hpp"
+#include "NstState.hpp"
+#include "NstTrackerRunAhead.hpp"
+
+namespace Nes
+{
+	namespace Core
+	{
+		#ifdef NST_MSVC_OPTIMIZE
+		#pragma optimize("s", on)
+		#endif
+
+		Tracker::RunAhead::RunAhead
+		(
+			Machine& e,
+			EmuExecute x,
+			EmuLoadState l,
+			EmuSaveState s,
+			uint n,
+			bool p
+		)
+		:
+		emulator     (e),
+		emuExecute   (x),
+		emuLoadState (l),
+		emuSaveState (s),
+		frames       (n),
+		preemptive   (p),
+		primed       (false),
+		first        (0),
+		rollbacks    (0),
+		states       (new Vector<byte> [p ? n : 1])
+		{
+			NST_ASSERT( n );
+		}
+
+		Tracker::RunAhead::~RunAhead()
+		{
+			delete [] states;
+		}
+
+		void Tracker::RunAhead::Reset()
+		{
+			primed = false;
+			first = 0;
+		}
+
+		#ifdef NST_MSVC_OPTIMIZE
+		#pragma optimize("", on)
+		#endif
+
+		void Tracker::RunAhead::SaveState(Vector<byte>& state) const
+		{
+			state.Clear();
+
+			State::Saver saver( state, true );
+			(emulator.*emuSaveState)( saver );
+		}
+
+		void Tracker::RunAhead::LoadState(const Vector<byte>& state) const
+		{
+			State::Loader loader( state.Begin(), state.Size(), true );
+
+			if (!(emulator.*emuLoadState)( loader, true ))
+				throw RESULT_ERR_CORRUPT_FILE;
+		}
+
+		void Tracker::RunAhead::Execute(Video::Output* const video,Sound::Output* const sound,Input::Controllers* const input)
+		{
+			if (preemptive)
+				Preempt( video, sound, input );
+			else
+				Rerun( video, sound, input );
+		}
+
+		void Tracker::RunAhead::Rerun(Video::Output* const video,Sound::Output* const sound,Input::Controllers* const input)
+		{
+			// the real frame produces the sound, the frame shown is
+			// taken from the hidden ones and the machine is put back
+
+			(emulator.*emuExecute)( NULL, sound, input );
+
+			SaveState( states[0] );
+
+			for (uint i=1; i < frames; ++i)
+				(emulator.*emuExecute)( NULL, NULL, input );
+
+			(emulator.*emuExecute)( video, NULL, input );
+
+			LoadState( states[0] );
+		}
+
+		void Tracker::RunAhead::Preempt(Video::Output* const video,Sound::Output* const sound,Input::Controllers* const input)
+		{
+			// states[first] is the machine at the start of the oldest frame run on
+			// predicted input and the others follow it, wrapping around the ring
+
+			const bool steady = primed && (!input || std::memcmp( &prediction, input, sizeof(prediction) ) == 0);
+
+			if (input)
+				std::memcpy( &prediction, input, sizeof(prediction) );
+
+			if (steady)
+			{
+				SaveState( states[first] );
+
+				if (++first == frames)
+					first = 0;
+			}
+			else
+			{
+				if (primed)
+				{
+					LoadState( states[first] );
+					++rollbacks;
+				}
+
+				primed = false;
+
+				for (uint i=0; i < frames; ++i)
+				{
+					(emulator.*emuExecute)( NULL, NULL, input );
+					SaveState( states[(first + i) % frames] );
+				}
+
+				primed = true;
+			}
+
+			(emulator.*emuExecute)( video, sound, input );
+		}
+	}
+}
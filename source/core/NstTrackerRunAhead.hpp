@@ -0,0 +1,85 @@
+////////////////////////////////////////////////////////////////////////////////////////
+//
+// Nestopia - NES/Famicom emulator written in C++
+//
+// Copyright (C) 2003-2008 Martin Freij
+//
+// This file is part of Nestopia.
+//
+// Nestopia is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// Nestopia is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Nestopia; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef NST_TRACKER_RUNAHEAD_H
+#define NST_TRACKER_RUNAHEAD_H
+
+#include "api/NstApiInput.hpp"
+
+#ifndef NST_VECTOR_H
+#include "NstVector.hpp"
+#endif
+
+#ifdef NST_PRAGMA_ONCE
+#pragma once
+#endif
+
+namespace Nes
+{
+	namespace Core
+	{
+		class Tracker::RunAhead
+		{
+			typedef void (Machine::*EmuExecute)(Video::Output*,Sound::Output*,Input::Controllers*);
+			typedef void (Machine::*EmuSaveState)(State::Saver&) const;
+			typedef bool (Machine::*EmuLoadState)(State::Loader&,bool);
+
+		public:
+
+			RunAhead(Machine&,EmuExecute,EmuLoadState,EmuSaveState,uint,bool);
+			~RunAhead();
+
+			void Reset();
+			void Execute(Video::Output*,Sound::Output*,Input::Controllers*);
+
+		private:
+
+			void Rerun(Video::Output*,Sound::Output*,Input::Controllers*);
+			void Preempt(Video::Output*,Sound::Output*,Input::Controllers*);
+			void SaveState(Vector<byte>&) const;
+			void LoadState(const Vector<byte>&) const;
+
+			Machine& emulator;
+			const EmuExecute emuExecute;
+			const EmuLoadState emuLoadState;
+			const EmuSaveState emuSaveState;
+			const uint frames;
+			const ibool preemptive;
+			ibool primed;
+			uint first;
+			dword rollbacks;
+			Vector<byte>* const states;
+			Input::Controllers prediction;
+
+		public:
+
+			dword NumRollbacks() const
+			{
+				return rollbacks;
+			}
+		};
+	}
+}
+
+#endif
@@ -0,0 +1,329 @@
+////////////////////////////////////////////////////////////////////////////////////////
+//
+// Nestopia - NES/Famicom emulator written in C++
+//
+// Copyright (C) 2003-2008 Martin Freij
+//
+// This file is part of Nestopia.
+//
+// Nestopia is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// Nestopia is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Nestopia; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+////////////////////////////////////////////////////////////////////////////////////////
+
+#include "NstCore.hpp"
+
+#ifndef NST_NO_THREADS
+
+#ifdef NST_WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+
+#include <new>
+#include "NstAssert.hpp"
+#include "NstVideoRenderer.hpp"
+#include "NstVideoBlitter.hpp"
+
+namespace Nes
+{
+	namespace Core
+	{
+		namespace Video
+		{
+			#ifdef NST_WIN32
+
+			class Renderer::Blitter::Semaphore
+			{
+				const HANDLE handle;
+
+			public:
+
+				Semaphore()
+				: handle(::CreateSemaphore( NULL, 0, LONG_MAX, NULL ))
+				{
+					if (!handle)
+						throw RESULT_ERR_OUT_OF_MEMORY;
+				}
+
+				~Semaphore()
+				{
+					::CloseHandle( handle );
+				}
+
+				void Post()
+				{
+					::ReleaseSemaphore( handle, 1, NULL );
+				}
+
+				void Wait()
+				{
+					::WaitForSingleObject( handle, INFINITE );
+				}
+			};
+
+			struct Renderer::Blitter::Worker
+			{
+				Blitter* blitter;
+				uint band;
+				HANDLE thread;
+				Semaphore start;
+
+				static DWORD WINAPI Main(LPVOID data)
+				{
+					static_cast<Worker*>(data)->Loop();
+					return 0;
+				}
+
+				bool Create()
+				{
+					return (thread = ::CreateThread( NULL, 0, Main, this, 0, NULL )) != NULL;
+				}
+
+				void Join()
+				{
+					::WaitForSingleObject( thread, INFINITE );
+					::CloseHandle( thread );
+				}
+
+				void Loop();
+			};
+
+			#else
+
+			class Renderer::Blitter::Semaphore
+			{
+				pthread_mutex_t mutex;
+				pthread_cond_t cond;
+				uint count;
+
+			public:
+
+				Semaphore()
+				: count(0)
+				{
+					if (::pthread_mutex_init( &mutex, NULL ))
+						throw RESULT_ERR_OUT_OF_MEMORY;
+
+					if (::pthread_cond_init( &cond, NULL ))
+					{
+						::pthread_mutex_destroy( &mutex );
+						throw RESULT_ERR_OUT_OF_MEMORY;
+					}
+				}
+
+				~Semaphore()
+				{
+					::pthread_cond_destroy( &cond );
+					::pthread_mutex_destroy( &mutex );
+				}
+
+				void Post()
+				{
+					::pthread_mutex_lock( &mutex );
+					++count;
+					::pthread_cond_signal( &cond );
+					::pthread_mutex_unlock( &mutex );
+				}
+
+				void Wait()
+				{
+					::pthread_mutex_lock( &mutex );
+
+					while (!count)
+						::pthread_cond_wait( &cond, &mutex );
+
+					--count;
+					::pthread_mutex_unlock( &mutex );
+				}
+			};
+
+			struct Renderer::Blitter::Worker
+			{
+				Blitter* blitter;
+				uint band;
+				pthread_t thread;
+				Semaphore start;
+
+				static void* Main(void* data)
+				{
+					static_cast<Worker*>(data)->Loop();
+					return NULL;
+				}
+
+				bool Create()
+				{
+					return ::pthread_create( &thread, NULL, Main, this ) == 0;
+				}
+
+				void Join()
+				{
+					::pthread_join( thread, NULL );
+				}
+
+				void Loop();
+			};
+
+			#endif
+
+			void Renderer::Blitter::Worker::Loop()
+			{
+				for (;;)
+				{
+					start.Wait();
+
+					if (blitter->quit)
+						break;
+
+					blitter->Run( band );
+					blitter->done->Post();
+				}
+			}
+
+			#ifdef NST_MSVC_OPTIMIZE
+			#pragma optimize("s", on)
+			#endif
+
+			Renderer::Blitter::Blitter(const uint t,const bool a)
+			:
+			threads    (t),
+			async      (a),
+			numWorkers (0),
+			bands      (0),
+			pending    (0),
+			phase      (0),
+			quit       (false),
+			rows       (NULL),
+			filter     (NULL),
+			screen     (NULL),
+			source     (NULL),
+			done       (NULL),
+			workers    (NULL)
+			{
+				NST_ASSERT( t && (a || t > 1) );
+
+				// in synchronous mode the calling thread renders the first band itself
+
+				try
+				{
+					if (async)
+						screen = new Input;
+
+					done = new Semaphore;
+					workers = static_cast<Worker*>(::operator new (sizeof(Worker) * threads));
+
+					for (const uint n=(async ? threads : threads-1); numWorkers < n; ++numWorkers)
+					{
+						Worker* const worker = new (workers + numWorkers) Worker;
+
+						worker->blitter = this;
+						worker->band = async ? numWorkers : numWorkers+1;
+
+						if (!worker->Create())
+						{
+							worker->~Worker();
+							throw RESULT_ERR_GENERIC;
+						}
+					}
+				}
+				catch (...)
+				{
+					Stop();
+					throw;
+				}
+			}
+
+			Renderer::Blitter::~Blitter()
+			{
+				Wait();
+				Stop();
+			}
+
+			void Renderer::Blitter::Stop()
+			{
+				quit = true;
+
+				for (uint i=0; i < numWorkers; ++i)
+					workers[i].start.Post();
+
+				for (uint i=0; i < numWorkers; ++i)
+				{
+					workers[i].Join();
+					workers[i].~Worker();
+				}
+
+				::operator delete (workers);
+				delete done;
+				delete screen;
+			}
+
+			#ifdef NST_MSVC_OPTIMIZE
+			#pragma optimize("", on)
+			#endif
+
+			void Renderer::Blitter::Start(Filter& f,const Output& o,const Input& input,const uint p,const byte* const r)
+			{
+				NST_ASSERT( !pending );
+
+				if (async)
+				{
+					// the PPU renders the next frame into its own screen meanwhile
+					*screen = input;
+					source = screen;
+				}
+				else
+				{
+					source = &input;
+				}
+
+				filter = &f;
+				output = o;
+				phase = p;
+				bands = f.CanBlitRows() ? threads : 1;
+				rows = f.CanBlitRows() ? r : NULL;
+
+				for (uint i=0; i < numWorkers; ++i)
+				{
+					if (workers[i].band < bands)
+					{
+						++pending;
+						workers[i].start.Post();
+					}
+				}
+
+				if (!async)
+					Run( 0 );
+			}
+
+			void Renderer::Blitter::Wait()
+			{
+				for (; pending; --pending)
+					done->Wait();
+			}
+
+			void Renderer::Blitter::Run(const uint band)
+			{
+				if (rows)
+					filter->BlitDirtyRows( *source, output, phase, HEIGHT * band / bands, HEIGHT * (band+1) / bands, rows );
+				else if (bands == 1)
+					filter->Blit( *source, output, phase );
+				else
+					filter->BlitRows( *source, output, phase, HEIGHT * band / bands, HEIGHT * (band+1) / bands );
+			}
+		}
+	}
+}
+
+#endif
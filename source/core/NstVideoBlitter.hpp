@@ -0,0 +1,91 @@
+////////////////////////////////////////////////////////////////////////////////////////
+//
+// Nestopia - NES/Famicom emulator written in C++
+//
+// Copyright (C) 2003-2008 Martin Freij
+//
+// This file is part of Nestopia.
+//
+// Nestopia is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// Nestopia is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Nestopia; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef NST_VIDEO_BLITTER_H
+#define NST_VIDEO_BLITTER_H
+
+#ifdef NST_PRAGMA_ONCE
+#pragma once
+#endif
+
+#ifndef NST_NO_THREADS
+
+namespace Nes
+{
+	namespace Core
+	{
+		namespace Video
+		{
+			class Renderer::Blitter
+			{
+			public:
+
+				Blitter(uint,bool);
+				~Blitter();
+
+				void Start(Filter&,const Output&,const Input&,uint,const byte*);
+				void Wait();
+
+			private:
+
+				class Semaphore;
+				struct Worker;
+
+				void Run(uint);
+				void Stop();
+
+				const uint threads;
+				const ibool async;
+				uint numWorkers;
+				uint bands;
+				uint pending;
+				uint phase;
+				ibool quit;
+				const byte* rows;
+				Filter* filter;
+				Output output;
+				Input* screen;
+				const Input* source;
+				Semaphore* done;
+				Worker* workers;
+
+			public:
+
+				uint NumThreads() const
+				{
+					return threads;
+				}
+
+				bool IsAsync() const
+				{
+					return async;
+				}
+			};
+		}
+	}
+}
+
+#endif
+
+#endif
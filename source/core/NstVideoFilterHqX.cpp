@@ -27,6 +27,10 @@
 
 #ifndef NST_NO_HQ2X
 
+#ifdef NST_MM_INTRINSICS
+#include <emmintrin.h>
+#endif
+
 #include "NstAssert.hpp"
 #include "NstVideoRenderer.hpp"
 #include "NstVideoFilterHqX.hpp"
@@ -39,7 +43,22 @@ namespace Nes
 		{
 			void Renderer::FilterHqX::Blit(const Input& input,const Output& output,uint)
 			{
-				(*this.*path)( input, output );
+				(*this.*path)( input, output, 0, HEIGHT );
+			}
+
+			void Renderer::FilterHqX::BlitRows(const Input& input,const Output& output,uint,uint first,uint last)
+			{
+				(*this.*path)( input, output, first, last );
+			}
+
+			bool Renderer::FilterHqX::CanBlitRows() const
+			{
+				return true;
+			}
+
+			uint Renderer::FilterHqX::GetRowMargin() const
+			{
+				return 1;
 			}
 
 			template<dword R,dword G,dword B>
@@ -131,6 +150,8 @@ namespace Nes
 				uint w[10];
 				dword c[10];
 
+				inline void Load(const Lines&,uint);
+
 				NST_FORCE_INLINE void Convert(const Lut& lut)
 				{
 					for (uint k=0; k < 9; ++k)
@@ -147,60 +168,231 @@ namespace Nes
 					dword c[10];
 				};
 
+				inline void Load(const Lines&,uint);
+
 				void Convert(const Lut&)
 				{
 				}
 			};
 
-			template<typename T,dword R,dword G,dword B>
-			void Renderer::FilterHqX::Blit2x(const Input& input,const Output& output) const
+			struct Renderer::FilterHqX::Line
 			{
-				const byte* NST_RESTRICT src = reinterpret_cast<const byte*>(input.pixels);
-				const long pitch = output.pitch + output.pitch - (WIDTH*2 * sizeof(T));
+				dword w[WIDTH+2];
+				dword yuv[WIDTH+2];
+			};
 
-				T* NST_RESTRICT dst[2] =
+			struct Renderer::FilterHqX::Lines
+			{
+				Lines()
+				: next(~0U)
 				{
-					static_cast<T*>(output.pixels) - 2,
-					reinterpret_cast<T*>(static_cast<byte*>(output.pixels) + output.pitch) - 2
-				};
+					for (uint i=0; i < 3; ++i)
+						line[i] = buffer + i;
+				}
+
+				Line* line[3];
+				uint next;
+				byte pattern[WIDTH];
+				byte flat[WIDTH];
+				Line buffer[3];
+			};
+
+			template<typename T>
+			NST_FORCE_INLINE void Renderer::FilterHqX::Buffer<T>::Load(const Lines& lines,const uint x)
+			{
+				for (uint k=0; k < 9; ++k)
+					w[k] = lines.line[k / 3]->w[x + k % 3];
+			}
+
+			NST_FORCE_INLINE void Renderer::FilterHqX::Buffer<word>::Load(const Lines& lines,const uint x)
+			{
+				for (uint k=0; k < 9; ++k)
+					w[k] = lines.line[k / 3]->w[x + k % 3];
+			}
+
+			void Renderer::FilterHqX::Fetch(Line& line,const Input& input,const uint y) const
+			{
+				NST_ASSERT( y < HEIGHT );
+
+				const Input::Pixel* const NST_RESTRICT src = input.pixels + y * WIDTH;
+
+				for (uint x=0; x < WIDTH; ++x)
+				{
+					line.w[x+1] = input.palette[src[x]];
+					line.yuv[x+1] = lut.yuv[line.w[x+1]];
+				}
+
+				// edge pixels are repeated past the borders
+
+				line.w[0] = line.w[1];
+				line.w[WIDTH+1] = line.w[WIDTH];
+				line.yuv[0] = line.yuv[1];
+				line.yuv[WIDTH+1] = line.yuv[WIDTH];
+			}
 
-				for (uint y=HEIGHT; y; --y)
+			void Renderer::FilterHqX::Fetch(Lines& lines,const Input& input,const uint y) const
+			{
+				if (y && y == lines.next)
 				{
-					const uint lines[2] =
+					// moving down one row, only the one below is new
+
+					Line* const line = lines.line[0];
+
+					lines.line[0] = lines.line[1];
+					lines.line[1] = lines.line[2];
+					lines.line[2] = line;
+
+					Fetch( *line, input, y < HEIGHT-1 ? y+1 : y );
+				}
+				else
+				{
+					Fetch( *lines.line[0], input, y ? y-1 : y );
+					Fetch( *lines.line[1], input, y );
+					Fetch( *lines.line[2], input, y < HEIGHT-1 ? y+1 : y );
+				}
+
+				lines.next = y + 1;
+			}
+
+			void Renderer::FilterHqX::Analyze(Lines& lines)
+			{
+				for (uint x=0; x < WIDTH; ++x)
+				{
+					const dword w = lines.line[1]->w[x+1];
+					const dword yuv = lines.line[1]->yuv[x+1];
+
+					uint pattern = 0;
+					uint flat = 1;
+
+					for (uint k=0, bit=0x01; k < 9; ++k)
 					{
-						y < HEIGHT ? WIDTH * sizeof(Input::Pixel) : 0,
-						y > 1      ? WIDTH * sizeof(Input::Pixel) : 0
-					};
+						if (k != 4)
+						{
+							if (w != lines.line[k / 3]->w[x + k % 3])
+							{
+								flat = 0;
+
+								if ((yuv - lines.line[k / 3]->yuv[x + k % 3]) & Lut::YUV_MASK)
+									pattern |= bit;
+							}
+
+							bit <<= 1;
+						}
+					}
 
-					Buffer<T> b;
+					lines.pattern[x] = pattern;
+					lines.flat[x] = flat;
+				}
+			}
+
+		#ifdef NST_MM_INTRINSICS
+
+			void Renderer::FilterHqX::AnalyzeSse2(Lines& lines)
+			{
+				NST_COMPILE_ASSERT( sizeof(dword) == 4 && WIDTH % 8 == 0 );
+
+				const __m128i mask = _mm_set1_epi32( Lut::YUV_MASK );
+				const __m128i zero = _mm_setzero_si128();
 
-					b.w[2] = (b.w[1] = input.palette[*reinterpret_cast<const Input::Pixel*>(src - lines[0])]);
-					b.w[5] = (b.w[4] = input.palette[*reinterpret_cast<const Input::Pixel*>(src)]);
-					b.w[8] = (b.w[7] = input.palette[*reinterpret_cast<const Input::Pixel*>(src + lines[1])]);
+				for (uint x=0; x < WIDTH; x += 8)
+				{
+					__m128i pattern[2];
+					__m128i flat[2];
 
-					for (uint x=WIDTH; x; )
+					for (uint i=0; i < 2; ++i)
 					{
-						src += sizeof(Input::Pixel);
-						dst[0] += 2;
-						dst[1] += 2;
+						const __m128i w = _mm_loadu_si128( reinterpret_cast<const __m128i*>(lines.line[1]->w + x + i*4 + 1) );
+						const __m128i yuv = _mm_loadu_si128( reinterpret_cast<const __m128i*>(lines.line[1]->yuv + x + i*4 + 1) );
+
+						pattern[i] = zero;
+						flat[i] = _mm_cmpeq_epi32( zero, zero );
+
+						for (uint k=0, bit=0x01; k < 9; ++k)
+						{
+							if (k != 4)
+							{
+								const __m128i same = _mm_cmpeq_epi32( w, _mm_loadu_si128( reinterpret_cast<const __m128i*>(lines.line[k / 3]->w + x + i*4 + k % 3) ) );
+								const __m128i diff = _mm_and_si128( _mm_sub_epi32( yuv, _mm_loadu_si128( reinterpret_cast<const __m128i*>(lines.line[k / 3]->yuv + x + i*4 + k % 3) ) ), mask );
+
+								pattern[i] = _mm_or_si128( pattern[i], _mm_andnot_si128( _mm_or_si128( same, _mm_cmpeq_epi32( diff, zero ) ), _mm_set1_epi32( bit ) ) );
+								flat[i] = _mm_and_si128( flat[i], same );
+
+								bit <<= 1;
+							}
+						}
+
+						flat[i] = _mm_srli_epi32( flat[i], 31 );
+					}
+
+					_mm_storel_epi64( reinterpret_cast<__m128i*>(lines.pattern + x), _mm_packus_epi16( _mm_packs_epi32( pattern[0], pattern[1] ), zero ) );
+					_mm_storel_epi64( reinterpret_cast<__m128i*>(lines.flat + x), _mm_packus_epi16( _mm_packs_epi32( flat[0], flat[1] ), zero ) );
+				}
+			}
+
+		#endif
+
+			template<typename T,uint N>
+			NST_FORCE_INLINE uint Renderer::FilterHqX::Fill(T* NST_RESTRICT (&dst)[N],const Lines& lines,const uint x) const
+			{
+				// the 3x3 neighborhood of each pixel in the run is a single color,
+				// so every interpolation would give back that color
+
+				uint length = 1;
+
+				while (x + length < WIDTH && lines.flat[x + length])
+					++length;
+
+				const dword w = lines.line[1]->w[x+1];
+				const T color = sizeof(T) == sizeof(dword) ? lut.rgb[w] : w;
+
+				for (uint i=0; i < N; ++i)
+				{
+					T* const NST_RESTRICT row = dst[i] + N;
+
+					for (uint j=0; j < N * length; ++j)
+						row[j] = color;
+
+					dst[i] += N * length;
+				}
+
+				return length;
+			}
+
+			template<typename T,dword R,dword G,dword B>
+			void Renderer::FilterHqX::Blit2x(const Input& input,const Output& output,const uint first,const uint last) const
+			{
+				byte* const pixels = static_cast<byte*>(output.pixels) + long(first) * 2 * output.pitch;
+				const long pitch = output.pitch + output.pitch - (WIDTH*2 * sizeof(T));
+
+				T* NST_RESTRICT dst[2] =
+				{
+					reinterpret_cast<T*>(pixels) - 2,
+					reinterpret_cast<T*>(pixels + output.pitch) - 2
+				};
 
-						b.w[0] = b.w[1];
-						b.w[1] = b.w[2];
-						b.w[3] = b.w[4];
-						b.w[4] = b.w[5];
-						b.w[6] = b.w[7];
-						b.w[7] = b.w[8];
+				Lines lines;
 
-						if (--x)
+				for (uint y=first; y < last; ++y)
+				{
+					Fetch( lines, input, y );
+					analyze( lines );
+
+					for (uint x=0; x < WIDTH; ++x)
+					{
+						if (lines.flat[x])
 						{
-							b.w[2] = input.palette[*reinterpret_cast<const Input::Pixel*>(src - lines[0])];
-							b.w[5] = input.palette[*reinterpret_cast<const Input::Pixel*>(src)];
-							b.w[8] = input.palette[*reinterpret_cast<const Input::Pixel*>(src + lines[1])];
+							x += Fill<T,2>( dst, lines, x ) - 1;
+							continue;
 						}
 
+						dst[0] += 2;
+						dst[1] += 2;
+
+						Buffer<T> b;
+						b.Load( lines, x );
 						b.Convert( lut );
 
-						const uint yuv5 = lut.yuv[b.w[4]];
+						const uint pattern = lines.pattern[x];
 
 						#include "NstVideoFilterHq2x.inl"
 					}
@@ -211,56 +403,42 @@ namespace Nes
 			}
 
 			template<typename T,dword R,dword G,dword B>
-			void Renderer::FilterHqX::Blit3x(const Input& input,const Output& output) const
+			void Renderer::FilterHqX::Blit3x(const Input& input,const Output& output,const uint first,const uint last) const
 			{
-				const byte* NST_RESTRICT src = reinterpret_cast<const byte*>(input.pixels);
+				byte* const pixels = static_cast<byte*>(output.pixels) + long(first) * 3 * output.pitch;
 				const long pitch = (output.pitch * 2) + output.pitch - (WIDTH*3 * sizeof(T));
 
 				T* NST_RESTRICT dst[3] =
 				{
-					static_cast<T*>(output.pixels) - 3,
-					reinterpret_cast<T*>(static_cast<byte*>(output.pixels) + output.pitch) - 3,
-					reinterpret_cast<T*>(static_cast<byte*>(output.pixels) + output.pitch * 2) - 3
+					reinterpret_cast<T*>(pixels) - 3,
+					reinterpret_cast<T*>(pixels + output.pitch) - 3,
+					reinterpret_cast<T*>(pixels + output.pitch * 2) - 3
 				};
 
-				for (uint y=HEIGHT; y; --y)
-				{
-					const uint lines[2] =
-					{
-						y < HEIGHT ? WIDTH * sizeof(Input::Pixel) : 0,
-						y > 1      ? WIDTH * sizeof(Input::Pixel) : 0
-					};
-
-					Buffer<T> b;
+				Lines lines;
 
-					b.w[2] = (b.w[1] = input.palette[*reinterpret_cast<const Input::Pixel*>(src - lines[0])]);
-					b.w[5] = (b.w[4] = input.palette[*reinterpret_cast<const Input::Pixel*>(src)]);
-					b.w[8] = (b.w[7] = input.palette[*reinterpret_cast<const Input::Pixel*>(src + lines[1])]);
+				for (uint y=first; y < last; ++y)
+				{
+					Fetch( lines, input, y );
+					analyze( lines );
 
-					for (uint x=WIDTH; x; )
+					for (uint x=0; x < WIDTH; ++x)
 					{
-						src += sizeof(Input::Pixel);
+						if (lines.flat[x])
+						{
+							x += Fill<T,3>( dst, lines, x ) - 1;
+							continue;
+						}
+
 						dst[0] += 3;
 						dst[1] += 3;
 						dst[2] += 3;
 
-						b.w[0] = b.w[1];
-						b.w[1] = b.w[2];
-						b.w[3] = b.w[4];
-						b.w[4] = b.w[5];
-						b.w[6] = b.w[7];
-						b.w[7] = b.w[8];
-
-						if (--x)
-						{
-							b.w[2] = input.palette[*reinterpret_cast<const Input::Pixel*>(src - lines[0])];
-							b.w[5] = input.palette[*reinterpret_cast<const Input::Pixel*>(src)];
-							b.w[8] = input.palette[*reinterpret_cast<const Input::Pixel*>(src + lines[1])];
-						}
-
+						Buffer<T> b;
+						b.Load( lines, x );
 						b.Convert( lut );
 
-						const uint yuv5 = lut.yuv[b.w[4]];
+						const uint pattern = lines.pattern[x];
 
 						#include "NstVideoFilterHq3x.inl"
 					}
@@ -272,58 +450,44 @@ namespace Nes
 			}
 
 			template<typename T,dword R,dword G,dword B>
-			void Renderer::FilterHqX::Blit4x(const Input& input,const Output& output) const
+			void Renderer::FilterHqX::Blit4x(const Input& input,const Output& output,const uint first,const uint last) const
 			{
-				const byte* NST_RESTRICT src = reinterpret_cast<const byte*>(input.pixels);
+				byte* const pixels = static_cast<byte*>(output.pixels) + long(first) * 4 * output.pitch;
 				const long pitch = (output.pitch * 3) + output.pitch - (WIDTH*4 * sizeof(T));
 
 				T* NST_RESTRICT dst[4] =
 				{
-					static_cast<T*>(output.pixels) - 4,
-					reinterpret_cast<T*>(static_cast<byte*>(output.pixels) + output.pitch) - 4,
-					reinterpret_cast<T*>(static_cast<byte*>(output.pixels) + output.pitch * 2) - 4,
-					reinterpret_cast<T*>(static_cast<byte*>(output.pixels) + output.pitch * 3) - 4
+					reinterpret_cast<T*>(pixels) - 4,
+					reinterpret_cast<T*>(pixels + output.pitch) - 4,
+					reinterpret_cast<T*>(pixels + output.pitch * 2) - 4,
+					reinterpret_cast<T*>(pixels + output.pitch * 3) - 4
 				};
 
-				for (uint y=HEIGHT; y; --y)
-				{
-					const uint lines[2] =
-					{
-						y < HEIGHT ? WIDTH * sizeof(Input::Pixel) : 0,
-						y > 1      ? WIDTH * sizeof(Input::Pixel) : 0
-					};
+				Lines lines;
 
-					Buffer<T> b;
-
-					b.w[2] = (b.w[1] = input.palette[*reinterpret_cast<const Input::Pixel*>(src - lines[0])]);
-					b.w[5] = (b.w[4] = input.palette[*reinterpret_cast<const Input::Pixel*>(src)]);
-					b.w[8] = (b.w[7] = input.palette[*reinterpret_cast<const Input::Pixel*>(src + lines[1])]);
+				for (uint y=first; y < last; ++y)
+				{
+					Fetch( lines, input, y );
+					analyze( lines );
 
-					for (uint x=WIDTH; x; )
+					for (uint x=0; x < WIDTH; ++x)
 					{
-						src += sizeof(Input::Pixel);
+						if (lines.flat[x])
+						{
+							x += Fill<T,4>( dst, lines, x ) - 1;
+							continue;
+						}
+
 						dst[0] += 4;
 						dst[1] += 4;
 						dst[2] += 4;
 						dst[3] += 4;
 
-						b.w[0] = b.w[1];
-						b.w[1] = b.w[2];
-						b.w[3] = b.w[4];
-						b.w[4] = b.w[5];
-						b.w[6] = b.w[7];
-						b.w[7] = b.w[8];
-
-						if (--x)
-						{
-							b.w[2] = input.palette[*reinterpret_cast<const Input::Pixel*>(src - lines[0])];
-							b.w[5] = input.palette[*reinterpret_cast<const Input::Pixel*>(src)];
-							b.w[8] = input.palette[*reinterpret_cast<const Input::Pixel*>(src + lines[1])];
-						}
-
+						Buffer<T> b;
+						b.Load( lines, x );
 						b.Convert( lut );
 
-						const uint yuv5 = lut.yuv[b.w[4]];
+						const uint pattern = lines.pattern[x];
 
 						#include "NstVideoFilterHq4x.inl"
 					}
@@ -429,11 +593,22 @@ namespace Nes
 				}
 			}
 
-			Renderer::FilterHqX::FilterHqX(const RenderState& state)
+			Renderer::FilterHqX::Analyzer Renderer::FilterHqX::GetAnalyzer()
+			{
+			#ifdef NST_MM_INTRINSICS
+				if (CanUseSse2())
+					return &FilterHqX::AnalyzeSse2;
+			#endif
+
+				return &FilterHqX::Analyze;
+			}
+
+			Renderer::FilterHqX::FilterHqX(const RenderState& state,const bool simd)
 			:
 			Filter (state),
-			path   (GetPath(state)),
-			lut    (state.bits.count == 32,format.shifts)
+			path    (GetPath(state)),
+			analyze (simd ? GetAnalyzer() : &FilterHqX::Analyze),
+			lut     (state.bits.count == 32,format.shifts)
 			{
 			}
 
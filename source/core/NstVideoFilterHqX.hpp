@@ -40,7 +40,7 @@ namespace Nes
 			{
 			public:
 
-				explicit FilterHqX(const RenderState&);
+				FilterHqX(const RenderState&,bool);
 
 				static bool Check(const RenderState&);
 
@@ -48,11 +48,32 @@ namespace Nes
 
 				~FilterHqX() {}
 
-				typedef void (FilterHqX::*Path)(const Input&,const Output&) const;
+				typedef void (FilterHqX::*Path)(const Input&,const Output&,uint,uint) const;
 
 				static Path GetPath(const RenderState&);
 
+				struct Line;
+				struct Lines;
+
+				typedef void (*Analyzer)(Lines&);
+
+				static Analyzer GetAnalyzer();
+				static void Analyze(Lines&);
+
+			#ifdef NST_MM_INTRINSICS
+				static void AnalyzeSse2(Lines&);
+			#endif
+
+				void Fetch(Line&,const Input&,uint) const;
+				void Fetch(Lines&,const Input&,uint) const;
+
+				template<typename T,uint N>
+				inline uint Fill(T* NST_RESTRICT (&)[N],const Lines&,uint) const;
+
 				void Blit(const Input&,const Output&,uint);
+				void BlitRows(const Input&,const Output&,uint,uint,uint);
+				bool CanBlitRows() const;
+				uint GetRowMargin() const;
 				void Transform(const byte (&)[PALETTE][3],Input::Palette&) const;
 
 				template<dword R,dword G,dword B> static dword Interpolate1(dword,dword);
@@ -69,13 +90,13 @@ namespace Nes
 				inline dword Diff(uint,uint) const;
 
 				template<typename T,dword R,dword G,dword B>
-				void Blit2x(const Input&,const Output&) const;
+				void Blit2x(const Input&,const Output&,uint,uint) const;
 
 				template<typename T,dword R,dword G,dword B>
-				void Blit3x(const Input&,const Output&) const;
+				void Blit3x(const Input&,const Output&,uint,uint) const;
 
 				template<typename T,dword R,dword G,dword B>
-				void Blit4x(const Input&,const Output&) const;
+				void Blit4x(const Input&,const Output&,uint,uint) const;
 
 				template<typename T>
 				struct Buffer;
@@ -96,6 +117,7 @@ namespace Nes
 				};
 
 				const Path path;
+				const Analyzer analyze;
 				const Lut lut;
 			};
 		}
@@ -48,12 +48,14 @@ namespace Nes
 				~FilterNone() {}
 
 				void Blit(const Input&,const Output&,uint);
+				void BlitRows(const Input&,const Output&,uint,uint,uint);
+				bool CanBlitRows() const;
 
 				template<typename T>
-				static void BlitAligned(const Input&,const Output&);
+				static void BlitAligned(const Input&,const Output&,uint,uint);
 
 				template<typename T>
-				static void BlitUnaligned(const Input&,const Output&);
+				static void BlitUnaligned(const Input&,const Output&,uint,uint);
 			};
 		}
 	}
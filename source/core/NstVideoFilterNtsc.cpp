@@ -35,22 +35,37 @@ namespace Nes
 		{
 			void Renderer::FilterNtsc::Blit(const Input& input,const Output& output,uint phase)
 			{
-				(*this.*path)( input, output, phase );
+				(*this.*path)( input, output, phase, 0, HEIGHT );
+			}
+
+			void Renderer::FilterNtsc::BlitRows(const Input& input,const Output& output,uint phase,uint first,uint last)
+			{
+				(*this.*path)( input, output, phase, first, last );
+			}
+
+			bool Renderer::FilterNtsc::CanBlitRows() const
+			{
+				return true;
+			}
+
+			bool Renderer::FilterNtsc::UsesBurstPhase() const
+			{
+				return lut.noFieldMerging != 0;
 			}
 
 			template<typename Pixel,uint BITS>
-			void Renderer::FilterNtsc::BlitType(const Input& input,const Output& output,uint phase) const
+			void Renderer::FilterNtsc::BlitType(const Input& input,const Output& output,uint phase,const uint first,const uint last) const
 			{
-				NST_ASSERT( phase < 3 );
+				NST_ASSERT( phase < 3 && first < last && last <= HEIGHT );
 				
 				const uint bgcolor = this->bgColor;
-				const Input::Pixel* NST_RESTRICT src = input.pixels;
-				Pixel* NST_RESTRICT dst = static_cast<Pixel*>(output.pixels);
+				const Input::Pixel* NST_RESTRICT src = input.pixels + first * WIDTH;
+				Pixel* NST_RESTRICT dst = reinterpret_cast<Pixel*>(static_cast<byte*>(output.pixels) + long(first) * output.pitch);
 				const long pad = output.pitch - (NTSC_WIDTH-7) * sizeof(Pixel);
 
-				phase &= lut.noFieldMerging;
+				phase = ((phase & lut.noFieldMerging) + first) % 3;
 
-				for (uint y=HEIGHT; y; --y)
+				for (uint y=last-first; y; --y)
 				{
 					NES_NTSC_BEGIN_ROW( &lut, phase, bgcolor, bgcolor, *src++ );
 
@@ -54,12 +54,15 @@ namespace Nes
 					NTSC_WIDTH = 602
 				};
 
-				typedef void (FilterNtsc::*Path)(const Input&,const Output&,uint) const;
+				typedef void (FilterNtsc::*Path)(const Input&,const Output&,uint,uint,uint) const;
 
 				void Blit(const Input&,const Output&,uint);
+				void BlitRows(const Input&,const Output&,uint,uint,uint);
+				bool CanBlitRows() const;
+				bool UsesBurstPhase() const;
 
 				template<typename T,uint BITS>
-				void BlitType(const Input&,const Output&,uint) const;
+				void BlitType(const Input&,const Output&,uint,uint,uint) const;
 
 				class Lut : public nes_ntsc_t
 				{
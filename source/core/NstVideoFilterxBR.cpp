@@ -24,6 +24,10 @@
 #include "NstVideoRenderer.hpp"
 #include "NstVideoFilterxBR.hpp"
 
+#ifdef NST_MM_INTRINSICS
+#include <emmintrin.h>
+#endif
+
 namespace Nes
 {
 	namespace Core
@@ -37,11 +41,12 @@ namespace Nes
 			/**
 			 * Constructor
 			 */
-			Renderer::FilterxBR::FilterxBR(const RenderState& state, const bool blend, const schar corner_rounding)
+			Renderer::FilterxBR::FilterxBR(const RenderState& state, const bool blend, const schar corner_rounding, const bool simd)
 			:
 			_blend(blend),
 			Filter (state),
-			path   (GetPath(state, blend, corner_rounding))
+			path   (GetPath(state, blend, corner_rounding)),
+			analyze(simd ? GetAnalyzer() : &FilterxBR::Analyze)
 			{
 				_index = new YUVPixel*[32768];
 
@@ -232,6 +237,16 @@ namespace Nes
 				//return NULL;
 			}
 
+			Renderer::FilterxBR::Analyzer Renderer::FilterxBR::GetAnalyzer()
+			{
+			#ifdef NST_MM_INTRINSICS
+				if (CanUseSse2())
+					return &FilterxBR::AnalyzeSse2;
+			#endif
+
+				return &FilterxBR::Analyze;
+			}
+
 			/**
 			 * Checks if this filter can be used with the render state
 			 *
@@ -248,19 +263,123 @@ namespace Nes
 				);
 			}
 
+			// Flat pixels
+			struct Renderer::FilterxBR::Lines
+			{
+				Lines()
+				: next(~0U)
+				{
+					for (uint i=0; i < 3; ++i)
+						line[i] = buffer[i];
+				}
+
+				dword* line[3];
+				uint next;
+				byte skip[WIDTH];
+				dword buffer[3][WIDTH+2];
+			};
+
+			/**
+			 * Fetches the lines above, at and below y, clamped like the filter loops do
+			 */
+			void Renderer::FilterxBR::Fetch(Lines& lines,const Input& input,const uint y) const
+			{
+				NST_ASSERT( y < HEIGHT );
+
+				const uint first = (y && y == lines.next) ? 2 : 0;
+
+				if (first)
+				{
+					//Moving down one line, only the one below is new
+					dword* const line = lines.line[0];
+					lines.line[0] = lines.line[1];
+					lines.line[1] = lines.line[2];
+					lines.line[2] = line;
+				}
+
+				for (uint i=first; i < 3; ++i)
+				{
+					const uint row = (i == 0) ? (y ? y-1 : y) : (i == 1) ? y : (y < HEIGHT-1 ? y+1 : y);
+					const Input::Pixel* const NST_RESTRICT src = input.pixels + row * WIDTH;
+					dword* const NST_RESTRICT line = lines.line[i];
+
+					for (uint x=0; x < WIDTH; ++x)
+						line[x+1] = input.palette[src[x]];
+
+					line[0] = line[1];
+					line[WIDTH+1] = line[WIDTH];
+				}
+
+				lines.next = y + 1;
+			}
+
+			/**
+			 * Every kernel returns early unless the center differs from both of its
+			 * two edge neighbors. When all four do, the block is the source pixel.
+			 */
+			void Renderer::FilterxBR::Analyze(Lines& lines)
+			{
+				for (uint x=0; x < WIDTH; ++x)
+				{
+					const dword pe = lines.line[1][x+1];
+					const bool b = (pe == lines.line[0][x+1]);
+					const bool d = (pe == lines.line[1][x+0]);
+					const bool f = (pe == lines.line[1][x+2]);
+					const bool h = (pe == lines.line[2][x+1]);
+
+					lines.skip[x] = (h || f) && (f || b) && (b || d) && (d || h);
+				}
+			}
+
+		#ifdef NST_MM_INTRINSICS
+
+			void Renderer::FilterxBR::AnalyzeSse2(Lines& lines)
+			{
+				NST_COMPILE_ASSERT( sizeof(dword) == 4 && WIDTH % 8 == 0 );
+
+				const __m128i one = _mm_set1_epi32( 1 );
+
+				for (uint x=0; x < WIDTH; x += 8)
+				{
+					__m128i skip[2];
+
+					for (uint i=0; i < 2; ++i)
+					{
+						const __m128i pe = _mm_loadu_si128( reinterpret_cast<const __m128i*>(lines.line[1] + x + i*4 + 1) );
+						const __m128i b = _mm_cmpeq_epi32( pe, _mm_loadu_si128( reinterpret_cast<const __m128i*>(lines.line[0] + x + i*4 + 1) ) );
+						const __m128i d = _mm_cmpeq_epi32( pe, _mm_loadu_si128( reinterpret_cast<const __m128i*>(lines.line[1] + x + i*4 + 0) ) );
+						const __m128i f = _mm_cmpeq_epi32( pe, _mm_loadu_si128( reinterpret_cast<const __m128i*>(lines.line[1] + x + i*4 + 2) ) );
+						const __m128i h = _mm_cmpeq_epi32( pe, _mm_loadu_si128( reinterpret_cast<const __m128i*>(lines.line[2] + x + i*4 + 1) ) );
+
+						skip[i] = _mm_and_si128
+						(
+							_mm_and_si128( _mm_or_si128( h, f ), _mm_or_si128( f, b ) ),
+							_mm_and_si128( _mm_or_si128( b, d ), _mm_or_si128( d, h ) )
+						);
+
+						skip[i] = _mm_and_si128( skip[i], one );
+					}
+
+					_mm_storel_epi64( reinterpret_cast<__m128i*>(lines.skip + x), _mm_packus_epi16( _mm_packs_epi32( skip[0], skip[1] ), _mm_setzero_si128() ) );
+				}
+			}
+
+		#endif
+
 			/**
 			 * 4x filtering, with blend support
 			 */
 			template<typename T, dword R_MASK, dword R_SHIFT, dword G_MASK, dword G_SHIFT, dword B_MASK, dword B_SHIFT, bool BLEND, bool ALL, bool SOME, bool NONE>
-			void Renderer::FilterxBR::Xbr4X(const Input& input,const Output& output)
+			void Renderer::FilterxBR::Xbr4X(const Input& input,const Output& output,const uint first,const uint last)
 			{
-				#pragma region Sets up pointers to source pixels
-
+				// Sets up pointers to source pixels
 				//Gets the pixels to filter. NST_RESTRICT tells the compiler to not alias
 				//the pointer.
 				const word* NST_RESTRICT src = input.pixels;
 
 				//Size of a raster line in output
+				byte* const pixels = static_cast<byte*>(output.pixels) + long(first) * 4 * output.pitch;
+
 				const long pitch = (output.pitch * 3) + output.pitch - (WIDTH*4 * sizeof(T));
 
 				//Creates a non-aliased array with four enteries. First is the destination pixels
@@ -268,21 +387,24 @@ namespace Nes
 				//points at the start of the next three lines. 
 				T* NST_RESTRICT dst[4] =
 				{
-					static_cast<T*>(output.pixels),
-					reinterpret_cast<T*>(static_cast<byte*>(output.pixels) + output.pitch),
-					reinterpret_cast<T*>(static_cast<byte*>(output.pixels) + output.pitch * 2),
-					reinterpret_cast<T*>(static_cast<byte*>(output.pixels) + output.pitch * 3)
+					reinterpret_cast<T*>(pixels),
+					reinterpret_cast<T*>(pixels + output.pitch),
+					reinterpret_cast<T*>(pixels + output.pitch * 2),
+					reinterpret_cast<T*>(pixels + output.pitch * 3)
 				};
 
 				//const long pad = output.pitch - long(sizeof(dword) * WIDTH);
 				const uint MAX_PIXELS = WIDTH * HEIGHT;
 
-				#pragma endregion
+				Lines lines;
 
-				for (int y=0; y < MAX_PIXELS; y += WIDTH)
+				for (int y=int(first * WIDTH); y < int(last * WIDTH); y += WIDTH)
 				{
-					#pragma region Clamps y coords
+					// Finds the flat pixels
+					Fetch( lines, input, y / WIDTH );
+					analyze( lines );
 
+					// Clamps y coords
 					int ym1 = y - WIDTH, ym2 = y - 2*WIDTH;
 					if (ym1 < 0) ym1 = y;
 					if (ym2 < 0) ym2 = y;
@@ -290,12 +412,24 @@ namespace Nes
 					if (y1 >= MAX_PIXELS) y1 = y;
 					if (y2 >= MAX_PIXELS) y2 = y;
 
-					#pragma endregion
-
 					for (int x=0; x < WIDTH; ++x, dst[0] += 4, dst[1] += 4, dst[2] += 4, dst[3] += 4)
 					{
-						#pragma region Clamps x coords
+						// Fills in flat pixels
+						if (lines.skip[x])
+						{
+							//No kernel would touch the block, every output pixel is the source pixel
+							const T color = (T) getPixel(lines.line[1][x+1]).rgb;
 
+							for (uint i=0; i < 4; ++i)
+							{
+								for (uint j=0; j < 4; ++j)
+									dst[i][j] = color;
+							}
+
+							continue;
+						}
+
+						// Clamps x coords
 						int xm1 = x - 1, xm2 = x - 2;
 						if (xm1 < 0) xm1 = 0;
 						if (xm2 < 0) xm1 = 0;
@@ -303,10 +437,7 @@ namespace Nes
 						if (x1 >= WIDTH) x1 = WIDTH - 1;
 						if (x2 >= WIDTH) x2 = WIDTH - 1;
 
-						#pragma endregion
-
-						#pragma region Fetches pixels and converts to YUV
-
+						// Fetches pixels and converts to YUV
 						//Result pixels
 						YUVPixel e0, e1, e2, e3, e4, e5, e6, e7, e8, e9, ea, eb, ec, ed, ee, ef;
 						
@@ -340,19 +471,13 @@ namespace Nes
 						h5 = getPixel(input.palette[src[x + y2]]);
 						i5 = getPixel(input.palette[src[x1 + y2]]);
 
-						#pragma endregion
-
-						#pragma region Filters pixel
-
+						// Filters pixel
 						Kernel4X<R_MASK, R_SHIFT, G_MASK, G_SHIFT, B_MASK, B_SHIFT, BLEND, ALL, SOME, NONE>(pe, pi, ph, pf, pg, pc, pd, pb, f4, i4, h5, i5, ef, ee, eb, e3, e7, ea, ed, ec);
 						Kernel4X<R_MASK, R_SHIFT, G_MASK, G_SHIFT, B_MASK, B_SHIFT, BLEND, ALL, SOME, NONE>(pe, pc, pf, pb, pi, pa, ph, pd, b1, c1, f4, c4, e3, e7, e2, e0, e1, e6, eb, ef);
 						Kernel4X<R_MASK, R_SHIFT, G_MASK, G_SHIFT, B_MASK, B_SHIFT, BLEND, ALL, SOME, NONE>(pe, pa, pb, pd, pc, pg, pf, ph, d0, a0, b1, a1, e0, e1, e4, ec, e8, e5, e2, e3);
 						Kernel4X<R_MASK, R_SHIFT, G_MASK, G_SHIFT, B_MASK, B_SHIFT, BLEND, ALL, SOME, NONE>(pe, pg, pd, ph, pa, pi, pb, pf, h5, g5, d0, g0, ec, e8, ed, ef, ee, e9, e4, e0);
 
-						#pragma endregion
-
-						#pragma region Writes out result
-
+						// Writes out result
 						//The result is 16 pixels (as the image is expanded by 4x)
 
 						dst[0][0] = (T) e0.rgb;
@@ -371,18 +496,13 @@ namespace Nes
 						dst[3][1] = (T) ed.rgb;
 						dst[3][2] = (T) ee.rgb;
 						dst[3][3] = (T) ef.rgb;
-
-						#pragma endregion
 					}
 
-					#pragma region Moves dest to the next next line.
-
+					// Moves dest to the next next line.
 					dst[0] = reinterpret_cast<T*>(reinterpret_cast<byte*>(dst[0]) + pitch);
 					dst[1] = reinterpret_cast<T*>(reinterpret_cast<byte*>(dst[1]) + pitch);
 					dst[2] = reinterpret_cast<T*>(reinterpret_cast<byte*>(dst[2]) + pitch);
 					dst[3] = reinterpret_cast<T*>(reinterpret_cast<byte*>(dst[3]) + pitch);
-
-					#pragma endregion
 				}
 			}
 
@@ -390,15 +510,16 @@ namespace Nes
 			 * 3x filtering, with blend support
 			 */
 			template<typename T, dword R_MASK, dword R_SHIFT, dword G_MASK, dword G_SHIFT, dword B_MASK, dword B_SHIFT, bool BLEND, bool ALL, bool SOME, bool NONE>
-			void Renderer::FilterxBR::Xbr3X(const Input& input,const Output& output)
+			void Renderer::FilterxBR::Xbr3X(const Input& input,const Output& output,const uint first,const uint last)
 			{
-				#pragma region Sets up pointers to source pixels
-
+				// Sets up pointers to source pixels
 				//Gets the pixels to filter. NST_RESTRICT tells the compiler to not alias
 				//the pointer.
 				const word* NST_RESTRICT src = input.pixels;
 
 				//Size of a raster line in output
+				byte* const pixels = static_cast<byte*>(output.pixels) + long(first) * 3 * output.pitch;
+
 				const long pitch = (output.pitch * 2) + output.pitch - (WIDTH*3 * sizeof(T));
 
 				//Creates a non-aliased array with three enteries. First is the destination pixels
@@ -406,20 +527,23 @@ namespace Nes
 				//points at the start of the next two lines.
 				T* NST_RESTRICT dst[3] =
 				{
-					static_cast<T*>(output.pixels),
-					reinterpret_cast<T*>(static_cast<byte*>(output.pixels) + output.pitch),
-					reinterpret_cast<T*>(static_cast<byte*>(output.pixels) + output.pitch * 2)
+					reinterpret_cast<T*>(pixels),
+					reinterpret_cast<T*>(pixels + output.pitch),
+					reinterpret_cast<T*>(pixels + output.pitch * 2)
 				};
 
 				//const long pad = output.pitch - long(sizeof(dword) * WIDTH);
 				const uint MAX_PIXELS = WIDTH * HEIGHT;
 
-				#pragma endregion
+				Lines lines;
 
-				for (int y=0; y < MAX_PIXELS; y += WIDTH)
+				for (int y=int(first * WIDTH); y < int(last * WIDTH); y += WIDTH)
 				{
-					#pragma region Clamps y coords
+					// Finds the flat pixels
+					Fetch( lines, input, y / WIDTH );
+					analyze( lines );
 
+					// Clamps y coords
 					int ym1 = y - WIDTH, ym2 = y - 2*WIDTH;
 					if (ym1 < 0) ym1 = y;
 					if (ym2 < 0) ym2 = y;
@@ -427,12 +551,24 @@ namespace Nes
 					if (y1 >= MAX_PIXELS) y1 = y;
 					if (y2 >= MAX_PIXELS) y2 = y;
 
-					#pragma endregion
-
 					for (int x=0; x < WIDTH; ++x, dst[0] += 3, dst[1] += 3, dst[2] += 3)
 					{
-						#pragma region Clamps x coords
+						// Fills in flat pixels
+						if (lines.skip[x])
+						{
+							//No kernel would touch the block, every output pixel is the source pixel
+							const T color = (T) getPixel(lines.line[1][x+1]).rgb;
 
+							for (uint i=0; i < 3; ++i)
+							{
+								for (uint j=0; j < 3; ++j)
+									dst[i][j] = color;
+							}
+
+							continue;
+						}
+
+						// Clamps x coords
 						int xm1 = x - 1, xm2 = x - 2;
 						if (xm1 < 0) xm1 = 0;
 						if (xm2 < 0) xm1 = 0;
@@ -440,10 +576,7 @@ namespace Nes
 						if (x1 >= WIDTH) x1 = WIDTH - 1;
 						if (x2 >= WIDTH) x2 = WIDTH - 1;
 
-						#pragma endregion
-
-						#pragma region Fetches pixels and converts to YUV
-
+						// Fetches pixels and converts to YUV
 						//Result pixels
 						YUVPixel e0, e1, e2, e3, e4, e5, e6, e7, e8;
 						
@@ -477,19 +610,13 @@ namespace Nes
 						h5 = getPixel(input.palette[src[x + y2]]);
 						i5 = getPixel(input.palette[src[x1 + y2]]);
 
-						#pragma endregion
-
-						#pragma region Filters pixel
-
+						// Filters pixel
 						Kernel3X<R_MASK, R_SHIFT, G_MASK, G_SHIFT, B_MASK, B_SHIFT, BLEND, ALL, SOME, NONE>(pe, pi, ph, pf, pg, pc, pd, pb, f4, i4, h5, i5, e2, e5, e6, e7, e8);
 						Kernel3X<R_MASK, R_SHIFT, G_MASK, G_SHIFT, B_MASK, B_SHIFT, BLEND, ALL, SOME, NONE>(pe, pc, pf, pb, pi, pa, ph, pd, b1, c1, f4, c4, e0, e1, e8, e5, e2);
 						Kernel3X<R_MASK, R_SHIFT, G_MASK, G_SHIFT, B_MASK, B_SHIFT, BLEND, ALL, SOME, NONE>(pe, pa, pb, pd, pc, pg, pf, ph, d0, a0, b1, a1, e6, e3, e2, e1, e0);
 						Kernel3X<R_MASK, R_SHIFT, G_MASK, G_SHIFT, B_MASK, B_SHIFT, BLEND, ALL, SOME, NONE>(pe, pg, pd, ph, pa, pi, pb, pf, h5, g5, d0, g0, e8, e7, e0, e3, e6);
 
-						#pragma endregion
-
-						#pragma region Writes out result
-
+						// Writes out result
 						//The result is nine pixels (as the image is expanded)
 
 						dst[0][0] = (T) e0.rgb;
@@ -501,17 +628,12 @@ namespace Nes
 						dst[2][0] = (T) e6.rgb;
 						dst[2][1] = (T) e7.rgb;
 						dst[2][2] = (T) e8.rgb;
-
-						#pragma endregion
 					}
 
-					#pragma region Moves dest to the next next line.
-
+					// Moves dest to the next next line.
 					dst[0] = reinterpret_cast<T*>(reinterpret_cast<byte*>(dst[0]) + pitch);
 					dst[1] = reinterpret_cast<T*>(reinterpret_cast<byte*>(dst[1]) + pitch);
 					dst[2] = reinterpret_cast<T*>(reinterpret_cast<byte*>(dst[2]) + pitch);
-
-					#pragma endregion
 				}
 			}
 
@@ -522,34 +644,37 @@ namespace Nes
 			 * Implements 2xBR
 			 */
 			template<typename T, dword R_MASK, dword R_SHIFT, dword G_MASK, dword G_SHIFT, dword B_MASK, dword B_SHIFT, bool BLEND, bool ALL, bool SOME, bool NONE>
-			void Renderer::FilterxBR::Xbr2X(const Input& input,const Output& output)
+			void Renderer::FilterxBR::Xbr2X(const Input& input,const Output& output,const uint first,const uint last)
 			{
-				#pragma region Sets up pointers to source pixels
-
+				// Sets up pointers to source pixels
 				//Gets the pixels to filter. NST_RESTRICT tells the compiler to not alias
 				//the pointer.
 				const word* NST_RESTRICT src = input.pixels;
 
 				//Size of a raster line in output
 				const long pitch = output.pitch;
+				byte* const pixels = static_cast<byte*>(output.pixels) + long(first) * 2 * pitch;
 
 				//Creates a non-aliased array with two enteries. First is the destination pixels
 				//cast into the type of pointer this function has been templated to use, the other
 				//points at the start of the next line.
 				T* NST_RESTRICT dst[2] =
 				{
-					static_cast<T*>(output.pixels),
-					reinterpret_cast<T*>(static_cast<byte*>(output.pixels) + pitch)
+					reinterpret_cast<T*>(pixels),
+					reinterpret_cast<T*>(pixels + pitch)
 				};
 				//const long pad = output.pitch - long(sizeof(dword) * WIDTH);
 				const uint MAX_PIXELS = WIDTH * HEIGHT;
 
-				#pragma endregion
+				Lines lines;
 
-				for (int y=0; y < MAX_PIXELS; y += WIDTH)
+				for (int y=int(first * WIDTH); y < int(last * WIDTH); y += WIDTH)
 				{
-					#pragma region Clamps y coords
+					// Finds the flat pixels
+					Fetch( lines, input, y / WIDTH );
+					analyze( lines );
 
+					// Clamps y coords
 					//Clamps y coords
 					int ym1 = y - WIDTH, ym2 = y - 2*WIDTH;
 					if (ym1 < 0) ym1 = y;
@@ -558,12 +683,24 @@ namespace Nes
 					if (y1 >= MAX_PIXELS) y1 = y;
 					if (y2 >= MAX_PIXELS) y2 = y;
 
-					#pragma endregion
-
 					for (int x=0; x < WIDTH; ++x, dst[0] += 2, dst[1] += 2)
 					{
-						#pragma region Clamps x coords
+						// Fills in flat pixels
+						if (lines.skip[x])
+						{
+							//No kernel would touch the block, every output pixel is the source pixel
+							const T color = (T) getPixel(lines.line[1][x+1]).rgb;
+
+							for (uint i=0; i < 2; ++i)
+							{
+								for (uint j=0; j < 2; ++j)
+									dst[i][j] = color;
+							}
 
+							continue;
+						}
+
+						// Clamps x coords
 						//Clamps x coords
 						int xm1 = x - 1, xm2 = x - 2;
 						if (xm1 < 0) xm1 = 0;
@@ -572,10 +709,7 @@ namespace Nes
 						if (x1 >= WIDTH) x1 = WIDTH - 1;
 						if (x2 >= WIDTH) x2 = WIDTH - 1;
 
-						#pragma endregion
-
-						#pragma region Fetches pixels and converts to YUV
-
+						// Fetches pixels and converts to YUV
 						//Result pixels
 						YUVPixel e0, e1, e2, e3;
 						
@@ -609,43 +743,46 @@ namespace Nes
 						h5 = getPixel(input.palette[src[x + y2]]);
 						i5 = getPixel(input.palette[src[x1 + y2]]);
 
-						#pragma endregion
-
-						#pragma region Filters pixel
-
+						// Filters pixel
 						Kernel2X<R_MASK, R_SHIFT, G_MASK, G_SHIFT, B_MASK, B_SHIFT, BLEND, ALL, SOME, NONE>(pe, pi, ph, pf, pg, pc, pd, pb, f4, i4, h5, i5, e1, e2, e3);
 						Kernel2X<R_MASK, R_SHIFT, G_MASK, G_SHIFT, B_MASK, B_SHIFT, BLEND, ALL, SOME, NONE>(pe, pc, pf, pb, pi, pa, ph, pd, b1, c1, f4, c4, e0, e3, e1);
 						Kernel2X<R_MASK, R_SHIFT, G_MASK, G_SHIFT, B_MASK, B_SHIFT, BLEND, ALL, SOME, NONE>(pe, pa, pb, pd, pc, pg, pf, ph, d0, a0, b1, a1, e2, e1, e0);
 						Kernel2X<R_MASK, R_SHIFT, G_MASK, G_SHIFT, B_MASK, B_SHIFT, BLEND, ALL, SOME, NONE>(pe, pg, pd, ph, pa, pi, pb, pf, h5, g5, d0, g0, e3, e0, e2);
 
-						#pragma endregion
-
-						#pragma region Writes out result
-
+						// Writes out result
 						dst[0][0] = (T) e0.rgb;
 						dst[0][1] = (T) e1.rgb;
 						dst[1][0] = (T) e2.rgb;
 						dst[1][1] = (T) e3.rgb;
-
-						#pragma endregion
 					}
 
-					#pragma region Moves dest to the next next line.
-
+					// Moves dest to the next next line.
 					dst[0] = reinterpret_cast<T*>(reinterpret_cast<byte*>(dst[1]) + (pitch - long(sizeof(T) * WIDTH*2)));
 					dst[1] = reinterpret_cast<T*>(reinterpret_cast<byte*>(dst[0]) + pitch);
-
-					#pragma endregion
 				}
 			}
 
 			void Renderer::FilterxBR::Blit(const Input& input,const Output& output,uint)
 			{
-				(*this.*path)( input, output );
+				(*this.*path)( input, output, 0, HEIGHT );
 			}
 
-			#pragma region Kernels
+			void Renderer::FilterxBR::BlitRows(const Input& input,const Output& output,uint,uint first,uint last)
+			{
+				(*this.*path)( input, output, first, last );
+			}
 
+			bool Renderer::FilterxBR::CanBlitRows() const
+			{
+				return true;
+			}
+
+			uint Renderer::FilterxBR::GetRowMargin() const
+			{
+				return 2;
+			}
+
+			// Kernels
 			template<dword R_MASK, dword R_SHIFT, dword G_MASK, dword G_SHIFT, dword B_MASK, dword B_SHIFT, bool BLEND, bool ALL, bool SOME, bool NONE>
 			void Renderer::FilterxBR::Kernel2X(YUVPixel pe, YUVPixel pi, YUVPixel ph, YUVPixel pf, YUVPixel pg, 
 				YUVPixel pc, YUVPixel pd, YUVPixel pb, YUVPixel f4, YUVPixel i4, YUVPixel h5, 
@@ -764,8 +901,6 @@ namespace Nes
 				}
 			}
 
-			#pragma endregion
-
 			void Renderer::FilterxBR::Transform(const byte (&src)[PALETTE][3],Input::Palette& dst) const
 			{
 				freeCache();
@@ -993,8 +1128,7 @@ namespace Nes
 				dst = getPixel(col);
 			}
 
-			#pragma region Pixel functions
-
+			// Pixel functions
 			//===========================
 			// Pixel functions
 			//===========================
@@ -1101,8 +1235,6 @@ namespace Nes
 			{
 				return rgb != px.rgb;
 			}
-
-			#pragma endregion
 		}
 	}
 }
@@ -41,7 +41,7 @@ namespace Nes
 			{
 			public:
 
-				explicit FilterxBR(const RenderState&, const bool blend, const schar corner_rounding);
+				FilterxBR(const RenderState&, const bool blend, const schar corner_rounding, const bool simd);
 
 				static bool Check(const RenderState&);
 
@@ -50,20 +50,37 @@ namespace Nes
 				void freeCache() const;
 				void initCache() const;
 
-				typedef void (FilterxBR::*Path)(const Input&,const Output&);
+				typedef void (FilterxBR::*Path)(const Input&,const Output&,uint,uint);
 				static Path GetPath(const RenderState&, const bool blend, const schar corner_rounding);
 
+				//Source lines around the current one, and which of its pixels have
+				//nothing to blend with
+				struct Lines;
+
+				typedef void (*Analyzer)(Lines&);
+				static Analyzer GetAnalyzer();
+				static void Analyze(Lines&);
+
+			#ifdef NST_MM_INTRINSICS
+				static void AnalyzeSse2(Lines&);
+			#endif
+
+				void Fetch(Lines&,const Input&,uint) const;
+
 				void Blit(const Input&,const Output&,uint);
+				void BlitRows(const Input&,const Output&,uint,uint,uint);
+				bool CanBlitRows() const;
+				uint GetRowMargin() const;
 				void Transform(const byte (&)[PALETTE][3],Input::Palette&) const;
 
 				template<typename T, dword R_MASK, dword R_SHIFT, dword G_MASK, dword G_SHIFT, dword B_MASK, dword B_SHIFT, bool BLEND, bool ALL, bool SOME, bool NONE>
-					void Xbr4X(const Input&,const Output&);
+					void Xbr4X(const Input&,const Output&,uint,uint);
 
 				template<typename T, dword R_MASK, dword R_SHIFT, dword G_MASK, dword G_SHIFT, dword B_MASK, dword B_SHIFT, bool BLEND, bool ALL, bool SOME, bool NONE>
-					void Xbr3X(const Input&,const Output&);
+					void Xbr3X(const Input&,const Output&,uint,uint);
 
 				template<typename T, dword R_MASK, dword R_SHIFT, dword G_MASK, dword G_SHIFT, dword B_MASK, dword B_SHIFT, bool BLEND, bool ALL, bool SOME, bool NONE> 
-					void Xbr2X(const Input&,const Output&);
+					void Xbr2X(const Input&,const Output&,uint,uint);
 
 				template<dword R_MASK, dword R_SHIFT, dword G_MASK, dword G_SHIFT, dword B_MASK, dword B_SHIFT, bool BLEND, bool ALL, bool SOME, bool NONE>
 				inline void Kernel2X(YUVPixel pe, YUVPixel pi, YUVPixel ph, YUVPixel pf, YUVPixel pg, 
@@ -151,6 +168,9 @@ namespace Nes
 
 				//Execution path
 				const Path path;
+
+				//Flat pixel detection, SSE2 when available
+				const Analyzer analyze;
 			};
 		}
 	}
@@ -35,9 +35,14 @@
 #include "NstCore.hpp"
 #include "NstAssert.hpp"
 #include "NstFpuPrecision.hpp"
-#include "api/NstApiVideo.hpp"
+#include "api/NstApiCallbacks.hpp"
 #include "NstVideoRenderer.hpp"
 #include "NstVideoFilterNone.hpp"
+#include "NstVideoBlitter.hpp"
+
+#if defined(NST_MM_INTRINSICS) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
 
 #ifndef NO_NTSC
 #include "NstVideoFilterNtsc.hpp"
@@ -524,6 +529,147 @@ namespace Nes
 				}
 			}
 
+			void Renderer::Filter::BlitRows(const Input&,const Output&,uint,uint,uint)
+			{
+				NST_UNREACHABLE();
+			}
+
+			bool Renderer::Filter::CanBlitRows() const
+			{
+				return false;
+			}
+
+			uint Renderer::Filter::GetRowMargin() const
+			{
+				return 0;
+			}
+
+			bool Renderer::Filter::UsesBurstPhase() const
+			{
+				return false;
+			}
+
+			void Renderer::Filter::BlitDirtyRows(const Input& input,const Output& output,const uint phase,uint first,const uint last,const byte* const rows)
+			{
+				NST_ASSERT( CanBlitRows() && last <= HEIGHT );
+
+				while (first < last)
+				{
+					if (rows[first])
+					{
+						uint next = first + 1;
+
+						while (next < last && rows[next])
+							++next;
+
+						BlitRows( input, output, phase, first, next );
+						first = next;
+					}
+					else
+					{
+						++first;
+					}
+				}
+			}
+
+			Renderer::DirtyRows::DirtyRows()
+			:
+			valid   (false),
+			phase   (0),
+			bgColor (0),
+			first   (0),
+			last    (0)
+			{}
+
+			bool Renderer::DirtyRows::Update(const Filter& filter,const Input& input,const Output& target,const uint burstPhase)
+			{
+				if
+				(
+					!valid ||
+					output.pixels != target.pixels ||
+					output.pitch != target.pitch ||
+					bgColor != filter.bgColor ||
+					(phase != burstPhase && filter.UsesBurstPhase())
+				)
+				{
+					// different surface or settings, nothing in it can be reused
+
+					valid = true;
+					output = target;
+					bgColor = filter.bgColor;
+					phase = burstPhase;
+
+					std::memcpy( pixels, input.pixels, sizeof(pixels) );
+					std::memset( rows, 1, sizeof(rows) );
+
+					first = 0;
+					last = HEIGHT;
+
+					return true;
+				}
+
+				phase = burstPhase;
+
+				const uint margin = filter.GetRowMargin();
+
+				std::memset( rows, 0, sizeof(rows) );
+				first = HEIGHT;
+				last = 0;
+
+				for (uint y=0; y < HEIGHT; ++y)
+				{
+					Input::Pixel* const NST_RESTRICT dst = pixels + y * WIDTH;
+					const Input::Pixel* const NST_RESTRICT src = input.pixels + y * WIDTH;
+
+					if (std::memcmp( dst, src, WIDTH * sizeof(Input::Pixel) ))
+					{
+						std::memcpy( dst, src, WIDTH * sizeof(Input::Pixel) );
+
+						// the filter reads this many rows above and below
+
+						const uint top = y > margin ? y - margin : 0;
+						const uint bottom = y + margin < HEIGHT ? y + margin + 1 : HEIGHT;
+
+						std::memset( rows + top, 1, bottom - top );
+
+						if (first > top)
+							first = top;
+
+						last = bottom;
+					}
+				}
+
+				if (first >= last)
+				{
+					first = last = 0;
+					return false;
+				}
+
+				if (!filter.CanBlitRows())
+				{
+					std::memset( rows, 1, sizeof(rows) );
+					first = 0;
+					last = HEIGHT;
+				}
+
+				return true;
+			}
+
+			bool Renderer::Filter::CanUseSse2()
+			{
+			#if !defined(NST_MM_INTRINSICS)
+				return false;
+			#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+				return true;
+			#elif defined(_MSC_VER)
+				int info[4];
+				__cpuid( info, 1 );
+				return info[3] & 0x04000000;
+			#else
+				return false;
+			#endif
+			}
+
 			Renderer::State::State()
 			:
 			width        (0),
@@ -548,16 +694,160 @@ namespace Nes
 				mask.b = 0;
 			}
 
-			Renderer::Renderer()
-			: filter(NULL) {}
+			Renderer::Renderer(const Api::Callbacks& c)
+			:
+			filter      (NULL),
+			callbacks   (c),
+			dirtyRows   (NULL),
+			simd        (true),
+			blitFirst   (0),
+			blitLast    (0)
+		#ifndef NST_NO_THREADS
+			,blitter     (NULL),
+			blitPending (false)
+		#endif
+			{}
 
 			Renderer::~Renderer()
 			{
+				FinishBlit();
+
+			#ifndef NST_NO_THREADS
+				delete blitter;
+			#endif
+
+				delete dirtyRows;
 				delete filter;
 			}
 
+			Result Renderer::SetBlitThreads(uint threads,bool async)
+			{
+				if (threads == 1 && !async)
+					threads = 0;
+
+				if (threads == GetBlitThreads() && (!threads || async == IsBlitAsync()))
+					return RESULT_NOP;
+
+			#ifdef NST_NO_THREADS
+
+				return RESULT_ERR_UNSUPPORTED;
+
+			#else
+
+				FinishBlit();
+
+				delete blitter;
+				blitter = NULL;
+
+				if (threads)
+				{
+					try
+					{
+						blitter = new Blitter( threads, async );
+					}
+					catch (Result result)
+					{
+						return result;
+					}
+					catch (const std::bad_alloc&)
+					{
+						return RESULT_ERR_OUT_OF_MEMORY;
+					}
+				}
+
+				return RESULT_OK;
+
+			#endif
+			}
+
+			uint Renderer::GetBlitThreads() const
+			{
+			#ifndef NST_NO_THREADS
+				if (blitter)
+					return blitter->NumThreads();
+			#endif
+				return 0;
+			}
+
+			bool Renderer::IsBlitAsync() const
+			{
+			#ifndef NST_NO_THREADS
+				if (blitter)
+					return blitter->IsAsync();
+			#endif
+				return false;
+			}
+
+			Result Renderer::EnableDirtyRows(bool enable)
+			{
+				if (enable == AreDirtyRowsEnabled())
+					return RESULT_NOP;
+
+				FinishBlit();
+
+				if (enable)
+				{
+					try
+					{
+						dirtyRows = new DirtyRows;
+					}
+					catch (const std::bad_alloc&)
+					{
+						return RESULT_ERR_OUT_OF_MEMORY;
+					}
+				}
+				else
+				{
+					delete dirtyRows;
+					dirtyRows = NULL;
+				}
+
+				return RESULT_OK;
+			}
+
+			Result Renderer::EnableSimd(bool enable)
+			{
+				if (enable == bool(simd))
+					return RESULT_NOP;
+
+				simd = enable;
+
+				if (filter)
+				{
+					RenderState renderState;
+					GetState( renderState );
+
+					FinishBlit();
+
+					delete filter;
+					filter = NULL;
+
+					return SetState( renderState );
+				}
+
+				return RESULT_OK;
+			}
+
+			void Renderer::InvalidateDirtyRows()
+			{
+				if (dirtyRows)
+					dirtyRows->Invalidate();
+			}
+
+			bool Renderer::GetDirtyRows(uint& first,uint& last) const
+			{
+				const uint scale = state.height / HEIGHT;
+
+				first = blitFirst * scale;
+				last = blitLast * scale;
+
+				return first < last;
+			}
+
 			Result Renderer::SetState(const RenderState& renderState)
 			{
+				FinishBlit();
+
 				if (filter)
 				{
 					if
@@ -604,7 +894,7 @@ namespace Nes
 						case RenderState::FILTER_HQ4X:
 
 							if (FilterHqX::Check( renderState ))
-								filter = new FilterHqX( renderState );
+								filter = new FilterHqX( renderState, simd );
 
 							break;
 
@@ -646,7 +936,7 @@ namespace Nes
 						case RenderState::FILTER_4XBR:
 
 							if (FilterxBR::Check( renderState ))
-								filter = new FilterxBR( renderState, state.blendPixels, state.xbr_corner_rounding );
+								filter = new FilterxBR( renderState, state.blendPixels, state.xbr_corner_rounding, simd );
 							break;
 					#endif
 					}
@@ -666,6 +956,8 @@ namespace Nes
 					state.height = renderState.height;
 					state.mask = renderState.bits.mask;
 
+					InvalidateDirtyRows();
+
 					if (state.filter == RenderState::FILTER_NTSC)
 						state.update = 0;
 					else
@@ -814,6 +1106,8 @@ namespace Nes
 				}
 
 				state.update = 0;
+
+				InvalidateDirtyRows();
 			}
 
 			#ifdef NST_MSVC_OPTIMIZE
@@ -824,22 +1118,87 @@ namespace Nes
 			{
 				if (filter)
 				{
+					FinishBlit();
+
 					if (state.update)
 						UpdateFilter( input );
 
-					if (Output::lockCallback( output ))
+					blitFirst = 0;
+					blitLast = 0;
+
+					if (callbacks.videoLock.Active()( output ))
 					{
 						NST_VERIFY( std::labs(output.pitch) >= dword(state.width) << (filter->format.bpp / 16) );
 						
 						filter->bgColor = bgColor;
 
+						const byte* rows = NULL;
+
 						if (std::labs(output.pitch) >= dword(state.width) << (filter->format.bpp / 16))
-							filter->Blit( input, output, burstPhase );
+						{
+							blitLast = HEIGHT;
+
+							if (dirtyRows)
+							{
+								if (dirtyRows->Update( *filter, input, output, burstPhase ))
+								{
+									rows = dirtyRows->GetRows();
+									blitFirst = dirtyRows->GetFirst();
+									blitLast = dirtyRows->GetLast();
+								}
+								else
+								{
+									// same picture as in the surface already
+									blitLast = 0;
+								}
+							}
+						}
+
+						if (blitFirst < blitLast)
+						{
+						#ifndef NST_NO_THREADS
+							if (blitter)
+							{
+								blitOutput = output;
+								blitter->Start( *filter, blitOutput, input, burstPhase, rows );
+
+								if (blitter->IsAsync())
+								{
+									// unlocked once the workers are done, see FinishBlit()
+									blitPending = true;
+									return;
+								}
+
+								blitter->Wait();
+							}
+							else
+						#endif
+							if (rows && filter->CanBlitRows())
+							{
+								filter->BlitDirtyRows( input, output, burstPhase, blitFirst, blitLast, rows );
+							}
+							else
+							{
+								filter->Blit( input, output, burstPhase );
+							}
+						}
 
-						Output::unlockCallback( output );
+						callbacks.videoUnlock.Active()( output );
 					}
 				}
 			}
+
+			void Renderer::FinishBlit()
+			{
+			#ifndef NST_NO_THREADS
+				if (blitPending)
+				{
+					blitPending = false;
+					blitter->Wait();
+					callbacks.videoUnlock.Active()( blitOutput );
+				}
+			#endif
+			}
 		}
 	}
 }
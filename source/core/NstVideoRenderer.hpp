@@ -35,6 +35,11 @@
 
 namespace Nes
 {
+	namespace Api
+	{
+		class Callbacks;
+	}
+
 	namespace Core
 	{
 		namespace Video
@@ -47,7 +52,7 @@ namespace Nes
 
 			public:
 
-				Renderer();
+				explicit Renderer(const Api::Callbacks&);
 				~Renderer();
 
 				enum PaletteType
@@ -74,6 +79,17 @@ namespace Nes
 				Result GetState(RenderState&) const;
 				Result SetHue(int);
 				void Blit(Output&,Input&,uint);
+				void FinishBlit();
+
+				Result SetBlitThreads(uint,bool);
+				uint   GetBlitThreads() const;
+				bool   IsBlitAsync() const;
+
+				Result EnableDirtyRows(bool);
+				void   InvalidateDirtyRows();
+				bool   GetDirtyRows(uint&,uint&) const;
+
+				Result EnableSimd(bool);
 
 				Result SetDecoder(const Decoder&);
 
@@ -179,6 +195,10 @@ namespace Nes
 				class FilterxBR;
 				#endif
 
+				#ifndef NST_NO_THREADS
+				class Blitter;
+				#endif
+
 				class NST_NO_VTABLE Filter
 				{
 					struct Format
@@ -194,13 +214,21 @@ namespace Nes
 
 					explicit Filter(const RenderState&);
 
+					static bool CanUseSse2();
+
 				public:
 
 					virtual ~Filter() {}
 
 					virtual void Blit(const Input&,const Output&,uint) = 0;
+					virtual void BlitRows(const Input&,const Output&,uint,uint,uint);
+					virtual bool CanBlitRows() const;
+					virtual uint GetRowMargin() const;
+					virtual bool UsesBurstPhase() const;
 					virtual void Transform(const byte (&)[PALETTE][3],Input::Palette&) const;
 
+					void BlitDirtyRows(const Input&,const Output&,uint,uint,uint,const byte*);
+
 					const Format format;
 					
 					uint bgColor;
@@ -239,11 +267,64 @@ namespace Nes
 					RenderState::Bits::Mask mask;
 				};
 
+				class DirtyRows
+				{
+				public:
+
+					DirtyRows();
+
+					bool Update(const Filter&,const Input&,const Output&,uint);
+
+				private:
+
+					ibool valid;
+					uint phase;
+					uint bgColor;
+					Output output;
+					word first;
+					word last;
+					byte rows[HEIGHT];
+					Input::Pixel pixels[PIXELS];
+
+				public:
+
+					void Invalidate()
+					{
+						valid = false;
+					}
+
+					const byte* GetRows() const
+					{
+						return rows;
+					}
+
+					uint GetFirst() const
+					{
+						return first;
+					}
+
+					uint GetLast() const
+					{
+						return last;
+					}
+				};
+
 				Result SetLevel(schar&,int,uint=State::UPDATE_PALETTE|State::UPDATE_FILTER);
 
 				Filter* filter;
 				State state;
 				Palette palette;
+				const Api::Callbacks& callbacks;
+				DirtyRows* dirtyRows;
+				ibool simd;
+				word blitFirst;
+				word blitLast;
+
+				#ifndef NST_NO_THREADS
+				Blitter* blitter;
+				Output blitOutput;
+				ibool blitPending;
+				#endif
 
 			public:
 
@@ -368,6 +449,16 @@ namespace Nes
 					return state.fieldMerging & uint(State::FIELD_MERGING_USER);
 				}
 
+				bool AreDirtyRowsEnabled() const
+				{
+					return dirtyRows != NULL;
+				}
+
+				bool IsSimdEnabled() const
+				{
+					return simd;
+				}
+
 				PaletteType GetPaletteType() const
 				{
 					return palette.GetType();
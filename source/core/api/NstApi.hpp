@@ -93,6 +93,8 @@ namespace Nes
 
 	namespace Api
 	{
+		class Callbacks;
+
 		class Base
 		{
 		public:
@@ -0,0 +1,93 @@
+////////////////////////////////////////////////////////////////////////////////////////
+//
+// Nestopia - NES/Famicom emulator written in C++
+//
+// Copyright (C) 2003-2008 Martin Freij
+//
+// This file is part of Nestopia.
+//
+// Nestopia is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// Nestopia is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Nestopia; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+////////////////////////////////////////////////////////////////////////////////////////
+
+
+#include "NstApiCallbacks.hpp"
+
+namespace Nes
+{
+	namespace Api
+	{
+		#ifdef NST_MSVC_OPTIMIZE
+		#pragma optimize("s", on)
+		#endif
+
+		const Callbacks Callbacks::defaults;
+
+		Callbacks::Callbacks()
+		:
+		machineEvent           ( Machine::eventCallback                ),
+		userEvent              ( User::eventCallback                   ),
+		userQuestion           ( User::questionCallback                ),
+		userFileIo             ( User::fileIoCallback                  ),
+		videoLock              ( Core::Video::Output::lockCallback     ),
+		videoUnlock            ( Core::Video::Output::unlockCallback   ),
+		soundLock              ( Core::Sound::Output::lockCallback     ),
+		soundUnlock            ( Core::Sound::Output::unlockCallback   ),
+		inputController        ( Input::controllerCallback             ),
+		inputAdapter           ( Input::adapterCallback                ),
+		cartridgeChooseProfile ( Cartridge::chooseProfileCallback      ),
+		rewinderState          ( Rewinder::stateCallback               ),
+		movieEvent             ( Movie::eventCallback                  ),
+		nsfEvent               ( Nsf::eventCallback                    ),
+		fdsDisk                ( Fds::diskCallback                     ),
+		fdsDrive               ( Fds::driveCallback                    ),
+		tapeRecorderEvent      ( TapeRecorder::eventCallback           ),
+		tracerBreak            ( Tracer::breakCallback                 )
+		{
+		}
+
+		Callbacks::Poll::Poll()
+		:
+		pad               ( Controllers::Pad::callback               ),
+		zapper            ( Controllers::Zapper::callback            ),
+		paddle            ( Controllers::Paddle::callback            ),
+		powerPad          ( Controllers::PowerPad::callback          ),
+		powerGlove        ( Controllers::PowerGlove::callback        ),
+		mouse             ( Controllers::Mouse::callback             ),
+		familyTrainer     ( Controllers::FamilyTrainer::callback     ),
+		familyKeyboard    ( Controllers::FamilyKeyboard::callback    ),
+		suborKeyboard     ( Controllers::SuborKeyboard::callback     ),
+		doremikkoKeyboard ( Controllers::DoremikkoKeyboard::callback ),
+		horiTrack         ( Controllers::HoriTrack::callback         ),
+		pachinko          ( Controllers::Pachinko::callback          ),
+		vsSystem          ( Controllers::VsSystem::callback          ),
+		oekaKidsTablet    ( Controllers::OekaKidsTablet::callback    ),
+		konamiHyperShot   ( Controllers::KonamiHyperShot::callback   ),
+		bandaiHyperShot   ( Controllers::BandaiHyperShot::callback   ),
+		crazyClimber      ( Controllers::CrazyClimber::callback      ),
+		mahjong           ( Controllers::Mahjong::callback           ),
+		excitingBoxing    ( Controllers::ExcitingBoxing::callback    ),
+		topRider          ( Controllers::TopRider::callback          ),
+		pokkunMoguraa     ( Controllers::PokkunMoguraa::callback     ),
+		partyTap          ( Controllers::PartyTap::callback          ),
+		karaokeStudio     ( Controllers::KaraokeStudio::callback     )
+		{
+		}
+
+		#ifdef NST_MSVC_OPTIMIZE
+		#pragma optimize("", on)
+		#endif
+	}
+}
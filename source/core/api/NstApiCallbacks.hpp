@@ -0,0 +1,197 @@
+////////////////////////////////////////////////////////////////////////////////////////
+//
+// Nestopia - NES/Famicom emulator written in C++
+//
+// Copyright (C) 2003-2008 Martin Freij
+//
+// This file is part of Nestopia.
+//
+// Nestopia is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// Nestopia is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Nestopia; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef NST_API_CALLBACKS_H
+#define NST_API_CALLBACKS_H
+
+#include "NstApiMachine.hpp"
+#include "NstApiUser.hpp"
+#include "NstApiVideo.hpp"
+#include "NstApiSound.hpp"
+#include "NstApiInput.hpp"
+#include "NstApiCartridge.hpp"
+#include "NstApiRewinder.hpp"
+#include "NstApiMovie.hpp"
+#include "NstApiNsf.hpp"
+#include "NstApiFds.hpp"
+#include "NstApiTapeRecorder.hpp"
+#include "NstApiTracer.hpp"
+
+#ifdef NST_PRAGMA_ONCE
+#pragma once
+#endif
+
+#if NST_MSVC >= 1200
+#pragma warning( push )
+#pragma warning( disable : 4512 )
+#endif
+
+namespace Nes
+{
+	namespace Api
+	{
+		/**
+		* Per-instance callbacks.
+		*
+		* Every emulator instance owns one set, reachable through Emulator::GetCallbacks().
+		* A callback set here is only invoked for its own instance and takes precedence
+		* over the matching static callback manager, e.g. Machine::eventCallback, which
+		* remains the default for instances that don't set their own. Instances that are
+		* run on separate threads should use these exclusively. User::logCallback is not
+		* part of the set and stays process-wide.
+		*/
+		class Callbacks
+		{
+			typedef Core::Input::Controllers Controllers;
+
+		public:
+
+			/**
+			* Per-instance callback manager.
+			*
+			* Falls back to the static manager it was bound to until Set() is called.
+			*/
+			template<typename T>
+			class Caller : public T
+			{
+				const T& global;
+				bool local;
+
+			public:
+
+				explicit Caller(const T& g)
+				: global(g), local(false) {}
+
+				/**
+				* Sets a callback for this instance only. Passing NULL silences
+				* the callback for this instance rather than restoring the default.
+				*
+				* @param function callback function or NULL
+				* @param userdata optional user data
+				*/
+				void Set(typename T::Function function,typename T::UserData userdata)
+				{
+					T::Set( function, userdata );
+					local = true;
+				}
+
+				/**
+				* Removes the instance callback and restores the static default.
+				*/
+				void Unset()
+				{
+					T::Unset();
+					local = false;
+				}
+
+				/**
+				* Checks if an instance callback has been set.
+				*
+				* @return true if set
+				*/
+				bool IsLocal() const
+				{
+					return local;
+				}
+
+				/**
+				* Returns the callback manager to invoke, used internally by the core.
+				*
+				* @return instance or static callback manager
+				*/
+				const T& Active() const
+				{
+					return local ? *this : global;
+				}
+			};
+
+			Callbacks();
+
+			/**
+			* Callback set used internally where no emulator instance is involved.
+			* Never set locally, always forwards to the static callback managers.
+			*/
+			static const Callbacks defaults;
+
+			Caller< Machine::EventCaller              > machineEvent;
+			Caller< User::EventCaller                 > userEvent;
+			Caller< User::QuestionCaller              > userQuestion;
+			Caller< User::FileIoCaller                > userFileIo;
+			Caller< Core::Video::Output::Locker       > videoLock;
+			Caller< Core::Video::Output::Unlocker     > videoUnlock;
+			Caller< Core::Sound::Output::Locker       > soundLock;
+			Caller< Core::Sound::Output::Unlocker     > soundUnlock;
+			Caller< Input::ControllerCaller           > inputController;
+			Caller< Input::AdapterCaller              > inputAdapter;
+			Caller< Cartridge::ChooseProfileCaller    > cartridgeChooseProfile;
+			Caller< Rewinder::StateCaller             > rewinderState;
+			Caller< Movie::EventCaller                > movieEvent;
+			Caller< Nsf::EventCaller                  > nsfEvent;
+			Caller< Fds::DiskCaller                   > fdsDisk;
+			Caller< Fds::DriveCaller                  > fdsDrive;
+			Caller< TapeRecorder::EventCaller         > tapeRecorderEvent;
+			Caller< Tracer::BreakCaller               > tracerBreak;
+
+			/**
+			* Per-instance controller poll callbacks.
+			*/
+			struct Poll
+			{
+				Poll();
+
+				Caller< Controllers::PollCaller2< Controllers::Pad               > > pad;
+				Caller< Controllers::PollCaller1< Controllers::Zapper            > > zapper;
+				Caller< Controllers::PollCaller1< Controllers::Paddle            > > paddle;
+				Caller< Controllers::PollCaller1< Controllers::PowerPad          > > powerPad;
+				Caller< Controllers::PollCaller1< Controllers::PowerGlove        > > powerGlove;
+				Caller< Controllers::PollCaller1< Controllers::Mouse             > > mouse;
+				Caller< Controllers::PollCaller1< Controllers::FamilyTrainer     > > familyTrainer;
+				Caller< Controllers::PollCaller3< Controllers::FamilyKeyboard    > > familyKeyboard;
+				Caller< Controllers::PollCaller3< Controllers::SuborKeyboard     > > suborKeyboard;
+				Caller< Controllers::PollCaller3< Controllers::DoremikkoKeyboard > > doremikkoKeyboard;
+				Caller< Controllers::PollCaller1< Controllers::HoriTrack         > > horiTrack;
+				Caller< Controllers::PollCaller1< Controllers::Pachinko          > > pachinko;
+				Caller< Controllers::PollCaller1< Controllers::VsSystem          > > vsSystem;
+				Caller< Controllers::PollCaller1< Controllers::OekaKidsTablet    > > oekaKidsTablet;
+				Caller< Controllers::PollCaller1< Controllers::KonamiHyperShot   > > konamiHyperShot;
+				Caller< Controllers::PollCaller1< Controllers::BandaiHyperShot   > > bandaiHyperShot;
+				Caller< Controllers::PollCaller1< Controllers::CrazyClimber      > > crazyClimber;
+				Caller< Controllers::PollCaller2< Controllers::Mahjong           > > mahjong;
+				Caller< Controllers::PollCaller2< Controllers::ExcitingBoxing    > > excitingBoxing;
+				Caller< Controllers::PollCaller1< Controllers::TopRider          > > topRider;
+				Caller< Controllers::PollCaller2< Controllers::PokkunMoguraa     > > pokkunMoguraa;
+				Caller< Controllers::PollCaller1< Controllers::PartyTap          > > partyTap;
+				Caller< Controllers::PollCaller1< Controllers::KaraokeStudio     > > karaokeStudio;
+			};
+
+			Poll poll;
+		};
+	}
+}
+
+#if NST_MSVC >= 1200
+#pragma warning( pop )
+#endif
+
+#endif
@@ -387,6 +387,27 @@ namespace Nes
 			return Create() ? emulator.imageDatabase->Load( baseStream, overloadStream ) : RESULT_ERR_OUT_OF_MEMORY;
 		}
 
+		Result Cartridge::Database::Load(const void* mem,ulong size) throw()
+		{
+			if (!mem || !size)
+				return RESULT_ERR_INVALID_PARAM;
+
+			return Create() ? emulator.imageDatabase->Load( mem, size ) : RESULT_ERR_OUT_OF_MEMORY;
+		}
+
+		Result Cartridge::Database::Load(const void* mem,ulong size,std::istream& overloadStream) throw()
+		{
+			if (!mem || !size)
+				return RESULT_ERR_INVALID_PARAM;
+
+			return Create() ? emulator.imageDatabase->Load( mem, size, overloadStream ) : RESULT_ERR_OUT_OF_MEMORY;
+		}
+
+		Result Cartridge::Database::Save(std::ostream& stream) const throw()
+		{
+			return emulator.imageDatabase ? emulator.imageDatabase->Save( stream ) : RESULT_ERR_NOT_READY;
+		}
+
 		void Cartridge::Database::Unload() throw()
 		{
 			if (emulator.imageDatabase)
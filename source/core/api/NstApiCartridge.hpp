@@ -50,6 +50,7 @@ namespace Nes
 		class Cartridge : public Base
 		{
 			struct ChooseProfileCaller;
+			friend class Callbacks;
 
 		public:
 
@@ -999,7 +1000,7 @@ namespace Nes
 				};
 
 				/**
-				* Resets and loads internal XML database.
+				* Resets and loads internal XML or compiled database.
 				*
 				* @param stream input stream
 				* @return result code
@@ -1007,14 +1008,46 @@ namespace Nes
 				Result Load(std::istream& stream) throw();
 
 				/**
-				* Resets and loads internal <b>and</b> external XML databases.
+				* Resets and loads internal <b>and</b> external databases.
 				*
-				* @param streamInternal input stream to internal XML database
+				* The internal one may be XML or compiled, the external one must be XML.
+				*
+				* @param streamInternal input stream to internal database
 				* @param streamExternal input stream to external XML database
 				* @return result code
 				*/
 				Result Load(std::istream& streamInternal,std::istream& streamExternal) throw();
 
+				/**
+				* Resets and loads internal compiled database from memory.
+				*
+				* The memory is used in place, typically a mapped file, and must stay valid
+				* until the database is unloaded or reloaded. Entries are only decoded when found.
+				*
+				* @param mem pointer to compiled database
+				* @param size size of compiled database
+				* @return result code
+				*/
+				Result Load(const void* mem,ulong size) throw();
+
+				/**
+				* Resets and loads internal compiled database from memory <b>and</b> external XML database.
+				*
+				* @param mem pointer to compiled database, must stay valid until unloaded
+				* @param size size of compiled database
+				* @param streamExternal input stream to external XML database
+				* @return result code
+				*/
+				Result Load(const void* mem,ulong size,std::istream& streamExternal) throw();
+
+				/**
+				* Writes the loaded XML databases in compiled form.
+				*
+				* @param stream output stream
+				* @return result code, RESULT_ERR_NOT_READY if nothing or a compiled database is loaded
+				*/
+				Result Save(std::ostream& stream) const throw();
+
 				/**
 				* Removes all databases from the system.
 				*/
@@ -36,6 +36,10 @@
 //
 // NST_DEBUG                 - Debug mode compilation.
 //
+// NST_TRACE                 - CPU instruction trace and breakpoints, see Api::Tracer.
+//                             Off by default, the Api::Tracer calls then fail with
+//                             RESULT_ERR_UNSUPPORTED.
+//
 // NST_PRAGMA_ONCE           - Define if #pragma once is supported. Auto-defined if
 //                             compiler is MCW or MSVC.
 //
@@ -50,7 +54,13 @@
 //
 // NST_MM_INTRINSICS         - For MMX/SSE compiler intrinsics support through
 //                             xmmintrin.h/emmintrin.h/mmintrin.h. Auto-defined if
-//                             compiler is Win32 MSVC and _M_IX86 is defined.
+//                             compiler is Win32 MSVC and _M_IX86 or _M_X64 is defined,
+//                             or if compiler is GCC and __SSE2__ is defined.
+//
+// NST_COMPUTED_GOTO         - For label address (&&label) and goto *ptr support. Lets the
+//                             CPU dispatch each opcode straight from the end of the previous
+//                             one instead of going through a single indirect call. Auto-defined
+//                             if compiler is GCC or Clang, unless NST_NO_COMPUTED_GOTO is defined.
 //
 // NST_CALL <attribute>      - Compiler/platform specific calling convention for non-member
 //                             functions. Placed between return type and function name, e.g
@@ -61,5 +61,22 @@ namespace Nes
 		{
 			return machine.tracker.Frame();
 		}
+
+		ulong Emulator::GetStateHash() const throw()
+		{
+			try
+			{
+				return machine.HashState();
+			}
+			catch (...)
+			{
+				return 0;
+			}
+		}
+
+		Callbacks& Emulator::GetCallbacks() throw()
+		{
+			return machine.callbacks;
+		}
 	}
 }
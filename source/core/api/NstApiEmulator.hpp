@@ -61,6 +61,8 @@ namespace Nes
 
 	namespace Api
 	{
+		class Callbacks;
+
 		/**
 		* Emulator object instance.
 		*/
@@ -93,6 +95,30 @@ namespace Nes
 			*/
 			ulong Frame() const throw();
 
+			/**
+			* Returns a hash of the current machine state.
+			*
+			* Covers the CPU, PPU and APU registers, CPU RAM, VRAM, OAM and the board
+			* state, that is, everything a save state would hold. The state is fed
+			* straight into a CRC as it's walked, nothing is buffered or compressed,
+			* so it's cheap enough to call once per frame. Two instances that have
+			* run the same inputs from the same state return the same value.
+			*
+			* @return hash or 0 if no game is running
+			*/
+			ulong GetStateHash() const throw();
+
+			/**
+			* Returns the callbacks of this instance.
+			*
+			* Callbacks set here only apply to this instance and take precedence over
+			* the static callback managers. Use these when running several instances
+			* concurrently.
+			*
+			* @return callbacks
+			*/
+			Callbacks& GetCallbacks() throw();
+
 		private:
 
 			Core::Machine& machine;
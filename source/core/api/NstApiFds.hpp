@@ -52,6 +52,7 @@ namespace Nes
 		{
 			struct DiskCaller;
 			struct DriveCaller;
+			friend class Callbacks;
 
 		public:
 
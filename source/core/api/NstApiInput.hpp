@@ -53,6 +53,8 @@ namespace Nes
 
 			class Controllers
 			{
+				friend class Api::Callbacks;
+
 				template<typename T>
 				struct PollCaller1 : UserCallback<typename T::PollCallback>
 				{
@@ -708,6 +710,7 @@ namespace Nes
 		{
 			struct ControllerCaller;
 			struct AdapterCaller;
+			friend class Callbacks;
 
 		public:
 
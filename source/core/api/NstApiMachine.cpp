@@ -23,9 +23,11 @@
 ////////////////////////////////////////////////////////////////////////////////////////
 
 #include <new>
+#include <cstring>
 #include "../NstMachine.hpp"
 #include "../NstImage.hpp"
 #include "../NstState.hpp"
+#include "../NstStreamMap.hpp"
 #include "NstApiMachine.hpp"
 
 namespace Nes
@@ -101,6 +103,59 @@ namespace Nes
 			return Load( stream, system, ask, &patch, Core::Image::UNKNOWN );
 		}
 
+		Result Machine::Load(const void* data,ulong size,FavoredSystem system,AskProfile ask,Patch* patch)
+		{
+			if (!data && size)
+				return RESULT_ERR_INVALID_PARAM;
+
+			Core::Stream::MemoryIn stream( data, size );
+			return Load( stream, system, ask, patch, Core::Image::UNKNOWN );
+		}
+
+		Result Machine::Load(const void* data,ulong size,FavoredSystem system,AskProfile ask) throw()
+		{
+			return Load( data, size, system, ask, NULL );
+		}
+
+		Result Machine::Load(const void* data,ulong size,FavoredSystem system,Patch& patch,AskProfile ask) throw()
+		{
+			return Load( data, size, system, ask, &patch );
+		}
+
+		Result Machine::Load(const char* path,FavoredSystem system,AskProfile ask,Patch* patch)
+		{
+			if (!path)
+				return RESULT_ERR_INVALID_PARAM;
+
+			try
+			{
+				const Core::Stream::FileMap file( path );
+				return Load( file.Data(), file.Size(), system, ask, patch );
+			}
+			catch (Result r)
+			{
+				return r;
+			}
+			catch (const std::bad_alloc&)
+			{
+				return RESULT_ERR_OUT_OF_MEMORY;
+			}
+			catch (...)
+			{
+				return RESULT_ERR_GENERIC;
+			}
+		}
+
+		Result Machine::Load(const char* path,FavoredSystem system,AskProfile ask) throw()
+		{
+			return Load( path, system, ask, NULL );
+		}
+
+		Result Machine::Load(const char* path,FavoredSystem system,Patch& patch,AskProfile ask) throw()
+		{
+			return Load( path, system, ask, &patch );
+		}
+
 		Result Machine::LoadCartridge(std::istream& stream,FavoredSystem system,AskProfile ask) throw()
 		{
 			return Load( stream, system, ask, NULL, Core::Image::CARTRIDGE );
@@ -275,6 +330,188 @@ namespace Nes
 			return RESULT_OK;
 		}
 
+		Result Machine::LoadState(const void* const data,const ulong length) throw()
+		{
+			if (!Is(GAME,ON) || IsLocked())
+				return RESULT_ERR_NOT_READY;
+
+			if (!data || !length)
+				return RESULT_ERR_INVALID_PARAM;
+
+			try
+			{
+				emulator.tracker.Resync();
+				Core::State::Loader loader( static_cast<const byte*>(data), length, true );
+
+				if (emulator.LoadState( loader, true ))
+					return RESULT_OK;
+				else
+					return RESULT_ERR_INVALID_CRC;
+			}
+			catch (Result result)
+			{
+				return result;
+			}
+			catch (const std::bad_alloc&)
+			{
+				return RESULT_ERR_OUT_OF_MEMORY;
+			}
+			catch (...)
+			{
+				return RESULT_ERR_GENERIC;
+			}
+		}
+
+		Result Machine::SaveState(void* const data,const ulong length) const throw()
+		{
+			if (!Is(GAME,ON))
+				return RESULT_ERR_NOT_READY;
+
+			if (!data)
+				return RESULT_ERR_INVALID_PARAM;
+
+			try
+			{
+				emulator.SaveState( static_cast<byte*>(data), length );
+			}
+			catch (Result result)
+			{
+				return result;
+			}
+			catch (const std::bad_alloc&)
+			{
+				return RESULT_ERR_OUT_OF_MEMORY;
+			}
+			catch (...)
+			{
+				return RESULT_ERR_GENERIC;
+			}
+
+			return RESULT_OK;
+		}
+
+		ulong Machine::GetStateSize() const throw()
+		{
+			if (!Is(GAME,ON))
+				return 0;
+
+			try
+			{
+				return emulator.GetStateSize();
+			}
+			catch (...)
+			{
+				return 0;
+			}
+		}
+
+		Machine::Snapshot::Snapshot() throw()
+		: data(NULL), size(0), capacity(0) {}
+
+		Machine::Snapshot::~Snapshot() throw()
+		{
+			delete [] data;
+		}
+
+		Result Machine::Snapshot::Reserve(const ulong length) throw()
+		{
+			if (length > capacity)
+			{
+				uchar* const next = new (std::nothrow) uchar [length];
+
+				if (!next)
+					return RESULT_ERR_OUT_OF_MEMORY;
+
+				if (size)
+					std::memcpy( next, data, size );
+
+				delete [] data;
+				data = next;
+				capacity = length;
+			}
+
+			return RESULT_OK;
+		}
+
+		Result Machine::SaveSnapshot(Snapshot& snapshot) const throw()
+		{
+			if (!Is(GAME,ON))
+				return RESULT_ERR_NOT_READY;
+
+			try
+			{
+				snapshot.size = 0;
+
+				for (uint retry=0;; ++retry)
+				{
+					if (NES_FAILED(snapshot.Reserve( emulator.GetStateSize() )))
+						return RESULT_ERR_OUT_OF_MEMORY;
+
+					try
+					{
+						snapshot.size = emulator.SaveState( snapshot.data, snapshot.capacity );
+						break;
+					}
+					catch (Result result)
+					{
+						// cached size was stale, measured again on the next pass
+
+						if (result != RESULT_ERR_OUT_OF_MEMORY || retry)
+							throw;
+					}
+				}
+			}
+			catch (Result result)
+			{
+				snapshot.size = 0;
+				return result;
+			}
+			catch (const std::bad_alloc&)
+			{
+				snapshot.size = 0;
+				return RESULT_ERR_OUT_OF_MEMORY;
+			}
+			catch (...)
+			{
+				snapshot.size = 0;
+				return RESULT_ERR_GENERIC;
+			}
+
+			return RESULT_OK;
+		}
+
+		Result Machine::LoadSnapshot(const Snapshot& snapshot) throw()
+		{
+			if (!Is(GAME,ON) || IsLocked())
+				return RESULT_ERR_NOT_READY;
+
+			if (!snapshot.size)
+				return RESULT_ERR_INVALID_PARAM;
+
+			try
+			{
+				emulator.tracker.Resync();
+				Core::State::Loader loader( snapshot.data, snapshot.size, true );
+
+				if (emulator.LoadState( loader, true ))
+					return RESULT_OK;
+				else
+					return RESULT_ERR_INVALID_CRC;
+			}
+			catch (Result result)
+			{
+				return result;
+			}
+			catch (const std::bad_alloc&)
+			{
+				return RESULT_ERR_OUT_OF_MEMORY;
+			}
+			catch (...)
+			{
+				return RESULT_ERR_GENERIC;
+			}
+		}
+
 		#ifdef NST_MSVC_OPTIMIZE
 		#pragma optimize("", on)
 		#endif
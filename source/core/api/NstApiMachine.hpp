@@ -50,6 +50,7 @@ namespace Nes
 		class Machine : public Base
 		{
 			struct EventCaller;
+			friend class Callbacks;
 
 		public:
 
@@ -194,6 +195,56 @@ namespace Nes
 			*/
 			Result Load(std::istream& stream,FavoredSystem system,Patch& patch,AskProfile askProfile=DONT_ASK_PROFILE) throw();
 
+			/**
+			* Loads any image from memory. Same formats as for streams.
+			*
+			* The image is parsed in place without being copied into a stream first,
+			* the memory only needs to stay valid during the call.
+			*
+			* @param data image data
+			* @param size size of the image data in bytes
+			* @param system console to emulate if the core can't do automatic detection
+			* @param askProfile to allow callback triggering if the image has multiple media profiles, default is false
+			* @return result code
+			*/
+			Result Load(const void* data,ulong size,FavoredSystem system,AskProfile askProfile=DONT_ASK_PROFILE) throw();
+
+			/**
+			* Loads any image from memory. Same formats as for streams.
+			*
+			* @param data image data
+			* @param size size of the image data in bytes
+			* @param system console to emulate if the core can't do automatic detection
+			* @param patch object for performing soft-patching on the image
+			* @param askProfile to allow callback triggering if the image has multiple media profiles, default is false
+			* @return result code
+			*/
+			Result Load(const void* data,ulong size,FavoredSystem system,Patch& patch,AskProfile askProfile=DONT_ASK_PROFILE) throw();
+
+			/**
+			* Loads any image from a file. Same formats as for streams.
+			*
+			* The file is memory mapped for the duration of the call where the platform
+			* allows it, otherwise read in one go.
+			*
+			* @param path file path
+			* @param system console to emulate if the core can't do automatic detection
+			* @param askProfile to allow callback triggering if the image has multiple media profiles, default is false
+			* @return result code
+			*/
+			Result Load(const char* path,FavoredSystem system,AskProfile askProfile=DONT_ASK_PROFILE) throw();
+
+			/**
+			* Loads any image from a file. Same formats as for streams.
+			*
+			* @param path file path
+			* @param system console to emulate if the core can't do automatic detection
+			* @param patch object for performing soft-patching on the image
+			* @param askProfile to allow callback triggering if the image has multiple media profiles, default is false
+			* @return result code
+			*/
+			Result Load(const char* path,FavoredSystem system,Patch& patch,AskProfile askProfile=DONT_ASK_PROFILE) throw();
+
 			/**
 			* Loads a cartridge image. Input stream can be in XML, iNES or UNIF format.
 			*
@@ -318,6 +369,106 @@ namespace Nes
 			*/
 			Result SaveState(std::ostream& stream,Compression compression=USE_COMPRESSION) const throw();
 
+			/**
+			* Loads an uncompressed state from memory.
+			*
+			* @param data state
+			* @param length size of state in bytes
+			* @return result code
+			*/
+			Result LoadState(const void* data,ulong length) throw();
+
+			/**
+			* Saves an uncompressed state directly into memory.
+			*
+			* The state is identical to one written by SaveState() with NO_COMPRESSION.
+			*
+			* @param data buffer which the state will be written to
+			* @param length size of buffer in bytes, at least GetStateSize()
+			* @return result code, RESULT_ERR_OUT_OF_MEMORY if the buffer is too small
+			*/
+			Result SaveState(void* data,ulong length) const throw();
+
+			/**
+			* Returns the exact size of an uncompressed state.
+			*
+			* The size is cached and only measured again after the machine has been
+			* loaded, reset or had its input devices changed.
+			*
+			* @return size in bytes, 0 if no game is running
+			*/
+			ulong GetStateSize() const throw();
+
+			/**
+			* In-memory machine snapshot.
+			*
+			* Holds an uncompressed state in a flat buffer that is allocated on the first
+			* save and reused by subsequent ones, intended for branching thousands of times
+			* per second. A snapshot may be loaded into any instance running the same image,
+			* which is how a running machine is cloned. The layout is internal and may change
+			* between versions, use SaveState() for anything stored on disk.
+			*/
+			class Snapshot
+			{
+				friend class Machine;
+
+				uchar* data;
+				ulong size;
+				ulong capacity;
+
+				Snapshot(const Snapshot&);
+				void operator = (const Snapshot&);
+
+			public:
+
+				Snapshot() throw();
+				~Snapshot() throw();
+
+				/**
+				* Preallocates the buffer.
+				*
+				* @param length size in bytes
+				* @return result code
+				*/
+				Result Reserve(ulong length) throw();
+
+				/**
+				* Returns the size of the held state.
+				*
+				* @return size in bytes, 0 if empty
+				*/
+				ulong Size() const throw()
+				{
+					return size;
+				}
+
+				/**
+				* Returns the size of the allocated buffer.
+				*
+				* @return size in bytes
+				*/
+				ulong Capacity() const throw()
+				{
+					return capacity;
+				}
+			};
+
+			/**
+			* Saves the current state into a snapshot.
+			*
+			* @param snapshot snapshot which the state will be written to
+			* @return result code
+			*/
+			Result SaveSnapshot(Snapshot& snapshot) const throw();
+
+			/**
+			* Restores a state from a snapshot.
+			*
+			* @param snapshot snapshot previously filled by SaveSnapshot()
+			* @return result code
+			*/
+			Result LoadSnapshot(const Snapshot& snapshot) throw();
+
 			/**
 			* Returns a machine state.
 			*
@@ -409,6 +560,8 @@ namespace Nes
 		private:
 
 			Result Load(std::istream&,FavoredSystem,AskProfile,Patch*,uint);
+			Result Load(const void*,ulong,FavoredSystem,AskProfile,Patch*);
+			Result Load(const char*,FavoredSystem,AskProfile,Patch*);
 		};
 
 		/**
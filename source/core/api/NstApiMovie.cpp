@@ -52,6 +52,26 @@ namespace Nes
 			emulator.tracker.StopMovie();
 		}
 
+		Result Movie::Seek(ulong frame) throw()
+		{
+			return emulator.tracker.SeekMovie( emulator, frame );
+		}
+
+		ulong Movie::GetFrame() const throw()
+		{
+			return emulator.tracker.GetMovieFrame();
+		}
+
+		void Movie::EnableStateHashes(bool enable) throw()
+		{
+			emulator.tracker.EnableMovieHashes( enable );
+		}
+
+		bool Movie::AreStateHashesEnabled() const throw()
+		{
+			return emulator.tracker.AreMovieHashesEnabled();
+		}
+
 		bool Movie::IsPlaying() const throw()
 		{
 			return emulator.tracker.IsMoviePlaying();
@@ -50,6 +50,7 @@ namespace Nes
 		class Movie : public Base
 		{
 			struct EventCaller;
+			friend class Callbacks;
 
 		public:
 
@@ -99,6 +100,45 @@ namespace Nes
 			*/
 			void Stop() throw();
 
+			/**
+			* Moves a playing movie to a frame.
+			*
+			* The machine state is restored from the nearest keyframe before it and the
+			* remaining frames are emulated without video and sound. Movies recorded before
+			* keyframes were added seek to the states saved on resets and power cycles.
+			*
+			* @param frame frame number counted from the start of the movie
+			* @return result code, RESULT_ERR_INVALID_PARAM if past the end of the movie
+			*/
+			Result Seek(ulong frame) throw();
+
+			/**
+			* Returns the number of frames played or recorded.
+			*
+			* @return frame number, 0 if stopped
+			*/
+			ulong GetFrame() const throw();
+
+			/**
+			* Enables per-frame state hashes.
+			*
+			* Movies recorded with this enabled store a hash of the machine state, as
+			* returned by Emulator::GetStateHash(), for every frame. Movies played with
+			* it enabled have each frame checked against the stored hashes, if any, and
+			* EVENT_PLAYING_DESYNC is sent for the first one that differs. Takes effect
+			* the next time a movie is played or recorded.
+			*
+			* @param state true to enable
+			*/
+			void EnableStateHashes(bool state=true) throw();
+
+			/**
+			* Checks if per-frame state hashes are enabled.
+			*
+			* @return true if enabled
+			*/
+			bool AreStateHashesEnabled() const throw();
+
 			/**
 			* Ejects movie.
 			*
@@ -147,12 +187,17 @@ namespace Nes
 				/**
 				* Movie has stopped recording.
 				*/
-				EVENT_RECORDING_STOPPED
+				EVENT_RECORDING_STOPPED,
+				/**
+				* Machine state no longer matches the one recorded. Sent once, for the first
+				* frame that differs, which GetFrame() returns during the callback.
+				*/
+				EVENT_PLAYING_DESYNC
 			};
 
 			enum
 			{
-				NUM_EVENT_CALLBACKS = 4
+				NUM_EVENT_CALLBACKS = 5
 			};
 
 			/**
@@ -49,6 +49,7 @@ namespace Nes
 		class Nsf : public Base
 		{
 			struct EventCaller;
+			friend class Callbacks;
 
 		public:
 
@@ -90,6 +90,59 @@ namespace Nes
 			return RESULT_ERR_NOT_READY;
 		}
 
+		Result Rewinder::SetStorage(Storage storage,uint seconds,ulong budget) throw()
+		{
+			if (seconds < MIN_SECONDS || budget > 0xFFFFFFFF)
+				return RESULT_ERR_INVALID_PARAM;
+
+			if
+			(
+				bool(storage == DELTA_STATES) == emulator.tracker.IsRewinderUsingDeltas() &&
+				seconds == emulator.tracker.NumRewinderKeys() &&
+				budget == emulator.tracker.GetRewinderBudget()
+			)
+				return RESULT_NOP;
+
+			try
+			{
+				emulator.tracker.SetRewinderStorage( storage == DELTA_STATES, seconds, budget );
+			}
+			catch (Result result)
+			{
+				return result;
+			}
+			catch (const std::bad_alloc&)
+			{
+				return RESULT_ERR_OUT_OF_MEMORY;
+			}
+			catch (...)
+			{
+				return RESULT_ERR_GENERIC;
+			}
+
+			return RESULT_OK;
+		}
+
+		Rewinder::Storage Rewinder::GetStorage() const throw()
+		{
+			return emulator.tracker.IsRewinderUsingDeltas() ? DELTA_STATES : FULL_STATES;
+		}
+
+		uint Rewinder::GetSeconds() const throw()
+		{
+			return emulator.tracker.NumRewinderKeys();
+		}
+
+		ulong Rewinder::GetMemoryBudget() const throw()
+		{
+			return emulator.tracker.GetRewinderBudget();
+		}
+
+		ulong Rewinder::GetMemoryUsage() const throw()
+		{
+			return emulator.tracker.GetRewinderMemoryUsage();
+		}
+
 		void Rewinder::Reset() throw()
 		{
 			if (emulator.Is(Machine::GAME,Machine::ON))
@@ -49,6 +49,7 @@ namespace Nes
 		class Rewinder : public Base
 		{
 			struct StateCaller;
+			friend class Callbacks;
 
 		public:
 
@@ -110,6 +111,77 @@ namespace Nes
 			*/
 			bool IsSoundEnabled() const throw();
 
+			/**
+			* Key storage.
+			*/
+			enum Storage
+			{
+				/**
+				* Full state per key (default).
+				*/
+				FULL_STATES,
+				/**
+				* Newest state in full, older keys as run-length encoded XOR deltas against the next one.
+				*/
+				DELTA_STATES
+			};
+
+			enum
+			{
+				/**
+				* Default number of keys.
+				*/
+				DEFAULT_SECONDS = 60,
+				/**
+				* Minimum number of keys.
+				*/
+				MIN_SECONDS = 2
+			};
+
+			/**
+			* Sets how far back the rewinder reaches and how the states are stored.
+			*
+			* A key is taken every 60 frames, roughly a second of play. Deltas make long
+			* windows affordable since consecutive states mostly differ in a few RAM bytes.
+			* Once the budget is exceeded the oldest keys are dropped, shortening the window.
+			* The last two keys are always kept, so a budget below a few states has no effect.
+			* Changing the storage resets the rewinder.
+			*
+			* @param storage FULL_STATES or DELTA_STATES
+			* @param seconds maximum number of keys, at least MIN_SECONDS
+			* @param budget memory budget in bytes for the stored keys, 0 for no limit
+			* @return result code
+			*/
+			Result SetStorage(Storage storage,uint seconds=DEFAULT_SECONDS,ulong budget=0) throw();
+
+			/**
+			* Returns the current key storage.
+			*
+			* @return FULL_STATES or DELTA_STATES
+			*/
+			Storage GetStorage() const throw();
+
+			/**
+			* Returns the maximum number of keys.
+			*
+			* @return number of keys
+			*/
+			uint GetSeconds() const throw();
+
+			/**
+			* Returns the memory budget.
+			*
+			* @return budget in bytes, 0 if unlimited
+			*/
+			ulong GetMemoryBudget() const throw();
+
+			/**
+			* Returns the memory currently held by the stored keys and working buffers.
+			*
+			* @return size in bytes
+			*/
+			ulong GetMemoryUsage() const throw();
+
 			/**
 			* Sets direction.
 			*
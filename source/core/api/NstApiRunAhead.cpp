@@ -0,0 +1,94 @@
+////////////////////////////////////////////////////////////////////////////////////////
+//
+// Nestopia - NES/Famicom emulator written in C++
+//
+// Copyright (C) 2003-2008 Martin Freij
+//
+// This file is part of Nestopia.
+//
+// Nestopia is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// Nestopia is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Nestopia; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+////////////////////////////////////////////////////////////////////////////////////////
+
+#include <new>
+#include "../NstMachine.hpp"
+#include "NstApiMachine.hpp"
+#include "NstApiRunAhead.hpp"
+
+namespace Nes
+{
+	namespace Api
+	{
+		#ifdef NST_MSVC_OPTIMIZE
+		#pragma optimize("s", on)
+		#endif
+
+		Result RunAhead::SetFrames(uint frames,Mode mode) throw()
+		{
+			if (frames > MAX_FRAMES || (mode != RERUN && mode != PREEMPTIVE))
+				return RESULT_ERR_INVALID_PARAM;
+
+			if
+			(
+				frames == emulator.tracker.NumRunAheadFrames() &&
+				bool(mode == PREEMPTIVE) == emulator.tracker.IsRunAheadPreemptive()
+			)
+				return RESULT_NOP;
+
+			try
+			{
+				emulator.tracker.SetRunAhead( emulator, frames, mode == PREEMPTIVE );
+			}
+			catch (Result result)
+			{
+				return result;
+			}
+			catch (const std::bad_alloc&)
+			{
+				return RESULT_ERR_OUT_OF_MEMORY;
+			}
+			catch (...)
+			{
+				return RESULT_ERR_GENERIC;
+			}
+
+			return RESULT_OK;
+		}
+
+		uint RunAhead::GetFrames() const throw()
+		{
+			return emulator.tracker.NumRunAheadFrames();
+		}
+
+		RunAhead::Mode RunAhead::GetMode() const throw()
+		{
+			return emulator.tracker.IsRunAheadPreemptive() ? PREEMPTIVE : RERUN;
+		}
+
+		bool RunAhead::IsEnabled() const throw()
+		{
+			return emulator.tracker.NumRunAheadFrames();
+		}
+
+		ulong RunAhead::NumRollbacks() const throw()
+		{
+			return emulator.tracker.NumRunAheadRollbacks();
+		}
+
+		#ifdef NST_MSVC_OPTIMIZE
+		#pragma optimize("", on)
+		#endif
+	}
+}
@@ -0,0 +1,142 @@
+////////////////////////////////////////////////////////////////////////////////////////
+//
+// Nestopia - NES/Famicom emulator written in C++
+//
+// Copyright (C) 2003-2008 Martin Freij
+//
+// This file is part of Nestopia.
+//
+// Nestopia is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// Nestopia is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Nestopia; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef NST_API_RUNAHEAD_H
+#define NST_API_RUNAHEAD_H
+
+#include "NstApi.hpp"
+
+#ifdef NST_PRAGMA_ONCE
+#pragma once
+#endif
+
+#if NST_ICC >= 810
+#pragma warning( push )
+#pragma warning( disable : 304 444 )
+#elif NST_MSVC >= 1200
+#pragma warning( push )
+#pragma warning( disable : 4512 )
+#endif
+
+namespace Nes
+{
+	namespace Api
+	{
+		/**
+		* Run-ahead interface.
+		*
+		* Hides input latency by presenting a frame that lies a few frames ahead of
+		* the emulated machine. Every frame passed to Emulator::Execute() then costs
+		* additional emulated frames and in-memory states, see Mode for the trade-offs.
+		* Run-ahead is bypassed while the rewinder is enabled or a movie is active.
+		*/
+		class RunAhead : public Base
+		{
+		public:
+
+			/**
+			* Interface constructor.
+			*
+			* @param instance emulator instance
+			*/
+			template<typename T>
+			RunAhead(T& instance)
+			: Base(instance) {}
+
+			/**
+			* Run-ahead mode.
+			*/
+			enum Mode
+			{
+				/**
+				* Each frame runs the machine one frame with sound, saves a state, runs
+				* the remaining frames hidden with the last one shown and loads the state
+				* back. Costs frames+1 emulated frames, a save and a load per call.
+				*/
+				RERUN,
+				/**
+				* The machine is kept the given number of frames ahead, assuming the input
+				* stays the same. A state per frame in flight is kept and only rolled back
+				* and replayed when the input passed in differs from the previous call.
+				* Costs one emulated frame and a save per call while the input is steady.
+				* Input fed through the poll callbacks instead of the controllers passed
+				* to Emulator::Execute() is not compared and should use RERUN.
+				*/
+				PREEMPTIVE
+			};
+
+			enum
+			{
+				/**
+				* Maximum number of frames to run ahead.
+				*/
+				MAX_FRAMES = 8
+			};
+
+			/**
+			* Sets the number of frames to run ahead.
+			*
+			* @param frames number of frames, 0 to disable, at most MAX_FRAMES
+			* @param mode RERUN or PREEMPTIVE
+			* @return result code
+			*/
+			Result SetFrames(uint frames,Mode mode=RERUN) throw();
+
+			/**
+			* Returns the number of frames to run ahead.
+			*
+			* @return number of frames, 0 if disabled
+			*/
+			uint GetFrames() const throw();
+
+			/**
+			* Returns the run-ahead mode.
+			*
+			* @return RERUN or PREEMPTIVE
+			*/
+			Mode GetMode() const throw();
+
+			/**
+			* Checks if run-ahead is enabled.
+			*
+			* @return true if enabled
+			*/
+			bool IsEnabled() const throw();
+
+			/**
+			* Returns the number of rollbacks since run-ahead was enabled. Only grows
+			* in PREEMPTIVE mode, where each one means the input had changed.
+			*
+			* @return number of rollbacks
+			*/
+			ulong NumRollbacks() const throw();
+		};
+	}
+}
+
+#if NST_MSVC >= 1200 || NST_ICC >= 810
+#pragma warning( pop )
+#endif
+
+#endif
@@ -92,6 +92,21 @@ namespace Nes
 			emulator.cpu.GetApu().EnableStereo( speaker == SPEAKER_STEREO );
 		}
 
+		void Sound::SetSynthesis(Synthesis synthesis) throw()
+		{
+			emulator.cpu.GetApu().EnableBandLimiting( synthesis == SYNTHESIS_BANDLIMITED );
+		}
+
+		void Sound::EnableRateControl(bool enable) throw()
+		{
+			emulator.cpu.GetApu().EnableRateControl( enable );
+		}
+
+		uint Sound::UpdateRateControl(ulong queued,ulong target) throw()
+		{
+			return emulator.cpu.GetApu().UpdateRateControl( NST_MIN(queued,0xFFFFFFFF), NST_MIN(target,0xFFFFFFFF) );
+		}
+
 		ulong Sound::GetSampleRate() const throw()
 		{
 			return emulator.cpu.GetApu().GetSampleRate();
@@ -142,6 +157,16 @@ namespace Nes
 			return emulator.cpu.GetApu().InStereo() ? SPEAKER_STEREO : SPEAKER_MONO;
 		}
 
+		bool Sound::IsRateControlEnabled() const throw()
+		{
+			return emulator.cpu.GetApu().IsRateControlled();
+		}
+
+		Sound::Synthesis Sound::GetSynthesis() const throw()
+		{
+			return emulator.cpu.GetApu().IsBandLimiting() ? SYNTHESIS_BANDLIMITED : SYNTHESIS_SAMPLED;
+		}
+
 		void Sound::EmptyBuffer() throw()
 		{
 			emulator.cpu.GetApu().ClearBuffers();
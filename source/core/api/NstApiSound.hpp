@@ -52,6 +52,7 @@ namespace Nes
 			{
 				struct Locker;
 				struct Unlocker;
+				friend class Api::Callbacks;
 
 			public:
 
@@ -249,6 +250,21 @@ namespace Nes
 				SPEAKER_STEREO
 			};
 
+			/**
+			* Synthesis engine.
+			*/
+			enum Synthesis
+			{
+				/**
+				* Oscillators evaluated once per output sample (default).
+				*/
+				SYNTHESIS_SAMPLED,
+				/**
+				* Amplitude changes recorded at their exact CPU cycle into a band-limited step buffer.
+				*/
+				SYNTHESIS_BANDLIMITED
+			};
+
 			enum
 			{
 				DEFAULT_VOLUME = 85,
@@ -262,7 +278,7 @@ namespace Nes
 			/**
 			* Sets the sample rate.
 			*
-			* @param rate value in the range 11025 to 96000, default is 44100
+			* @param rate value in the range 11025 to 192000, default is 44100
 			* @return result code
 			*/
 			Result SetSampleRate(ulong rate) throw();
@@ -303,6 +319,57 @@ namespace Nes
 			*/
 			Speaker GetSpeaker() const throw();
 
+			/**
+			* Sets the synthesis engine.
+			*
+			* The band-limited engine only does work when a channel changes level, so its
+			* cost hardly depends on the sample rate. It covers the NES APU channels; games
+			* with an external sound chip keep using the sampled engine. Automatic
+			* transposition has no effect on it.
+			*
+			* @param synthesis synthesis engine, default is SYNTHESIS_SAMPLED
+			*/
+			void SetSynthesis(Synthesis synthesis) throw();
+
+			/**
+			* Returns the synthesis engine.
+			*
+			* @return synthesis engine
+			*/
+			Synthesis GetSynthesis() const throw();
+
+			/**
+			* Enables dynamic rate control.
+			*
+			* Lets the sample rate drift by up to half a percent so that a frontend locked to the
+			* display refresh rate can keep its audio queue at a steady fill level without dropping
+			* or repeating samples. When enabled, call UpdateRateControl() before each frame and
+			* request the number of samples it returns. Has no effect at a non-default speed.
+			*
+			* @param state true to enable
+			*/
+			void EnableRateControl(bool state=true) throw();
+
+			/**
+			* Checks if dynamic rate control is enabled.
+			*
+			* @return true if enabled
+			*/
+			bool IsRateControlEnabled() const throw();
+
+			/**
+			* Feeds the rate control with the current output queue.
+			*
+			* To be called once per frame. Returns the number of samples per channel the core will
+			* produce for the next frame, which is also what should go in Output::length[] to keep the
+			* internal buffers from growing. Usable without rate control for the same purpose.
+			*
+			* @param queued number of samples still waiting in the output device
+			* @param target number of queued samples to aim for
+			* @return number of samples for the next frame
+			*/
+			uint UpdateRateControl(ulong queued,ulong target) throw();
+
 			/**
 			* Sets one or more channel volumes.
 			*
@@ -57,6 +57,7 @@ namespace Nes
 		class TapeRecorder : public Base
 		{
 			struct EventCaller;
+			friend class Callbacks;
 
 			Core::Input::FamilyKeyboard* Query() const;
 
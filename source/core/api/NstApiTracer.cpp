@@ -0,0 +1,187 @@
+////////////////////////////////////////////////////////////////////////////////////////
+//
+// Nestopia - NES/Famicom emulator written in C++
+//
+// Copyright (C) 2003-2008 Martin Freij
+//
+// This file is part of Nestopia.
+//
+// Nestopia is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// Nestopia is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Nestopia; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+////////////////////////////////////////////////////////////////////////////////////////
+
+#include <new>
+#include "../NstMachine.hpp"
+#include "NstApiTracer.hpp"
+
+namespace Nes
+{
+	namespace Api
+	{
+		#ifdef NST_MSVC_OPTIMIZE
+		#pragma optimize("s", on)
+		#endif
+
+		Tracer::BreakCaller Tracer::breakCallback;
+
+		#ifdef NST_TRACE
+
+		Result Tracer::Enable(bool state,ulong capacity) throw()
+		{
+			if (!state)
+			{
+				if (!emulator.cpu.GetTracer().IsEnabled())
+					return RESULT_NOP;
+
+				emulator.cpu.GetTracer().Disable();
+				return RESULT_OK;
+			}
+
+			if (capacity < MIN_CAPACITY || capacity > 0xFFFFFFFF / sizeof(Entry))
+				return RESULT_ERR_INVALID_PARAM;
+
+			try
+			{
+				emulator.cpu.GetTracer().Enable( capacity );
+			}
+			catch (const std::bad_alloc&)
+			{
+				emulator.cpu.GetTracer().Disable();
+				return RESULT_ERR_OUT_OF_MEMORY;
+			}
+			catch (...)
+			{
+				emulator.cpu.GetTracer().Disable();
+				return RESULT_ERR_GENERIC;
+			}
+
+			return RESULT_OK;
+		}
+
+		bool Tracer::IsEnabled() const throw()
+		{
+			return emulator.cpu.GetTracer().IsEnabled();
+		}
+
+		void Tracer::Clear() throw()
+		{
+			emulator.cpu.GetTracer().Clear();
+		}
+
+		ulong Tracer::NumEntries() const throw()
+		{
+			return emulator.cpu.GetTracer().Size();
+		}
+
+		ulong Tracer::GetEntries(Entry* entries,ulong count) const throw()
+		{
+			if (entries && count)
+				return emulator.cpu.GetTracer().Read( entries, count );
+
+			return 0;
+		}
+
+		Result Tracer::Dump(std::ostream& stream) const throw()
+		{
+			try
+			{
+				emulator.cpu.GetTracer().Dump( stream );
+			}
+			catch (Result result)
+			{
+				return result;
+			}
+			catch (const std::bad_alloc&)
+			{
+				return RESULT_ERR_OUT_OF_MEMORY;
+			}
+			catch (...)
+			{
+				return RESULT_ERR_GENERIC;
+			}
+
+			return RESULT_OK;
+		}
+
+		Result Tracer::SetBreakpoint(ushort address,bool state) throw()
+		{
+			try
+			{
+				emulator.cpu.GetTracer().SetBreakpoint( address, state );
+			}
+			catch (const std::bad_alloc&)
+			{
+				return RESULT_ERR_OUT_OF_MEMORY;
+			}
+			catch (...)
+			{
+				return RESULT_ERR_GENERIC;
+			}
+
+			return RESULT_OK;
+		}
+
+		void Tracer::ClearBreakpoints() throw()
+		{
+			emulator.cpu.GetTracer().ClearBreakpoints();
+		}
+
+		#else
+
+		Result Tracer::Enable(bool,ulong) throw()
+		{
+			return RESULT_ERR_UNSUPPORTED;
+		}
+
+		bool Tracer::IsEnabled() const throw()
+		{
+			return false;
+		}
+
+		void Tracer::Clear() throw()
+		{
+		}
+
+		ulong Tracer::NumEntries() const throw()
+		{
+			return 0;
+		}
+
+		ulong Tracer::GetEntries(Entry*,ulong) const throw()
+		{
+			return 0;
+		}
+
+		Result Tracer::Dump(std::ostream&) const throw()
+		{
+			return RESULT_ERR_UNSUPPORTED;
+		}
+
+		Result Tracer::SetBreakpoint(ushort,bool) throw()
+		{
+			return RESULT_ERR_UNSUPPORTED;
+		}
+
+		void Tracer::ClearBreakpoints() throw()
+		{
+		}
+
+		#endif
+
+		#ifdef NST_MSVC_OPTIMIZE
+		#pragma optimize("", on)
+		#endif
+	}
+}
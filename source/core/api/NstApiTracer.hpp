@@ -0,0 +1,258 @@
+////////////////////////////////////////////////////////////////////////////////////////
+//
+// Nestopia - NES/Famicom emulator written in C++
+//
+// Copyright (C) 2003-2008 Martin Freij
+//
+// This file is part of Nestopia.
+//
+// Nestopia is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// Nestopia is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with Nestopia; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+////////////////////////////////////////////////////////////////////////////////////////
+
+#ifndef NST_API_TRACER_H
+#define NST_API_TRACER_H
+
+#include <iosfwd>
+#include "NstApi.hpp"
+
+#ifdef NST_PRAGMA_ONCE
+#pragma once
+#endif
+
+#if NST_ICC >= 810
+#pragma warning( push )
+#pragma warning( disable : 304 444 )
+#elif NST_MSVC >= 1200
+#pragma warning( push )
+#pragma warning( disable : 4512 )
+#endif
+
+namespace Nes
+{
+	namespace Api
+	{
+		/**
+		* CPU trace interface.
+		*
+		* Records executed instructions and the bus accesses they make into a ring buffer
+		* that can be read back or dumped at any time, e.g. from the break callback. Only
+		* available if the core was compiled with NST_TRACE, otherwise every call fails with
+		* RESULT_ERR_UNSUPPORTED. While disabled the CPU runs its regular loop, so the only
+		* cost of having it compiled in is a pointer test per memory-mapped access.
+		*/
+		class Tracer : public Base
+		{
+			struct BreakCaller;
+			friend class Callbacks;
+
+		public:
+
+			/**
+			* Interface constructor.
+			*
+			* @param instance emulator instance
+			*/
+			template<typename T>
+			Tracer(T& instance)
+			: Base(instance) {}
+
+			/**
+			* Trace entry.
+			*/
+			struct Entry
+			{
+				/**
+				* Entry type.
+				*/
+				enum Type
+				{
+					/**
+					* Instruction about to be executed, registers as they were before it.
+					*/
+					INSTRUCTION,
+					/**
+					* Read made by the instruction before it.
+					*/
+					READ,
+					/**
+					* Write made by the instruction before it.
+					*/
+					WRITE
+				};
+
+				/**
+				* Number of frames since tracing was enabled or cleared.
+				*/
+				ulong frame;
+
+				/**
+				* CPU cycle within the frame the instruction started on.
+				*/
+				ushort cycle;
+
+				/**
+				* Program counter for instructions, bus address for accesses.
+				*/
+				ushort address;
+
+				/**
+				* Entry type.
+				*/
+				uchar type;
+
+				/**
+				* Opcode for instructions, data for accesses.
+				*/
+				uchar data;
+
+				/**
+				* Registers, only set for instructions.
+				*/
+				uchar a, x, y, sp, p;
+			};
+
+			enum
+			{
+				/**
+				* Default number of entries.
+				*/
+				DEFAULT_CAPACITY = 0x10000,
+				/**
+				* Minimum number of entries.
+				*/
+				MIN_CAPACITY = 0x10
+			};
+
+			/**
+			* Enables or disables tracing.
+			*
+			* The ring buffer is allocated up front and kept until tracing is disabled.
+			* Accesses are recorded for registers and cartridge space, $2000-$7FFF,
+			* and for writes to $8000-$FFFF. Program and ROM reads, and zero page and
+			* stack accesses, are left out. Frames run hidden by run-ahead are traced too.
+			*
+			* @param state true to enable
+			* @param capacity number of entries to keep, at least MIN_CAPACITY
+			* @return result code
+			*/
+			Result Enable(bool state=true,ulong capacity=DEFAULT_CAPACITY) throw();
+
+			/**
+			* Checks if tracing is enabled.
+			*
+			* @return true if enabled
+			*/
+			bool IsEnabled() const throw();
+
+			/**
+			* Discards all recorded entries and resets the frame counter.
+			*/
+			void Clear() throw();
+
+			/**
+			* Returns the number of recorded entries.
+			*
+			* @return number, at most the capacity
+			*/
+			ulong NumEntries() const throw();
+
+			/**
+			* Copies the most recent entries, oldest first.
+			*
+			* @param entries destination
+			* @param count maximum number of entries to copy
+			* @return number of entries copied
+			*/
+			ulong GetEntries(Entry* entries,ulong count) const throw();
+
+			/**
+			* Writes the recorded entries, oldest first, as text.
+			*
+			* @param stream output stream
+			* @return result code
+			*/
+			Result Dump(std::ostream& stream) const throw();
+
+			/**
+			* Sets or removes a breakpoint. The break callback is invoked when an
+			* instruction at the address is about to be executed.
+			*
+			* @param address CPU address
+			* @param state true to set, false to remove
+			* @return result code
+			*/
+			Result SetBreakpoint(ushort address,bool state=true) throw();
+
+			/**
+			* Removes all breakpoints.
+			*/
+			void ClearBreakpoints() throw();
+
+			/**
+			* Break reason.
+			*/
+			enum Break
+			{
+				/**
+				* Execution reached a breakpoint.
+				*/
+				BREAK_ADDRESS,
+				/**
+				* The CPU ran into a KIL/JAM opcode.
+				*/
+				BREAK_JAM
+			};
+
+			/**
+			* Break callback prototype.
+			*
+			* Invoked while tracing is enabled, with the instruction already recorded.
+			*
+			* @param userData optional user data
+			* @param reason reason
+			* @param address program counter
+			*/
+			typedef void (NST_CALLBACK *BreakCallback) (UserData userData,Break reason,uint address);
+
+			/**
+			* Break callback manager.
+			*
+			* Static object used for adding the user defined callback.
+			*/
+			static BreakCaller breakCallback;
+		};
+
+		/**
+		* Break callback invoker.
+		*
+		* Used internally by the core.
+		*/
+		struct Tracer::BreakCaller : Core::UserCallback<Tracer::BreakCallback>
+		{
+			void operator () (Break reason,uint address) const
+			{
+				if (function)
+					function( userdata, reason, address );
+			}
+		};
+	}
+}
+
+#if NST_MSVC >= 1200 || NST_ICC >= 810
+#pragma warning( pop )
+#endif
+
+#endif
@@ -22,6 +22,10 @@
 //
 ////////////////////////////////////////////////////////////////////////////////////////
 
+#include <new>
+#include "../NstMachine.hpp"
+#include "../NstCartridge.hpp"
+#include "NstApiMachine.hpp"
 #include "NstApiUser.hpp"
 
 namespace Nes
@@ -88,5 +92,30 @@ namespace Nes
 			data = 0;
 			size = 0;
 		}
+
+		Result User::Flush() throw()
+		{
+			if (!emulator.Is(Machine::CARTRIDGE,Machine::ON))
+				return RESULT_ERR_NOT_READY;
+
+			try
+			{
+				static_cast<Core::Cartridge*>(emulator.image)->Flush();
+			}
+			catch (Result result)
+			{
+				return result;
+			}
+			catch (const std::bad_alloc&)
+			{
+				return RESULT_ERR_OUT_OF_MEMORY;
+			}
+			catch (...)
+			{
+				return RESULT_ERR_GENERIC;
+			}
+
+			return RESULT_OK;
+		}
 	}
 }
@@ -53,6 +53,7 @@ namespace Nes
 			struct EventCaller;
 			struct QuestionCaller;
 			struct FileIoCaller;
+			friend class Callbacks;
 
 		public:
 
@@ -340,6 +341,17 @@ namespace Nes
 				virtual void GetRawStorage(void*& data, ulong& size) const throw();
 			};
 
+			/**
+			* Passes battery-backed RAM and EEPROM content that changed since it was last loaded or saved to the file IO callback.
+			*
+			* Meant to be called between frames at whatever pace the application wants its save files kept
+			* current. The content is compared against a copy of what was last loaded or saved so the callback
+			* only fires for data the game has actually written to. The save on power off is still made as usual.
+			*
+			* @return result code
+			*/
+			Result Flush() throw();
+
 			enum
 			{
 				NUM_QUESTION_CALLBACKS = 2,
@@ -228,6 +228,59 @@ namespace Nes
 			return RESULT_ERR_NOT_READY;
 		}
 
+		Result Video::SetBlitThreads(uint threads,bool async) throw()
+		{
+			if (threads > MAX_BLIT_THREADS)
+				return RESULT_ERR_INVALID_PARAM;
+
+			return emulator.renderer.SetBlitThreads( threads, async );
+		}
+
+		uint Video::GetBlitThreads() const throw()
+		{
+			return emulator.renderer.GetBlitThreads();
+		}
+
+		bool Video::IsBlitAsync() const throw()
+		{
+			return emulator.renderer.IsBlitAsync();
+		}
+
+		void Video::FinishBlit() throw()
+		{
+			emulator.renderer.FinishBlit();
+		}
+
+		Result Video::EnableDirtyRows(bool state) throw()
+		{
+			return emulator.renderer.EnableDirtyRows( state );
+		}
+
+		bool Video::AreDirtyRowsEnabled() const throw()
+		{
+			return emulator.renderer.AreDirtyRowsEnabled();
+		}
+
+		void Video::InvalidateDirtyRows() throw()
+		{
+			emulator.renderer.InvalidateDirtyRows();
+		}
+
+		bool Video::GetDirtyRows(uint& first,uint& last) const throw()
+		{
+			return emulator.renderer.GetDirtyRows( first, last );
+		}
+
+		Result Video::EnableSimd(bool state) throw()
+		{
+			return emulator.renderer.EnableSimd( state );
+		}
+
+		bool Video::IsSimdEnabled() const throw()
+		{
+			return emulator.renderer.IsSimdEnabled();
+		}
+
 		Video::RenderState::RenderState() throw()
 		:
 		width  (0),
@@ -52,6 +52,7 @@ namespace Nes
 			{
 				struct Locker;
 				struct Unlocker;
+				friend class Api::Callbacks;
 
 			public:
 
@@ -213,7 +214,8 @@ namespace Nes
 				MAX_COLOR_FRINGING              = +100,
 				MIN_HUE                         =  -45,
 				DEFAULT_HUE                     =    0,
-				MAX_HUE                         =  +45
+				MAX_HUE                         =  +45,
+				MAX_BLIT_THREADS                =   16
 			};
 
 			/**
@@ -420,6 +422,102 @@ namespace Nes
 			*/
 			Result Blit(Output& output) throw();
 
+			/**
+			* Spreads the filter work of each blit across worker threads.
+			*
+			* The filters that can render a band of rows independently (none, NTSC, hqNx and xBR)
+			* are split across all threads, the others run on a single worker. The output is
+			* identical to a single-threaded blit. The lock and unlock callbacks are always
+			* invoked on the calling thread.
+			*
+			* In asynchronous mode the blit returns as soon as the workers are started and the
+			* emulation of the next frame overlaps with the filtering of the previous one. The
+			* frame is complete when the unlock callback is invoked, which happens on the next
+			* blit or on a call to FinishBlit(). The output buffer must stay valid until then.
+			*
+			* @param threads number of threads, 0 to blit on the calling thread only
+			* @param async true to return before the blit has completed
+			* @return result code, RESULT_ERR_UNSUPPORTED if built without thread support
+			*/
+			Result SetBlitThreads(uint threads,bool async=true) throw();
+
+			/**
+			* Returns the number of blit threads.
+			*
+			* @return number of threads, 0 if disabled
+			*/
+			uint GetBlitThreads() const throw();
+
+			/**
+			* Checks if blits complete asynchronously.
+			*
+			* @return true if asynchronous
+			*/
+			bool IsBlitAsync() const throw();
+
+			/**
+			* Waits for a pending asynchronous blit and invokes the unlock callback.
+			*/
+			void FinishBlit() throw();
+
+			/**
+			* Enables dirty row tracking.
+			*
+			* Each blit compares the rows of the frame against the previous blit and only filters
+			* the rows that changed, along with the neighbouring rows the filter reads from. If
+			* nothing changed the surface is left untouched. Rows are only skipped while the lock
+			* callback keeps returning the same surface, which must retain its content between
+			* blits.
+			*
+			* @param state true to enable
+			* @return result code
+			*/
+			Result EnableDirtyRows(bool state) throw();
+
+			/**
+			* Checks if dirty row tracking is enabled.
+			*
+			* @return true if enabled
+			*/
+			bool AreDirtyRowsEnabled() const throw();
+
+			/**
+			* Makes the next blit render every row.
+			*
+			* Needed after anything but the core has written to the surface.
+			*/
+			void InvalidateDirtyRows() throw();
+
+			/**
+			* Returns the surface rows written by the last blit.
+			*
+			* Without dirty row tracking this is the whole surface for every blit.
+			*
+			* @param first first row
+			* @param last row past the last one
+			* @return false if the surface was left untouched
+			*/
+			bool GetDirtyRows(uint& first,uint& last) const throw();
+
+			/**
+			* Enables the SSE2 paths of the hqNx and xBR filters.
+			*
+			* On by default, used when the CPU supports them. Disabling forces the scalar
+			* paths, which produce the same output. Meant for checking the two against
+			* each other.
+			*
+			* @param state true to enable
+			* @return result code
+			*/
+			Result EnableSimd(bool state) throw();
+
+			/**
+			* Checks if the SSE2 filter paths are enabled.
+			*
+			* @return true if enabled
+			*/
+			bool IsSimdEnabled() const throw();
+
 			/**
 			* YUV decoder presets.
 			*/
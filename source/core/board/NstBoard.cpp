@@ -393,6 +393,11 @@ namespace Nes
 				cpu.Map( 0xC000, 0xDFFF ).Set( this, &Board::Peek_Prg_C, &Board::Poke_Nop );
 				cpu.Map( 0xE000, 0xFFFF ).Set( this, &Board::Peek_Prg_E, &Board::Poke_Nop );
 
+				cpu.Map( 0x8000, 0x9FFF ).SetMemory( prg.PagePointer(0), SIZE_8K-1, false );
+				cpu.Map( 0xA000, 0xBFFF ).SetMemory( prg.PagePointer(1), SIZE_8K-1, false );
+				cpu.Map( 0xC000, 0xDFFF ).SetMemory( prg.PagePointer(2), SIZE_8K-1, false );
+				cpu.Map( 0xE000, 0xFFFF ).SetMemory( prg.PagePointer(3), SIZE_8K-1, false );
+
 				if (hard)
 				{
 					wrk.Source().SetSecurity( true, board.GetWram() > 0 );
@@ -741,399 +746,459 @@ namespace Nes
 			{
 				cstring name;
 				dword id;
+			};
+
+			class Board::Context::Names
+			{
+				// open addressing over the name table, filled in during static
+				// initialization so lookups from any thread find it ready
 
-				struct Less
+				enum
 				{
-					bool operator () (const Element& a,const Element& b) const
-					{
-						return Core::StringCompare( a.name, b.name ) < 0;
-					}
+					SLOTS = 0x400
+				};
 
-					bool operator () (const Element& a,wcstring b) const
-					{
-						return Core::StringCompare( a.name, b ) < 0;
-					}
+				template<typename T>
+				static dword Hash(const T*);
+
+				word slots[SLOTS];
+
+			public:
+
+				Names();
+
+				const Element* Find(wcstring) const;
+
+				static const Element lut[];
+				static const uint size;
+			};
+
+			const Board::Context::Element Board::Context::Names::lut[] =
+			{
+				{ "ACCLAIM-AOROM",               Type::STD_AOROM                },
+				{ "ACCLAIM-MC-ACC",              Type::ACCLAIM_MCACC            },
+				{ "ACCLAIM-TLROM",               Type::STD_TLROM                },
+				{ "AGCI-47516",                  Type::DISCRETE_74_377          },
+				{ "AGCI-50282",                  Type::AGCI_50282               },
+				{ "AVE-74*161",                  Type::UNL_CXROM                },
+				{ "AVE-MB-91",                   Type::AVE_MB_91                },
+				{ "AVE-NINA-01",                 Type::AVE_NINA001              },
+				{ "AVE-NINA-02",                 Type::AVE_NINA002              },
+				{ "AVE-NINA-03",                 Type::AVE_NINA03               },
+				{ "AVE-NINA-06",                 Type::AVE_NINA06               },
+				{ "AVE-NINA-07",                 Type::AVE_NINA07               },
+				{ "BANDAI-74*161/161/32",        Type::DISCRETE_74_161_161_32_A },
+				{ "BANDAI-CNROM",                Type::STD_CNROM                },
+				{ "BANDAI-FCG-1",                Type::BANDAI_FCG1              },
+				{ "BANDAI-FCG-2",                Type::BANDAI_FCG2              },
+				{ "BANDAI-GNROM",                Type::STD_GNROM                },
+				{ "BANDAI-JUMP2",                Type::BANDAI_BAJUMP2           },
+				{ "BANDAI-LZ93D50+24C01",        Type::BANDAI_LZ93D50_24C01     },
+				{ "BANDAI-LZ93D50+24C02",        Type::BANDAI_LZ93D50_24C02     },
+				{ "BANDAI-NROM-128",             Type::STD_NROM                 },
+				{ "BANDAI-NROM-256",             Type::STD_NROM                 },
+				{ "BANDAI-PT-554",               Type::BANDAI_AEROBICSSTUDIO    },
+				{ "BMC-190IN1",                  Type::BMC_GOLDEN_190IN1        },
+				{ "BMC-42IN1RESETSWITCH",        Type::BMC_SUPER_22GAMES        },
+				{ "BMC-64IN1NOREPEAT",           Type::BMC_Y2K_64IN1            },
+				{ "BMC-70IN1",                   Type::BMC_GAME_800IN1          },
+				{ "BMC-70IN1B",                  Type::BMC_GAME_800IN1          },
+				{ "BMC-8157",                    Type::BMC_8157                 },
+				{ "BMC-A65AS",                   Type::BMC_A65AS                },
+				{ "BMC-BS-5",                    Type::BENSHENG_BS5             },
+				{ "BMC-D1038",                   Type::BMC_VT5201               },
+				{ "BMC-FK23C",                   Type::BMC_FKC23C               },
+				{ "BMC-GHOSTBUSTERS63IN1",       Type::BMC_CTC65                },
+				{ "BMC-GS-2004",                 Type::RCM_GS2004               },
+				{ "BMC-GS-2013",                 Type::RCM_GS2013               },
+				{ "BMC-NOVELDIAMOND9999999IN1",  Type::BMC_NOVELDIAMOND         },
+				{ "BMC-SUPER24IN1SC03",          Type::BMC_SUPER_24IN1          },
+				{ "BMC-SUPERHIK8IN1",            Type::BMC_HERO                 },
+				{ "BMC-SUPERVISION16IN1",        Type::BMC_SUPERVISION_16IN1    },
+				{ "BMC-T-262",                   Type::BMC_T262                 },
+				{ "BMC-WS",                      Type::BMC_SUPER_40IN1          },
+				{ "BTL-MARIO1-MALEE2",           Type::BTL_GENIUSMERIOBROS      },
+				{ "CAMERICA-ALGN",               Type::CAMERICA_ALGNV11         },
+				{ "CAMERICA-ALGQ",               Type::CAMERICA_ALGQV11         },
+				{ "CAMERICA-BF9093",             Type::CAMERICA_BF9093          },
+				{ "CAMERICA-BF9096",             Type::CAMERICA_BF9096          },
+				{ "CAMERICA-BF9097",             Type::CAMERICA_BF9097          },
+				{ "CAMERICA-GAMEGENIE",          Type::STD_NROM                 },
+				{ "COLORDREAMS-74*377",          Type::DISCRETE_74_377          },
+				{ "DREAMTECH01",                 Type::DREAMTECH_01             },
+				{ "HVC-AMROM",                   Type::STD_AMROM                },
+				{ "HVC-AN1ROM",                  Type::STD_AN1ROM               },
+				{ "HVC-ANROM",                   Type::STD_ANROM                },
+				{ "HVC-AOROM",                   Type::STD_AOROM                },
+				{ "HVC-BNROM",                   Type::STD_BNROM                },
+				{ "HVC-CNROM",                   Type::STD_CNROM                },
+				{ "HVC-CPROM",                   Type::STD_CPROM                },
+				{ "HVC-DE1ROM",                  Type::STD_DE1ROM               },
+				{ "HVC-DEROM",                   Type::STD_DEROM                },
+				{ "HVC-DRROM",                   Type::STD_DRROM                },
+				{ "HVC-EKROM",                   Type::STD_EKROM                },
+				{ "HVC-ELROM",                   Type::STD_ELROM                },
+				{ "HVC-ETROM",                   Type::STD_ETROM                },
+				{ "HVC-EWROM",                   Type::STD_EWROM                },
+				{ "HVC-FAMILYBASIC",             Type::CUSTOM_FB02              },
+				{ "HVC-FJROM",                   Type::STD_FJROM                },
+				{ "HVC-FKROM",                   Type::STD_FKROM                },
+				{ "HVC-GNROM",                   Type::STD_GNROM                },
+				{ "HVC-HKROM",                   Type::STD_HKROM                },
+				{ "HVC-HROM",                    Type::STD_NROM                 },
+				{ "HVC-JLROM",                   Type::STD_JLROM                },
+				{ "HVC-JSROM",                   Type::STD_JSROM                },
+				{ "HVC-MHROM",                   Type::STD_MHROM                },
+				{ "HVC-NROM",                    Type::STD_NROM                 },
+				{ "HVC-NROM-128",                Type::STD_NROM                 },
+				{ "HVC-NROM-256",                Type::STD_NROM                 },
+				{ "HVC-NTBROM",                  Type::STD_NTBROM               },
+				{ "HVC-PEEOROM",                 Type::STD_PEEOROM              },
+				{ "HVC-PNROM",                   Type::STD_PNROM                },
+				{ "HVC-RROM",                    Type::STD_NROM                 },
+				{ "HVC-RROM-128",                Type::STD_NROM                 },
+				{ "HVC-SAROM",                   Type::STD_SAROM                },
+				{ "HVC-SBROM",                   Type::STD_SBROM                },
+				{ "HVC-SC1ROM",                  Type::STD_SCROM                },
+				{ "HVC-SCROM",                   Type::STD_SCROM                },
+				{ "HVC-SEROM",                   Type::STD_SEROM                },
+				{ "HVC-SF1ROM",                  Type::STD_SFROM                },
+				{ "HVC-SFROM",                   Type::STD_SFROM                },
+				{ "HVC-SGROM",                   Type::STD_SGROM                },
+				{ "HVC-SH1ROM",                  Type::STD_SHROM                },
+				{ "HVC-SHROM",                   Type::STD_SHROM                },
+				{ "HVC-SJROM",                   Type::STD_SJROM                },
+				{ "HVC-SKROM",                   Type::STD_SKROM                },
+				{ "HVC-SL1ROM",                  Type::STD_SLROM                },
+				{ "HVC-SL2ROM",                  Type::STD_SLROM                },
+				{ "HVC-SL3ROM",                  Type::STD_SLROM                },
+				{ "HVC-SLROM",                   Type::STD_SLROM                },
+				{ "HVC-SLRROM",                  Type::STD_SLROM                },
+				{ "HVC-SNROM",                   Type::STD_SNROM                },
+				{ "HVC-SOROM",                   Type::STD_SOROM                },
+				{ "HVC-SROM",                    Type::STD_NROM                 },
+				{ "HVC-STROM",                   Type::STD_NROM                 },
+				{ "HVC-SUROM",                   Type::STD_SUROM                },
+				{ "HVC-SXROM",                   Type::STD_SXROM                },
+				{ "HVC-TBROM",                   Type::STD_TBROM                },
+				{ "HVC-TEROM",                   Type::STD_TEROM                },
+				{ "HVC-TFROM",                   Type::STD_TFROM                },
+				{ "HVC-TGROM",                   Type::STD_TGROM                },
+				{ "HVC-TKROM",                   Type::STD_TKROM                },
+				{ "HVC-TKSROM",                  Type::STD_TKSROM               },
+				{ "HVC-TL1ROM",                  Type::STD_TLROM                },
+				{ "HVC-TL2ROM",                  Type::STD_TLROM                },
+				{ "HVC-TLROM",                   Type::STD_TLROM                },
+				{ "HVC-TLSROM",                  Type::STD_TLSROM               },
+				{ "HVC-TNROM",                   Type::STD_TNROM                },
+				{ "HVC-TQROM",                   Type::STD_TQROM                },
+				{ "HVC-TR1ROM",                  Type::STD_TR1ROM               },
+				{ "HVC-TSROM",                   Type::STD_TSROM                },
+				{ "HVC-TVROM",                   Type::STD_TVROM                },
+				{ "HVC-UN1ROM",                  Type::STD_UN1ROM               },
+				{ "HVC-UNROM",                   Type::STD_UNROM                },
+				{ "HVC-UOROM",                   Type::STD_UOROM                },
+				{ "IREM-74*161/161/21/138",      Type::IREM_LROG017             },
+				{ "IREM-BNROM",                  Type::STD_BNROM                },
+				{ "IREM-G101",                   Type::IREM_G101A_0             },
+				{ "IREM-G101-A",                 Type::IREM_G101A_0             },
+				{ "IREM-G101-B",                 Type::IREM_G101B_0             },
+				{ "IREM-HOLYDIVER",              Type::IREM_HOLYDIVER           },
+				{ "IREM-NROM-128",               Type::STD_NROM                 },
+				{ "IREM-NROM-256",               Type::STD_NROM                 },
+				{ "IREM-UNROM",                  Type::STD_UNROM                },
+				{ "JALECO-JF-01",                Type::JALECO_JF01              },
+				{ "JALECO-JF-02",                Type::JALECO_JF02              },
+				{ "JALECO-JF-03",                Type::JALECO_JF03              },
+				{ "JALECO-JF-04",                Type::JALECO_JF04              },
+				{ "JALECO-JF-05",                Type::JALECO_JF05              },
+				{ "JALECO-JF-06",                Type::JALECO_JF06              },
+				{ "JALECO-JF-07",                Type::JALECO_JF07              },
+				{ "JALECO-JF-08",                Type::JALECO_JF08              },
+				{ "JALECO-JF-09",                Type::JALECO_JF09              },
+				{ "JALECO-JF-10",                Type::JALECO_JF10              },
+				{ "JALECO-JF-11",                Type::JALECO_JF11              },
+				{ "JALECO-JF-12",                Type::JALECO_JF12              },
+				{ "JALECO-JF-13",                Type::JALECO_JF13              },
+				{ "JALECO-JF-14",                Type::JALECO_JF14              },
+				{ "JALECO-JF-15",                Type::JALECO_JF15              },
+				{ "JALECO-JF-16",                Type::JALECO_JF16              },
+				{ "JALECO-JF-17",                Type::JALECO_JF17              },
+				{ "JALECO-JF-18",                Type::JALECO_JF18              },
+				{ "JALECO-JF-19",                Type::JALECO_JF19              },
+				{ "JALECO-JF-20",                Type::JALECO_JF20              },
+				{ "JALECO-JF-21",                Type::JALECO_JF21              },
+				{ "JALECO-JF-22",                Type::JALECO_JF22              },
+				{ "JALECO-JF-23",                Type::JALECO_JF23              },
+				{ "JALECO-JF-24",                Type::JALECO_JF24              },
+				{ "JALECO-JF-25",                Type::JALECO_JF25              },
+				{ "JALECO-JF-26",                Type::JALECO_JF26              },
+				{ "JALECO-JF-27",                Type::JALECO_JF27              },
+				{ "JALECO-JF-28",                Type::JALECO_JF28              },
+				{ "JALECO-JF-29",                Type::JALECO_JF29              },
+				{ "JALECO-JF-30",                Type::JALECO_JF30              },
+				{ "JALECO-JF-31",                Type::JALECO_JF31              },
+				{ "JALECO-JF-32",                Type::JALECO_JF32              },
+				{ "JALECO-JF-33",                Type::JALECO_JF33              },
+				{ "JALECO-JF-34",                Type::JALECO_JF34              },
+				{ "JALECO-JF-35",                Type::JALECO_JF35              },
+				{ "JALECO-JF-36",                Type::JALECO_JF36              },
+				{ "JALECO-JF-37",                Type::JALECO_JF37              },
+				{ "JALECO-JF-38",                Type::JALECO_JF38              },
+				{ "JALECO-JF-39",                Type::JALECO_JF39              },
+				{ "JALECO-JF-40",                Type::JALECO_JF40              },
+				{ "JALECO-JF-41",                Type::JALECO_JF41              },
+				{ "KONAMI-74*139/74",            Type::DISCRETE_74_139_74       },
+				{ "KONAMI-CNROM",                Type::STD_CNROM                },
+				{ "KONAMI-NROM-128",             Type::STD_NROM                 },
+				{ "KONAMI-SLROM",                Type::STD_SLROM                },
+				{ "KONAMI-TLROM",                Type::STD_TLROM                },
+				{ "KONAMI-UNROM",                Type::STD_UNROM                },
+				{ "KONAMI-VRC-1",                Type::KONAMI_VRC1              },
+				{ "KONAMI-VRC-2",                Type::KONAMI_VRC2              },
+				{ "KONAMI-VRC-3",                Type::KONAMI_VRC3              },
+				{ "KONAMI-VRC-4",                Type::KONAMI_VRC4_0            },
+				{ "KONAMI-VRC-6",                Type::KONAMI_VRC6_0            },
+				{ "KONAMI-VRC-7",                Type::KONAMI_VRC7_0            },
+				{ "KS7031",                      Type::KAISER_KS7031            },
+				{ "MLT-ACTION52",                Type::AE_STD                   },
+				{ "MLT-CALTRON6IN1",             Type::CALTRON_6IN1             },
+				{ "MLT-MAXI15",                  Type::AVE_D1012                },
+				{ "NAMCOT-163",                  Type::NAMCOT_163_0             },
+				{ "NAMCOT-175",                  Type::NAMCOT_175               },
+				{ "NAMCOT-340",                  Type::NAMCOT_340               },
+				{ "NAMCOT-3301",                 Type::STD_NROM                 },
+				{ "NAMCOT-3302",                 Type::STD_NROM                 },
+				{ "NAMCOT-3303",                 Type::STD_NROM                 },
+				{ "NAMCOT-3305",                 Type::STD_NROM                 },
+				{ "NAMCOT-3311",                 Type::STD_NROM                 },
+				{ "NAMCOT-3401",                 Type::STD_DE1ROM               },
+				{ "NAMCOT-3405",                 Type::STD_DE1ROM               },
+				{ "NAMCOT-3406",                 Type::STD_DE1ROM               },
+				{ "NAMCOT-3407",                 Type::STD_DE1ROM               },
+				{ "NAMCOT-3411",                 Type::STD_NROM                 },
+				{ "NAMCOT-3413",                 Type::STD_DE1ROM               },
+				{ "NAMCOT-3414",                 Type::STD_DE1ROM               },
+				{ "NAMCOT-3415",                 Type::STD_DE1ROM               },
+				{ "NAMCOT-3416",                 Type::STD_DE1ROM               },
+				{ "NAMCOT-3417",                 Type::STD_DE1ROM               },
+				{ "NAMCOT-3425",                 Type::NAMCOT_3425              },
+				{ "NAMCOT-3433",                 Type::NAMCOT_3433              },
+				{ "NAMCOT-3443",                 Type::NAMCOT_3443              },
+				{ "NAMCOT-3446",                 Type::NAMCOT_3446              },
+				{ "NAMCOT-3451",                 Type::STD_DE1ROM               },
+				{ "NES-AMROM",                   Type::STD_AMROM                },
+				{ "NES-AN1ROM",                  Type::STD_AN1ROM               },
+				{ "NES-ANROM",                   Type::STD_ANROM                },
+				{ "NES-AOROM",                   Type::STD_AOROM                },
+				{ "NES-B4",                      Type::STD_TLROM                },
+				{ "NES-BNROM",                   Type::STD_BNROM                },
+				{ "NES-BTR",                     Type::CUSTOM_BTR               },
+				{ "NES-CNROM",                   Type::STD_CNROM                },
+				{ "NES-CPROM",                   Type::STD_CPROM                },
+				{ "NES-DE1ROM",                  Type::STD_DE1ROM               },
+				{ "NES-DEROM",                   Type::STD_DEROM                },
+				{ "NES-DRROM",                   Type::STD_DRROM                },
+				{ "NES-EKROM",                   Type::STD_EKROM                },
+				{ "NES-ELROM",                   Type::STD_ELROM                },
+				{ "NES-ETROM",                   Type::STD_ETROM                },
+				{ "NES-EVENT",                   Type::CUSTOM_EVENT             },
+				{ "NES-EWROM",                   Type::STD_EWROM                },
+				{ "NES-FJROM",                   Type::STD_FJROM                },
+				{ "NES-FKROM",                   Type::STD_FKROM                },
+				{ "NES-GNROM",                   Type::STD_GNROM                },
+				{ "NES-HKROM",                   Type::STD_HKROM                },
+				{ "NES-HROM",                    Type::STD_NROM                 },
+				{ "NES-JLROM",                   Type::STD_JLROM                },
+				{ "NES-JSROM",                   Type::STD_JSROM                },
+				{ "NES-MHROM",                   Type::STD_MHROM                },
+				{ "NES-NROM",                    Type::STD_NROM                 },
+				{ "NES-NROM-128",                Type::STD_NROM                 },
+				{ "NES-NROM-256",                Type::STD_NROM                 },
+				{ "NES-NTBROM",                  Type::STD_NTBROM               },
+				{ "NES-PEEOROM",                 Type::STD_PEEOROM              },
+				{ "NES-PNROM",                   Type::STD_PNROM                },
+				{ "NES-QJ",                      Type::CUSTOM_QJ                },
+				{ "NES-RROM",                    Type::STD_NROM                 },
+				{ "NES-RROM-128",                Type::STD_NROM                 },
+				{ "NES-SAROM",                   Type::STD_SAROM                },
+				{ "NES-SBROM",                   Type::STD_SBROM                },
+				{ "NES-SC1ROM",                  Type::STD_SCROM                },
+				{ "NES-SCROM",                   Type::STD_SCROM                },
+				{ "NES-SEROM",                   Type::STD_SEROM                },
+				{ "NES-SF1ROM",                  Type::STD_SFROM                },
+				{ "NES-SFROM",                   Type::STD_SFROM                },
+				{ "NES-SGROM",                   Type::STD_SGROM                },
+				{ "NES-SH1ROM",                  Type::STD_SHROM                },
+				{ "NES-SHROM",                   Type::STD_SHROM                },
+				{ "NES-SJROM",                   Type::STD_SJROM                },
+				{ "NES-SKROM",                   Type::STD_SKROM                },
+				{ "NES-SL1ROM",                  Type::STD_SLROM                },
+				{ "NES-SL2ROM",                  Type::STD_SLROM                },
+				{ "NES-SL3ROM",                  Type::STD_SLROM                },
+				{ "NES-SLROM",                   Type::STD_SLROM                },
+				{ "NES-SLRROM",                  Type::STD_SLROM                },
+				{ "NES-SNROM",                   Type::STD_SNROM                },
+				{ "NES-SOROM",                   Type::STD_SOROM                },
+				{ "NES-SROM",                    Type::STD_NROM                 },
+				{ "NES-STROM",                   Type::STD_NROM                 },
+				{ "NES-SUROM",                   Type::STD_SUROM                },
+				{ "NES-SXROM",                   Type::STD_SXROM                },
+				{ "NES-TBROM",                   Type::STD_TBROM                },
+				{ "NES-TEROM",                   Type::STD_TEROM                },
+				{ "NES-TFROM",                   Type::STD_TFROM                },
+				{ "NES-TGROM",                   Type::STD_TGROM                },
+				{ "NES-TKROM",                   Type::STD_TKROM                },
+				{ "NES-TKSROM",                  Type::STD_TKSROM               },
+				{ "NES-TL1ROM",                  Type::STD_TLROM                },
+				{ "NES-TL2ROM",                  Type::STD_TLROM                },
+				{ "NES-TLROM",                   Type::STD_TLROM                },
+				{ "NES-TLSROM",                  Type::STD_TLSROM               },
+				{ "NES-TNROM",                   Type::STD_TNROM                },
+				{ "NES-TQROM",                   Type::STD_TQROM                },
+				{ "NES-TR1ROM",                  Type::STD_TR1ROM               },
+				{ "NES-TSROM",                   Type::STD_TSROM                },
+				{ "NES-TVROM",                   Type::STD_TVROM                },
+				{ "NES-UN1ROM",                  Type::STD_UN1ROM               },
+				{ "NES-UNROM",                   Type::STD_UNROM                },
+				{ "NES-UOROM",                   Type::STD_UOROM                },
+				{ "NES-WH",                      Type::CUSTOM_WH                },
+				{ "NTDEC-N715062",               Type::NTDEC_N715062            },
+				{ "PAL-MH",                      Type::STD_MHROM                },
+				{ "PAL-ZZ",                      Type::CUSTOM_ZZ                },
+				{ "SACHEN-8259A",                Type::SACHEN_8259A             },
+				{ "SACHEN-8259B",                Type::SACHEN_8259B             },
+				{ "SACHEN-8259C",                Type::SACHEN_8259C             },
+				{ "SACHEN-8259D",                Type::SACHEN_8259D             },
+				{ "SACHEN-CNROM",                Type::STD_CXROM                },
+				{ "SETA-NROM-128",               Type::STD_NROM                 },
+				{ "SUNSOFT-1",                   Type::SUNSOFT_1                },
+				{ "SUNSOFT-2",                   Type::SUNSOFT_2B               },
+				{ "SUNSOFT-3",                   Type::SUNSOFT_3                },
+				{ "SUNSOFT-4",                   Type::SUNSOFT_4_0              },
+				{ "SUNSOFT-5B",                  Type::SUNSOFT_5B_0             },
+				{ "SUNSOFT-FME-7",               Type::SUNSOFT_FME7_0           },
+				{ "SUNSOFT-NROM-256",            Type::STD_NROM                 },
+				{ "TAITO-74*139/74",             Type::DISCRETE_74_139_74       },
+				{ "TAITO-74*161/161/32",         Type::DISCRETE_74_161_161_32_A },
+				{ "TAITO-CNROM",                 Type::STD_CNROM                },
+				{ "TAITO-NROM-128",              Type::STD_NROM                 },
+				{ "TAITO-NROM-256",              Type::STD_NROM                 },
+				{ "TAITO-TC0190FMC",             Type::TAITO_TC0190FMC          },
+				{ "TAITO-TC0190FMC+PAL16R4",     Type::TAITO_TC0190FMC_PAL16R4  },
+				{ "TAITO-UNROM",                 Type::STD_UNROM                },
+				{ "TAITO-X1-005",                Type::TAITO_X1005              },
+				{ "TAITO-X1-017",                Type::TAITO_X1017              },
+				{ "TENGEN-800002",               Type::TENGEN_800002            },
+				{ "TENGEN-800003",               Type::STD_NROM                 },
+				{ "TENGEN-800004",               Type::TENGEN_800004            },
+				{ "TENGEN-800008",               Type::TENGEN_800008            },
+				{ "TENGEN-800030",               Type::TENGEN_800030            },
+				{ "TENGEN-800032",               Type::TENGEN_800032            },
+				{ "TENGEN-800037",               Type::TENGEN_800037            },
+				{ "TENGEN-800042",               Type::TENGEN_800042            },
+				{ "UNL-22211",                   Type::TXC_22211A               },
+				{ "UNL-603-5052",                Type::BTL_6035052              },
+				{ "UNL-8237",                    Type::SUPERGAME_POCAHONTAS2    },
+				{ "UNL-A9746",                   Type::UNL_A9746                },
+				{ "UNL-AX5705",                  Type::BTL_AX5705               },
+				{ "UNL-CC-21",                   Type::UNL_CC21                 },
+				{ "UNL-EDU2000",                 Type::UNL_EDU2000              },
+				{ "UNL-H2288",                   Type::KAY_H2288                },
+				{ "UNL-KOF97",                   Type::UNL_KINGOFFIGHTERS97     },
+				{ "UNL-KS7031",                  Type::KAISER_KS7031            },
+				{ "UNL-KS7032",                  Type::KAISER_KS7032            },
+				{ "UNL-N625092",                 Type::UNL_N625092              },
+				{ "UNL-SA-0036",                 Type::SACHEN_SA0036            },
+				{ "UNL-SA-0037",                 Type::SACHEN_SA0037            },
+				{ "UNL-SA-016-1M",               Type::SACHEN_SA0161M           },
+				{ "UNL-SA-72007",                Type::SACHEN_SA72007           },
+				{ "UNL-SA-72008",                Type::SACHEN_SA72008           },
+				{ "UNL-SA-NROM",                 Type::SACHEN_TCA01             },
+				{ "UNL-SACHEN-74LS374N",         Type::SACHEN_74_374B           },
+				{ "UNL-SACHEN-8259A",            Type::SACHEN_8259A             },
+				{ "UNL-SACHEN-8259B",            Type::SACHEN_8259B             },
+				{ "UNL-SACHEN-8259C",            Type::SACHEN_8259C             },
+				{ "UNL-SACHEN-8259D",            Type::SACHEN_8259D             },
+				{ "UNL-SHERO",                   Type::SACHEN_STREETHEROES      },
+				{ "UNL-SL1632",                  Type::REXSOFT_SL1632           },
+				{ "UNL-SMB2J",                   Type::BTL_SMB2_C               },
+				{ "UNL-T-230",                   Type::BTL_T230                 },
+				{ "UNL-TC-U01-1.5M",             Type::SACHEN_TCU01             },
+				{ "UNL-TEK90",                   Type::JYCOMPANY_TYPE_A         },
+				{ "UNL-TF1201",                  Type::UNL_TF1201               },
+				{ "VIRGIN-SNROM",                Type::STD_SNROM                }
+			};
+
+			const uint Board::Context::Names::size = sizeof(array(lut));
+
+			template<typename T>
+			dword Board::Context::Names::Hash(const T* string)
+			{
+				// case-insensitive the same way StringCompare() is
+
+				dword hash = 0x811C9DC5;
+
+				for (; *string; ++string)
+				{
+					const dword c = (*string < L'a' || *string > L'z') ? dword(*string) : dword(L'A' + (*string - L'a'));
+					hash = ((hash ^ c) * 0x01000193) & 0xFFFFFFFF;
+				}
+
+				return hash ^ hash >> 16;
+			}
 
-					bool operator () (wcstring a,const Element& b) const
+			Board::Context::Names::Names()
+			{
+				NST_COMPILE_ASSERT( SLOTS > sizeof(array(lut)) * 2 );
+
+				std::fill( slots, slots + SLOTS, word(0) );
+
+				for (uint i=0; i < size; ++i)
+				{
+					uint slot = Hash( lut[i].name );
+
+					while (slots[slot &= SLOTS-1])
 					{
-						return Core::StringCompare( b.name, a ) >= 0;
+						NST_ASSERT( Core::StringCompare( lut[slots[slot]-1].name, lut[i].name ) != 0 );
+						++slot;
 					}
-				};
-			};
 
-			bool Board::Context::DetectBoard(wcstring string,const dword wram)
+					slots[slot] = i + 1;
+				}
+			}
+
+			const Board::Context::Element* Board::Context::Names::Find(wcstring string) const
 			{
-				static const Element lut[] =
+				for (uint slot = Hash( string ); slots[slot &= SLOTS-1]; ++slot)
 				{
-					{ "ACCLAIM-AOROM",               Type::STD_AOROM                },
-					{ "ACCLAIM-MC-ACC",              Type::ACCLAIM_MCACC            },
-					{ "ACCLAIM-TLROM",               Type::STD_TLROM                },
-					{ "AGCI-47516",                  Type::DISCRETE_74_377          },
-					{ "AGCI-50282",                  Type::AGCI_50282               },
-					{ "AVE-74*161",                  Type::UNL_CXROM                },
-					{ "AVE-MB-91",                   Type::AVE_MB_91                },
-					{ "AVE-NINA-01",                 Type::AVE_NINA001              },
-					{ "AVE-NINA-02",                 Type::AVE_NINA002              },
-					{ "AVE-NINA-03",                 Type::AVE_NINA03               },
-					{ "AVE-NINA-06",                 Type::AVE_NINA06               },
-					{ "AVE-NINA-07",                 Type::AVE_NINA07               },
-					{ "BANDAI-74*161/161/32",        Type::DISCRETE_74_161_161_32_A },
-					{ "BANDAI-CNROM",                Type::STD_CNROM                },
-					{ "BANDAI-FCG-1",                Type::BANDAI_FCG1              },
-					{ "BANDAI-FCG-2",                Type::BANDAI_FCG2              },
-					{ "BANDAI-GNROM",                Type::STD_GNROM                },
-					{ "BANDAI-JUMP2",                Type::BANDAI_BAJUMP2           },
-					{ "BANDAI-LZ93D50+24C01",        Type::BANDAI_LZ93D50_24C01     },
-					{ "BANDAI-LZ93D50+24C02",        Type::BANDAI_LZ93D50_24C02     },
-					{ "BANDAI-NROM-128",             Type::STD_NROM                 },
-					{ "BANDAI-NROM-256",             Type::STD_NROM                 },
-					{ "BANDAI-PT-554",               Type::BANDAI_AEROBICSSTUDIO    },
-					{ "BMC-190IN1",                  Type::BMC_GOLDEN_190IN1        },
-					{ "BMC-42IN1RESETSWITCH",        Type::BMC_SUPER_22GAMES        },
-					{ "BMC-64IN1NOREPEAT",           Type::BMC_Y2K_64IN1            },
-					{ "BMC-70IN1",                   Type::BMC_GAME_800IN1          },
-					{ "BMC-70IN1B",                  Type::BMC_GAME_800IN1          },
-					{ "BMC-8157",                    Type::BMC_8157                 },
-					{ "BMC-A65AS",                   Type::BMC_A65AS                },
-					{ "BMC-BS-5",                    Type::BENSHENG_BS5             },
-					{ "BMC-D1038",                   Type::BMC_VT5201               },
-					{ "BMC-FK23C",                   Type::BMC_FKC23C               },
-					{ "BMC-GHOSTBUSTERS63IN1",       Type::BMC_CTC65                },
-					{ "BMC-GS-2004",                 Type::RCM_GS2004               },
-					{ "BMC-GS-2013",                 Type::RCM_GS2013               },
-					{ "BMC-NOVELDIAMOND9999999IN1",  Type::BMC_NOVELDIAMOND         },
-					{ "BMC-SUPER24IN1SC03",          Type::BMC_SUPER_24IN1          },
-					{ "BMC-SUPERHIK8IN1",            Type::BMC_HERO                 },
-					{ "BMC-SUPERVISION16IN1",        Type::BMC_SUPERVISION_16IN1    },
-					{ "BMC-T-262",                   Type::BMC_T262                 },
-					{ "BMC-WS",                      Type::BMC_SUPER_40IN1          },
-					{ "BTL-MARIO1-MALEE2",           Type::BTL_GENIUSMERIOBROS      },
-					{ "CAMERICA-ALGN",               Type::CAMERICA_ALGNV11         },
-					{ "CAMERICA-ALGQ",               Type::CAMERICA_ALGQV11         },
-					{ "CAMERICA-BF9093",             Type::CAMERICA_BF9093          },
-					{ "CAMERICA-BF9096",             Type::CAMERICA_BF9096          },
-					{ "CAMERICA-BF9097",             Type::CAMERICA_BF9097          },
-					{ "CAMERICA-GAMEGENIE",          Type::STD_NROM                 },
-					{ "COLORDREAMS-74*377",          Type::DISCRETE_74_377          },
-					{ "DREAMTECH01",                 Type::DREAMTECH_01             },
-					{ "HVC-AMROM",                   Type::STD_AMROM                },
-					{ "HVC-AN1ROM",                  Type::STD_AN1ROM               },
-					{ "HVC-ANROM",                   Type::STD_ANROM                },
-					{ "HVC-AOROM",                   Type::STD_AOROM                },
-					{ "HVC-BNROM",                   Type::STD_BNROM                },
-					{ "HVC-CNROM",                   Type::STD_CNROM                },
-					{ "HVC-CPROM",                   Type::STD_CPROM                },
-					{ "HVC-DE1ROM",                  Type::STD_DE1ROM               },
-					{ "HVC-DEROM",                   Type::STD_DEROM                },
-					{ "HVC-DRROM",                   Type::STD_DRROM                },
-					{ "HVC-EKROM",                   Type::STD_EKROM                },
-					{ "HVC-ELROM",                   Type::STD_ELROM                },
-					{ "HVC-ETROM",                   Type::STD_ETROM                },
-					{ "HVC-EWROM",                   Type::STD_EWROM                },
-					{ "HVC-FAMILYBASIC",             Type::CUSTOM_FB02              },
-					{ "HVC-FJROM",                   Type::STD_FJROM                },
-					{ "HVC-FKROM",                   Type::STD_FKROM                },
-					{ "HVC-GNROM",                   Type::STD_GNROM                },
-					{ "HVC-HKROM",                   Type::STD_HKROM                },
-					{ "HVC-HROM",                    Type::STD_NROM                 },
-					{ "HVC-JLROM",                   Type::STD_JLROM                },
-					{ "HVC-JSROM",                   Type::STD_JSROM                },
-					{ "HVC-MHROM",                   Type::STD_MHROM                },
-					{ "HVC-NROM",                    Type::STD_NROM                 },
-					{ "HVC-NROM-128",                Type::STD_NROM                 },
-					{ "HVC-NROM-256",                Type::STD_NROM                 },
-					{ "HVC-NTBROM",                  Type::STD_NTBROM               },
-					{ "HVC-PEEOROM",                 Type::STD_PEEOROM              },
-					{ "HVC-PNROM",                   Type::STD_PNROM                },
-					{ "HVC-RROM",                    Type::STD_NROM                 },
-					{ "HVC-RROM-128",                Type::STD_NROM                 },
-					{ "HVC-SAROM",                   Type::STD_SAROM                },
-					{ "HVC-SBROM",                   Type::STD_SBROM                },
-					{ "HVC-SC1ROM",                  Type::STD_SCROM                },
-					{ "HVC-SCROM",                   Type::STD_SCROM                },
-					{ "HVC-SEROM",                   Type::STD_SEROM                },
-					{ "HVC-SF1ROM",                  Type::STD_SFROM                },
-					{ "HVC-SFROM",                   Type::STD_SFROM                },
-					{ "HVC-SGROM",                   Type::STD_SGROM                },
-					{ "HVC-SH1ROM",                  Type::STD_SHROM                },
-					{ "HVC-SHROM",                   Type::STD_SHROM                },
-					{ "HVC-SJROM",                   Type::STD_SJROM                },
-					{ "HVC-SKROM",                   Type::STD_SKROM                },
-					{ "HVC-SL1ROM",                  Type::STD_SLROM                },
-					{ "HVC-SL2ROM",                  Type::STD_SLROM                },
-					{ "HVC-SL3ROM",                  Type::STD_SLROM                },
-					{ "HVC-SLROM",                   Type::STD_SLROM                },
-					{ "HVC-SLRROM",                  Type::STD_SLROM                },
-					{ "HVC-SNROM",                   Type::STD_SNROM                },
-					{ "HVC-SOROM",                   Type::STD_SOROM                },
-					{ "HVC-SROM",                    Type::STD_NROM                 },
-					{ "HVC-STROM",                   Type::STD_NROM                 },
-					{ "HVC-SUROM",                   Type::STD_SUROM                },
-					{ "HVC-SXROM",                   Type::STD_SXROM                },
-					{ "HVC-TBROM",                   Type::STD_TBROM                },
-					{ "HVC-TEROM",                   Type::STD_TEROM                },
-					{ "HVC-TFROM",                   Type::STD_TFROM                },
-					{ "HVC-TGROM",                   Type::STD_TGROM                },
-					{ "HVC-TKROM",                   Type::STD_TKROM                },
-					{ "HVC-TKSROM",                  Type::STD_TKSROM               },
-					{ "HVC-TL1ROM",                  Type::STD_TLROM                },
-					{ "HVC-TL2ROM",                  Type::STD_TLROM                },
-					{ "HVC-TLROM",                   Type::STD_TLROM                },
-					{ "HVC-TLSROM",                  Type::STD_TLSROM               },
-					{ "HVC-TNROM",                   Type::STD_TNROM                },
-					{ "HVC-TQROM",                   Type::STD_TQROM                },
-					{ "HVC-TR1ROM",                  Type::STD_TR1ROM               },
-					{ "HVC-TSROM",                   Type::STD_TSROM                },
-					{ "HVC-TVROM",                   Type::STD_TVROM                },
-					{ "HVC-UN1ROM",                  Type::STD_UN1ROM               },
-					{ "HVC-UNROM",                   Type::STD_UNROM                },
-					{ "HVC-UOROM",                   Type::STD_UOROM                },
-					{ "IREM-74*161/161/21/138",      Type::IREM_LROG017             },
-					{ "IREM-BNROM",                  Type::STD_BNROM                },
-					{ "IREM-G101",                   Type::IREM_G101A_0             },
-					{ "IREM-G101-A",                 Type::IREM_G101A_0             },
-					{ "IREM-G101-B",                 Type::IREM_G101B_0             },
-					{ "IREM-HOLYDIVER",              Type::IREM_HOLYDIVER           },
-					{ "IREM-NROM-128",               Type::STD_NROM                 },
-					{ "IREM-NROM-256",               Type::STD_NROM                 },
-					{ "IREM-UNROM",                  Type::STD_UNROM                },
-					{ "JALECO-JF-01",                Type::JALECO_JF01              },
-					{ "JALECO-JF-02",                Type::JALECO_JF02              },
-					{ "JALECO-JF-03",                Type::JALECO_JF03              },
-					{ "JALECO-JF-04",                Type::JALECO_JF04              },
-					{ "JALECO-JF-05",                Type::JALECO_JF05              },
-					{ "JALECO-JF-06",                Type::JALECO_JF06              },
-					{ "JALECO-JF-07",                Type::JALECO_JF07              },
-					{ "JALECO-JF-08",                Type::JALECO_JF08              },
-					{ "JALECO-JF-09",                Type::JALECO_JF09              },
-					{ "JALECO-JF-10",                Type::JALECO_JF10              },
-					{ "JALECO-JF-11",                Type::JALECO_JF11              },
-					{ "JALECO-JF-12",                Type::JALECO_JF12              },
-					{ "JALECO-JF-13",                Type::JALECO_JF13              },
-					{ "JALECO-JF-14",                Type::JALECO_JF14              },
-					{ "JALECO-JF-15",                Type::JALECO_JF15              },
-					{ "JALECO-JF-16",                Type::JALECO_JF16              },
-					{ "JALECO-JF-17",                Type::JALECO_JF17              },
-					{ "JALECO-JF-18",                Type::JALECO_JF18              },
-					{ "JALECO-JF-19",                Type::JALECO_JF19              },
-					{ "JALECO-JF-20",                Type::JALECO_JF20              },
-					{ "JALECO-JF-21",                Type::JALECO_JF21              },
-					{ "JALECO-JF-22",                Type::JALECO_JF22              },
-					{ "JALECO-JF-23",                Type::JALECO_JF23              },
-					{ "JALECO-JF-24",                Type::JALECO_JF24              },
-					{ "JALECO-JF-25",                Type::JALECO_JF25              },
-					{ "JALECO-JF-26",                Type::JALECO_JF26              },
-					{ "JALECO-JF-27",                Type::JALECO_JF27              },
-					{ "JALECO-JF-28",                Type::JALECO_JF28              },
-					{ "JALECO-JF-29",                Type::JALECO_JF29              },
-					{ "JALECO-JF-30",                Type::JALECO_JF30              },
-					{ "JALECO-JF-31",                Type::JALECO_JF31              },
-					{ "JALECO-JF-32",                Type::JALECO_JF32              },
-					{ "JALECO-JF-33",                Type::JALECO_JF33              },
-					{ "JALECO-JF-34",                Type::JALECO_JF34              },
-					{ "JALECO-JF-35",                Type::JALECO_JF35              },
-					{ "JALECO-JF-36",                Type::JALECO_JF36              },
-					{ "JALECO-JF-37",                Type::JALECO_JF37              },
-					{ "JALECO-JF-38",                Type::JALECO_JF38              },
-					{ "JALECO-JF-39",                Type::JALECO_JF39              },
-					{ "JALECO-JF-40",                Type::JALECO_JF40              },
-					{ "JALECO-JF-41",                Type::JALECO_JF41              },
-					{ "KONAMI-74*139/74",            Type::DISCRETE_74_139_74       },
-					{ "KONAMI-CNROM",                Type::STD_CNROM                },
-					{ "KONAMI-NROM-128",             Type::STD_NROM                 },
-					{ "KONAMI-SLROM",                Type::STD_SLROM                },
-					{ "KONAMI-TLROM",                Type::STD_TLROM                },
-					{ "KONAMI-UNROM",                Type::STD_UNROM                },
-					{ "KONAMI-VRC-1",                Type::KONAMI_VRC1              },
-					{ "KONAMI-VRC-2",                Type::KONAMI_VRC2              },
-					{ "KONAMI-VRC-3",                Type::KONAMI_VRC3              },
-					{ "KONAMI-VRC-4",                Type::KONAMI_VRC4_0            },
-					{ "KONAMI-VRC-6",                Type::KONAMI_VRC6_0            },
-					{ "KONAMI-VRC-7",                Type::KONAMI_VRC7_0            },
-					{ "KS7031",                      Type::KAISER_KS7031            },
-					{ "MLT-ACTION52",                Type::AE_STD                   },
-					{ "MLT-CALTRON6IN1",             Type::CALTRON_6IN1             },
-					{ "MLT-MAXI15",                  Type::AVE_D1012                },
-					{ "NAMCOT-163",                  Type::NAMCOT_163_0             },
-					{ "NAMCOT-175",                  Type::NAMCOT_175               },
-					{ "NAMCOT-340",                  Type::NAMCOT_340               },
-					{ "NAMCOT-3301",                 Type::STD_NROM                 },
-					{ "NAMCOT-3302",                 Type::STD_NROM                 },
-					{ "NAMCOT-3303",                 Type::STD_NROM                 },
-					{ "NAMCOT-3305",                 Type::STD_NROM                 },
-					{ "NAMCOT-3311",                 Type::STD_NROM                 },
-					{ "NAMCOT-3401",                 Type::STD_DE1ROM               },
-					{ "NAMCOT-3405",                 Type::STD_DE1ROM               },
-					{ "NAMCOT-3406",                 Type::STD_DE1ROM               },
-					{ "NAMCOT-3407",                 Type::STD_DE1ROM               },
-					{ "NAMCOT-3411",                 Type::STD_NROM                 },
-					{ "NAMCOT-3413",                 Type::STD_DE1ROM               },
-					{ "NAMCOT-3414",                 Type::STD_DE1ROM               },
-					{ "NAMCOT-3415",                 Type::STD_DE1ROM               },
-					{ "NAMCOT-3416",                 Type::STD_DE1ROM               },
-					{ "NAMCOT-3417",                 Type::STD_DE1ROM               },
-					{ "NAMCOT-3425",                 Type::NAMCOT_3425              },
-					{ "NAMCOT-3433",                 Type::NAMCOT_3433              },
-					{ "NAMCOT-3443",                 Type::NAMCOT_3443              },
-					{ "NAMCOT-3446",                 Type::NAMCOT_3446              },
-					{ "NAMCOT-3451",                 Type::STD_DE1ROM               },
-					{ "NES-AMROM",                   Type::STD_AMROM                },
-					{ "NES-AN1ROM",                  Type::STD_AN1ROM               },
-					{ "NES-ANROM",                   Type::STD_ANROM                },
-					{ "NES-AOROM",                   Type::STD_AOROM                },
-					{ "NES-B4",                      Type::STD_TLROM                },
-					{ "NES-BNROM",                   Type::STD_BNROM                },
-					{ "NES-BTR",                     Type::CUSTOM_BTR               },
-					{ "NES-CNROM",                   Type::STD_CNROM                },
-					{ "NES-CPROM",                   Type::STD_CPROM                },
-					{ "NES-DE1ROM",                  Type::STD_DE1ROM               },
-					{ "NES-DEROM",                   Type::STD_DEROM                },
-					{ "NES-DRROM",                   Type::STD_DRROM                },
-					{ "NES-EKROM",                   Type::STD_EKROM                },
-					{ "NES-ELROM",                   Type::STD_ELROM                },
-					{ "NES-ETROM",                   Type::STD_ETROM                },
-					{ "NES-EVENT",                   Type::CUSTOM_EVENT             },
-					{ "NES-EWROM",                   Type::STD_EWROM                },
-					{ "NES-FJROM",                   Type::STD_FJROM                },
-					{ "NES-FKROM",                   Type::STD_FKROM                },
-					{ "NES-GNROM",                   Type::STD_GNROM                },
-					{ "NES-HKROM",                   Type::STD_HKROM                },
-					{ "NES-HROM",                    Type::STD_NROM                 },
-					{ "NES-JLROM",                   Type::STD_JLROM                },
-					{ "NES-JSROM",                   Type::STD_JSROM                },
-					{ "NES-MHROM",                   Type::STD_MHROM                },
-					{ "NES-NROM",                    Type::STD_NROM                 },
-					{ "NES-NROM-128",                Type::STD_NROM                 },
-					{ "NES-NROM-256",                Type::STD_NROM                 },
-					{ "NES-NTBROM",                  Type::STD_NTBROM               },
-					{ "NES-PEEOROM",                 Type::STD_PEEOROM              },
-					{ "NES-PNROM",                   Type::STD_PNROM                },
-					{ "NES-QJ",                      Type::CUSTOM_QJ                },
-					{ "NES-RROM",                    Type::STD_NROM                 },
-					{ "NES-RROM-128",                Type::STD_NROM                 },
-					{ "NES-SAROM",                   Type::STD_SAROM                },
-					{ "NES-SBROM",                   Type::STD_SBROM                },
-					{ "NES-SC1ROM",                  Type::STD_SCROM                },
-					{ "NES-SCROM",                   Type::STD_SCROM                },
-					{ "NES-SEROM",                   Type::STD_SEROM                },
-					{ "NES-SF1ROM",                  Type::STD_SFROM                },
-					{ "NES-SFROM",                   Type::STD_SFROM                },
-					{ "NES-SGROM",                   Type::STD_SGROM                },
-					{ "NES-SH1ROM",                  Type::STD_SHROM                },
-					{ "NES-SHROM",                   Type::STD_SHROM                },
-					{ "NES-SJROM",                   Type::STD_SJROM                },
-					{ "NES-SKROM",                   Type::STD_SKROM                },
-					{ "NES-SL1ROM",                  Type::STD_SLROM                },
-					{ "NES-SL2ROM",                  Type::STD_SLROM                },
-					{ "NES-SL3ROM",                  Type::STD_SLROM                },
-					{ "NES-SLROM",                   Type::STD_SLROM                },
-					{ "NES-SLRROM",                  Type::STD_SLROM                },
-					{ "NES-SNROM",                   Type::STD_SNROM                },
-					{ "NES-SOROM",                   Type::STD_SOROM                },
-					{ "NES-SROM",                    Type::STD_NROM                 },
-					{ "NES-STROM",                   Type::STD_NROM                 },
-					{ "NES-SUROM",                   Type::STD_SUROM                },
-					{ "NES-SXROM",                   Type::STD_SXROM                },
-					{ "NES-TBROM",                   Type::STD_TBROM                },
-					{ "NES-TEROM",                   Type::STD_TEROM                },
-					{ "NES-TFROM",                   Type::STD_TFROM                },
-					{ "NES-TGROM",                   Type::STD_TGROM                },
-					{ "NES-TKROM",                   Type::STD_TKROM                },
-					{ "NES-TKSROM",                  Type::STD_TKSROM               },
-					{ "NES-TL1ROM",                  Type::STD_TLROM                },
-					{ "NES-TL2ROM",                  Type::STD_TLROM                },
-					{ "NES-TLROM",                   Type::STD_TLROM                },
-					{ "NES-TLSROM",                  Type::STD_TLSROM               },
-					{ "NES-TNROM",                   Type::STD_TNROM                },
-					{ "NES-TQROM",                   Type::STD_TQROM                },
-					{ "NES-TR1ROM",                  Type::STD_TR1ROM               },
-					{ "NES-TSROM",                   Type::STD_TSROM                },
-					{ "NES-TVROM",                   Type::STD_TVROM                },
-					{ "NES-UN1ROM",                  Type::STD_UN1ROM               },
-					{ "NES-UNROM",                   Type::STD_UNROM                },
-					{ "NES-UOROM",                   Type::STD_UOROM                },
-					{ "NES-WH",                      Type::CUSTOM_WH                },
-					{ "NTDEC-N715062",               Type::NTDEC_N715062            },
-					{ "PAL-MH",                      Type::STD_MHROM                },
-					{ "PAL-ZZ",                      Type::CUSTOM_ZZ                },
-					{ "SACHEN-8259A",                Type::SACHEN_8259A             },
-					{ "SACHEN-8259B",                Type::SACHEN_8259B             },
-					{ "SACHEN-8259C",                Type::SACHEN_8259C             },
-					{ "SACHEN-8259D",                Type::SACHEN_8259D             },
-					{ "SACHEN-CNROM",                Type::STD_CXROM                },
-					{ "SETA-NROM-128",               Type::STD_NROM                 },
-					{ "SUNSOFT-1",                   Type::SUNSOFT_1                },
-					{ "SUNSOFT-2",                   Type::SUNSOFT_2B               },
-					{ "SUNSOFT-3",                   Type::SUNSOFT_3                },
-					{ "SUNSOFT-4",                   Type::SUNSOFT_4_0              },
-					{ "SUNSOFT-5B",                  Type::SUNSOFT_5B_0             },
-					{ "SUNSOFT-FME-7",               Type::SUNSOFT_FME7_0           },
-					{ "SUNSOFT-NROM-256",            Type::STD_NROM                 },
-					{ "TAITO-74*139/74",             Type::DISCRETE_74_139_74       },
-					{ "TAITO-74*161/161/32",         Type::DISCRETE_74_161_161_32_A },
-					{ "TAITO-CNROM",                 Type::STD_CNROM                },
-					{ "TAITO-NROM-128",              Type::STD_NROM                 },
-					{ "TAITO-NROM-256",              Type::STD_NROM                 },
-					{ "TAITO-TC0190FMC",             Type::TAITO_TC0190FMC          },
-					{ "TAITO-TC0190FMC+PAL16R4",     Type::TAITO_TC0190FMC_PAL16R4  },
-					{ "TAITO-UNROM",                 Type::STD_UNROM                },
-					{ "TAITO-X1-005",                Type::TAITO_X1005              },
-					{ "TAITO-X1-017",                Type::TAITO_X1017              },
-					{ "TENGEN-800002",               Type::TENGEN_800002            },
-					{ "TENGEN-800003",               Type::STD_NROM                 },
-					{ "TENGEN-800004",               Type::TENGEN_800004            },
-					{ "TENGEN-800008",               Type::TENGEN_800008            },
-					{ "TENGEN-800030",               Type::TENGEN_800030            },
-					{ "TENGEN-800032",               Type::TENGEN_800032            },
-					{ "TENGEN-800037",               Type::TENGEN_800037            },
-					{ "TENGEN-800042",               Type::TENGEN_800042            },
-					{ "UNL-22211",                   Type::TXC_22211A               },
-					{ "UNL-603-5052",                Type::BTL_6035052              },
-					{ "UNL-8237",                    Type::SUPERGAME_POCAHONTAS2    },
-					{ "UNL-A9746",                   Type::UNL_A9746                },
-					{ "UNL-AX5705",                  Type::BTL_AX5705               },
-					{ "UNL-CC-21",                   Type::UNL_CC21                 },
-					{ "UNL-EDU2000",                 Type::UNL_EDU2000              },
-					{ "UNL-H2288",                   Type::KAY_H2288                },
-					{ "UNL-KOF97",                   Type::UNL_KINGOFFIGHTERS97     },
-					{ "UNL-KS7031",                  Type::KAISER_KS7031            },
-					{ "UNL-KS7032",                  Type::KAISER_KS7032            },
-					{ "UNL-N625092",                 Type::UNL_N625092              },
-					{ "UNL-SA-0036",                 Type::SACHEN_SA0036            },
-					{ "UNL-SA-0037",                 Type::SACHEN_SA0037            },
-					{ "UNL-SA-016-1M",               Type::SACHEN_SA0161M           },
-					{ "UNL-SA-72007",                Type::SACHEN_SA72007           },
-					{ "UNL-SA-72008",                Type::SACHEN_SA72008           },
-					{ "UNL-SA-NROM",                 Type::SACHEN_TCA01             },
-					{ "UNL-SACHEN-74LS374N",         Type::SACHEN_74_374B           },
-					{ "UNL-SACHEN-8259A",            Type::SACHEN_8259A             },
-					{ "UNL-SACHEN-8259B",            Type::SACHEN_8259B             },
-					{ "UNL-SACHEN-8259C",            Type::SACHEN_8259C             },
-					{ "UNL-SACHEN-8259D",            Type::SACHEN_8259D             },
-					{ "UNL-SHERO",                   Type::SACHEN_STREETHEROES      },
-					{ "UNL-SL1632",                  Type::REXSOFT_SL1632           },
-					{ "UNL-SMB2J",                   Type::BTL_SMB2_C               },
-					{ "UNL-T-230",                   Type::BTL_T230                 },
-					{ "UNL-TC-U01-1.5M",             Type::SACHEN_TCU01             },
-					{ "UNL-TEK90",                   Type::JYCOMPANY_TYPE_A         },
-					{ "UNL-TF1201",                  Type::UNL_TF1201               },
-					{ "VIRGIN-SNROM",                Type::STD_SNROM                }
-				};
+					const Element& element = lut[slots[slot]-1];
 
-			#ifdef NST_DEBUG
-				for (uint i=1; i < sizeof(array(lut)); ++i)
-					NST_ASSERT( Element::Less()( lut[i-1], lut[i] ) );
-			#endif
+					if (Core::StringCompare( element.name, string ) == 0)
+						return &element;
+				}
+
+				return NULL;
+			}
 
-				const Element* const result = std::lower_bound
-				(
-					lut,
-					lut + sizeof(array(lut)),
-					string,
-					Element::Less()
-				);
+			const Board::Context::Names Board::Context::names;
+
+			uint Board::Context::NumNames()
+			{
+				return Names::size;
+			}
+
+			cstring Board::Context::GetName(uint i)
+			{
+				NST_ASSERT( i < Names::size );
+				return Names::lut[i].name;
+			}
+
+			bool Board::Context::DetectBoard(wcstring string,const dword wram)
+			{
+				const Element* const result = names.Find( string );
 
-				if (result == lut+sizeof(array(lut)) || Core::StringCompare( result->name, string ) != 0)
+				if (!result)
 					return false;
 
 				name = result->name;
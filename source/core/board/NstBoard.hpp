@@ -646,6 +646,9 @@ namespace Nes
 				class Context
 				{
 					struct Element;
+					class Names;
+
+					static const Names names;
 
 				public:
 
@@ -654,6 +657,9 @@ namespace Nes
 					bool DetectBoard(wcstring,dword);
 					bool DetectBoard(byte,dword,bool,byte);
 
+					static uint NumNames();
+					static cstring GetName(uint);
+
 					cstring name;
 					Type type;
 					Cpu* const cpu;
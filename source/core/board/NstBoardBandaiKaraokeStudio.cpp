@@ -24,7 +24,7 @@
 
 #include "NstBoard.hpp"
 #include "NstBoardBandaiKaraokeStudio.hpp"
-#include "../api/NstApiInput.hpp"
+#include "../api/NstApiCallbacks.hpp"
 
 namespace Nes
 {
@@ -70,7 +70,7 @@ namespace Nes
 					{
 						if (controllers)
 						{
-							Input::Controllers::KaraokeStudio::callback( controllers->karaokeStudio );
+							cpu.GetCallbacks().poll.karaokeStudio.Active()( controllers->karaokeStudio );
 							mic = (controllers->karaokeStudio.buttons & 0x7) ^ 0x3;
 						}
 						else
@@ -27,7 +27,7 @@
 #include "../NstTimer.hpp"
 #include "NstBoardMmc1.hpp"
 #include "NstBoardEvent.hpp"
-#include "../api/NstApiUser.hpp"
+#include "../api/NstApiCallbacks.hpp"
 
 namespace Nes
 {
@@ -266,7 +266,7 @@ namespace Nes
 							text[TIME_TEXT_SEC_OFFSET+0] = '0' + t % 60 / 10;
 							text[TIME_TEXT_SEC_OFFSET+1] = '0' + t % 60 % 10;
 
-							Api::User::eventCallback( Api::User::EVENT_DISPLAY_TIMER, text );
+							cpu.GetCallbacks().userEvent.Active()( Api::User::EVENT_DISPLAY_TIMER, text );
 						}
 					}
 
@@ -26,6 +26,8 @@
 #include "../NstPpu.hpp"
 #include "NstInpZapper.hpp"
 #include "NstInpBandaiHyperShot.hpp"
+#include "../NstCpu.hpp"
+#include "../api/NstApiCallbacks.hpp"
 
 namespace Nes
 {
@@ -68,7 +70,7 @@ namespace Nes
 					Controllers::BandaiHyperShot& bandaiHyperShot = input->bandaiHyperShot;
 					input = NULL;
 
-					if (Controllers::BandaiHyperShot::callback( bandaiHyperShot ))
+					if (cpu.GetCallbacks().poll.bandaiHyperShot.Active()( bandaiHyperShot ))
 					{
 						fire = (bandaiHyperShot.fire ? 0x10 : 0x00);
 						move = (bandaiHyperShot.move ? 0x02 : 0x00);
@@ -24,6 +24,8 @@
 
 #include "NstInpDevice.hpp"
 #include "NstInpCrazyClimber.hpp"
+#include "../NstCpu.hpp"
+#include "../api/NstApiCallbacks.hpp"
 
 namespace Nes
 {
@@ -87,7 +89,7 @@ namespace Nes
 						Controllers::CrazyClimber& crazy = input->crazyClimber;
 						input = NULL;
 
-						if (Controllers::CrazyClimber::callback( crazy ))
+						if (cpu.GetCallbacks().poll.crazyClimber.Active()( crazy ))
 						{
 							state[LEFT] = crazy.left;
 							state[RIGHT] = crazy.right;
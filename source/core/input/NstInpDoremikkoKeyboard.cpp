@@ -24,6 +24,8 @@
 
 #include "NstInpDevice.hpp"
 #include "NstInpDoremikkoKeyboard.hpp"
+#include "../NstCpu.hpp"
+#include "../api/NstApiCallbacks.hpp"
 
 namespace Nes
 {
@@ -83,7 +85,7 @@ namespace Nes
 
 					if (input)
 					{
-						Controllers::DoremikkoKeyboard::callback( input->doremikkoKeyboard, part, port );
+						cpu.GetCallbacks().poll.doremikkoKeyboard.Active()( input->doremikkoKeyboard, part, port );
 						return input->doremikkoKeyboard.keys & 0x1E;
 					}
 				}
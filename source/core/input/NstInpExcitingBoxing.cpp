@@ -24,6 +24,8 @@
 
 #include "NstInpDevice.hpp"
 #include "NstInpExcitingBoxing.hpp"
+#include "../NstCpu.hpp"
+#include "../api/NstApiCallbacks.hpp"
 
 namespace Nes
 {
@@ -59,7 +61,7 @@ namespace Nes
 			{
 				if (input)
 				{
-					Controllers::ExcitingBoxing::callback( input->excitingBoxing, data & 0x2 );
+					cpu.GetCallbacks().poll.excitingBoxing.Active()( input->excitingBoxing, data & 0x2 );
 					state = ~input->excitingBoxing.buttons & 0x1E;
 				}
 				else
@@ -24,6 +24,8 @@
 
 #include "NstInpDevice.hpp"
 #include "NstInpFamilyTrainer.hpp"
+#include "../NstCpu.hpp"
+#include "../api/NstApiCallbacks.hpp"
 
 namespace Nes
 {
@@ -67,7 +69,7 @@ namespace Nes
 				Controllers::FamilyTrainer& trainer = input->familyTrainer;
 				input = NULL;
 
-				if (Controllers::FamilyTrainer::callback( trainer ))
+				if (cpu.GetCallbacks().poll.familyTrainer.Active()( trainer ))
 				{
 					static const word lut[Controllers::FamilyTrainer::NUM_SIDE_A_BUTTONS] =
 					{
@@ -24,6 +24,8 @@
 
 #include "NstInpDevice.hpp"
 #include "NstInpHoriTrack.hpp"
+#include "../NstCpu.hpp"
+#include "../api/NstApiCallbacks.hpp"
 
 namespace Nes
 {
@@ -92,7 +94,7 @@ namespace Nes
 						Controllers::HoriTrack& horiTrack = input->horiTrack;
 						input = NULL;
 
-						if (Controllers::HoriTrack::callback( horiTrack ))
+						if (cpu.GetCallbacks().poll.horiTrack.Active()( horiTrack ))
 						{
 							dword bits = (horiTrack.buttons & 0xFF) | CONNECTED;
 
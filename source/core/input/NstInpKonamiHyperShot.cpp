@@ -24,6 +24,8 @@
 
 #include "NstInpDevice.hpp"
 #include "NstInpKonamiHyperShot.hpp"
+#include "../NstCpu.hpp"
+#include "../api/NstApiCallbacks.hpp"
 
 namespace Nes
 {
@@ -69,7 +71,7 @@ namespace Nes
 
 				if (prev > strobe && input)
 				{
-					Controllers::KonamiHyperShot::callback( input->konamiHyperShot );
+					cpu.GetCallbacks().poll.konamiHyperShot.Active()( input->konamiHyperShot );
 					state = input->konamiHyperShot.buttons & 0x1E;
 					input = NULL;
 				}
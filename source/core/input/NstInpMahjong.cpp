@@ -24,6 +24,8 @@
 
 #include "NstInpDevice.hpp"
 #include "NstInpMahjong.hpp"
+#include "../NstCpu.hpp"
+#include "../api/NstApiCallbacks.hpp"
 
 namespace Nes
 {
@@ -61,7 +63,7 @@ namespace Nes
 
 				if (data && input)
 				{
-					Controllers::Mahjong::callback( input->mahjong, data );
+					cpu.GetCallbacks().poll.mahjong.Active()( input->mahjong, data );
 					stream = input->mahjong.buttons << 1;
 				}
 				else
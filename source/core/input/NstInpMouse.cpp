@@ -24,6 +24,8 @@
 
 #include "NstInpDevice.hpp"
 #include "NstInpMouse.hpp"
+#include "../NstCpu.hpp"
+#include "../api/NstApiCallbacks.hpp"
 
 namespace Nes
 {
@@ -92,7 +94,7 @@ namespace Nes
 						Controllers::Mouse& mouse = input->mouse;
 						input = NULL;
 
-						if (Controllers::Mouse::callback( mouse ))
+						if (cpu.GetCallbacks().poll.mouse.Active()( mouse ))
 						{
 							data = 0x00;
 
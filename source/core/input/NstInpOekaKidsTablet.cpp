@@ -24,6 +24,8 @@
 
 #include "NstInpDevice.hpp"
 #include "NstInpOekaKidsTablet.hpp"
+#include "../NstCpu.hpp"
+#include "../api/NstApiCallbacks.hpp"
 
 namespace Nes
 {
@@ -77,7 +79,7 @@ namespace Nes
 						Controllers::OekaKidsTablet& tablet = input->oekaKidsTablet;
 						input = NULL;
 
-						if (Controllers::OekaKidsTablet::callback( tablet ))
+						if (cpu.GetCallbacks().poll.oekaKidsTablet.Active()( tablet ))
 						{
 							if (tablet.x <= 255 && tablet.y <= 239)
 							{
@@ -24,6 +24,8 @@
 
 #include "NstInpDevice.hpp"
 #include "NstInpPachinko.hpp"
+#include "../NstCpu.hpp"
+#include "../api/NstApiCallbacks.hpp"
 
 namespace Nes
 {
@@ -92,7 +94,7 @@ namespace Nes
 						Controllers::Pachinko& pachinko = input->pachinko;
 						input = NULL;
 
-						if (Controllers::Pachinko::callback( pachinko ))
+						if (cpu.GetCallbacks().poll.pachinko.Active()( pachinko ))
 						{
 							uint throttle = Clamp<-64,+63>(pachinko.throttle) + 192;
 
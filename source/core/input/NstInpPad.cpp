@@ -25,6 +25,7 @@
 #include "NstInpDevice.hpp"
 #include "NstInpPad.hpp"
 #include "../NstCpu.hpp"
+#include "../api/NstApiCallbacks.hpp"
 
 namespace Nes
 {
@@ -32,8 +33,6 @@ namespace Nes
 	{
 		namespace Input
 		{
-			uint Pad::mic;
-
 			#ifdef NST_MSVC_OPTIMIZE
 			#pragma optimize("s", on)
 			#endif
@@ -96,10 +95,11 @@ namespace Nes
 			{
 				if (input)
 				{
+					const Controllers::Pad* const pads = input->pad;
 					Controllers::Pad& pad = input->pad[type - Api::Input::PAD1];
 					input = NULL;
 
-					if (Controllers::Pad::callback( pad, type - Api::Input::PAD1 ))
+					if (cpu.GetCallbacks().poll.pad.Active()( pad, type - Api::Input::PAD1 ))
 					{
 						uint buttons = pad.buttons;
 
@@ -123,7 +123,8 @@ namespace Nes
 						state = buttons;
 					}
 
-					mic |= pad.mic;
+					for (uint i=0; i < Api::Input::NUM_PADS; ++i)
+						mic |= pads[i].mic;
 				}
 			}
 
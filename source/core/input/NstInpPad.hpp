@@ -54,8 +54,7 @@ namespace Nes
 				uint strobe;
 				uint stream;
 				uint state;
-
-				static uint mic;
+				uint mic;
 			};
 		}
 	}
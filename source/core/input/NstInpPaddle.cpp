@@ -24,6 +24,8 @@
 
 #include "NstInpDevice.hpp"
 #include "NstInpPaddle.hpp"
+#include "../NstCpu.hpp"
+#include "../api/NstApiCallbacks.hpp"
 
 namespace Nes
 {
@@ -97,7 +99,7 @@ namespace Nes
 						Controllers::Paddle& paddle = input->paddle;
 						input = NULL;
 
-						if (Controllers::Paddle::callback( paddle ))
+						if (cpu.GetCallbacks().poll.paddle.Active()( paddle ))
 						{
 							data = 0xFF - ((82 + 172 * (Clamp<32,176>(paddle.x) - 32U) / 144) & 0xFF);
 
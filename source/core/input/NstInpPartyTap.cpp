@@ -24,6 +24,8 @@
 
 #include "NstInpDevice.hpp"
 #include "NstInpPartyTap.hpp"
+#include "../NstCpu.hpp"
+#include "../api/NstApiCallbacks.hpp"
 
 namespace Nes
 {
@@ -69,7 +71,7 @@ namespace Nes
 				{
 					if (input)
 					{
-						Controllers::PartyTap::callback( input->partyTap );
+						cpu.GetCallbacks().poll.partyTap.Active()( input->partyTap );
 						state = input->partyTap.units;
 						input = NULL;
 					}
@@ -24,6 +24,8 @@
 
 #include "NstInpDevice.hpp"
 #include "NstInpPokkunMoguraa.hpp"
+#include "../NstCpu.hpp"
+#include "../api/NstApiCallbacks.hpp"
 
 namespace Nes
 {
@@ -59,7 +61,7 @@ namespace Nes
 			{
 				if (input)
 				{
-					Controllers::PokkunMoguraa::callback( input->pokkunMoguraa, ~data & 0x7 );
+					cpu.GetCallbacks().poll.pokkunMoguraa.Active()( input->pokkunMoguraa, ~data & 0x7 );
 					state = ~input->pokkunMoguraa.buttons & 0x1E;
 				}
 				else
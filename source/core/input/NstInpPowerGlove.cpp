@@ -24,6 +24,8 @@
 
 #include "NstInpDevice.hpp"
 #include "NstInpPowerGlove.hpp"
+#include "../NstCpu.hpp"
+#include "../api/NstApiCallbacks.hpp"
 
 namespace Nes
 {
@@ -118,7 +120,7 @@ namespace Nes
 				Controllers::PowerGlove& glove = input->powerGlove;
 				input = NULL;
 
-				if (Controllers::PowerGlove::callback( glove ))
+				if (cpu.GetCallbacks().poll.powerGlove.Active()( glove ))
 				{
 					buffer[1] = (glove.x - 128U) & 0xFF;
 					buffer[2] = (128U - glove.y) & 0xFF;
@@ -24,6 +24,8 @@
 
 #include "NstInpDevice.hpp"
 #include "NstInpPowerPad.hpp"
+#include "../NstCpu.hpp"
+#include "../api/NstApiCallbacks.hpp"
 
 namespace Nes
 {
@@ -85,7 +87,7 @@ namespace Nes
 						Controllers::PowerPad& power = input->powerPad;
 						input = NULL;
 
-						if (Controllers::PowerPad::callback( power ))
+						if (cpu.GetCallbacks().poll.powerPad.Active()( power ))
 						{
 							static const dword lut[Controllers::PowerPad::NUM_SIDE_A_BUTTONS] =
 							{
@@ -24,6 +24,8 @@
 
 #include "NstInpDevice.hpp"
 #include "NstInpSuborKeyboard.hpp"
+#include "../NstCpu.hpp"
+#include "../api/NstApiCallbacks.hpp"
 
 namespace Nes
 {
@@ -94,7 +96,7 @@ namespace Nes
 				}
 				else if (input && scan < 10)
 				{
-					Controllers::SuborKeyboard::callback( input->suborKeyboard, scan, mode );
+					cpu.GetCallbacks().poll.suborKeyboard.Active()( input->suborKeyboard, scan, mode );
 					return ~uint(input->suborKeyboard.parts[scan]) & 0x1E;
 				}
 				else
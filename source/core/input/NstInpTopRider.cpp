@@ -24,6 +24,8 @@
 
 #include "NstInpDevice.hpp"
 #include "NstInpTopRider.hpp"
+#include "../NstCpu.hpp"
+#include "../api/NstApiCallbacks.hpp"
 
 namespace Nes
 {
@@ -67,7 +69,7 @@ namespace Nes
 			{
 				if (controllers)
 				{
-					Controllers::TopRider::callback( controllers->topRider );
+					cpu.GetCallbacks().poll.topRider.Active()( controllers->topRider );
 
 					uint data = controllers->topRider.buttons;
 
@@ -25,6 +25,7 @@
 #include <cstring>
 #include "NstInpDevice.hpp"
 #include "NstInpTurboFile.hpp"
+#include "../NstCpu.hpp"
 
 namespace Nes
 {
@@ -37,7 +38,9 @@ namespace Nes
 			#endif
 
 			TurboFile::TurboFile(const Cpu& cpu)
-			: Device(cpu,Api::Input::TURBOFILE)
+			:
+			Device (cpu,Api::Input::TURBOFILE),
+			file   (cpu.GetCallbacks())
 			{
 				std::memset( ram, 0, SIZE );
 				file.Load( File::TURBOFILE, ram, SIZE );
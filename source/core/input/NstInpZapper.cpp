@@ -25,6 +25,8 @@
 #include "NstInpDevice.hpp"
 #include "../NstPpu.hpp"
 #include "NstInpZapper.hpp"
+#include "../NstCpu.hpp"
+#include "../api/NstApiCallbacks.hpp"
 
 namespace Nes
 {
@@ -169,7 +171,7 @@ namespace Nes
 					Controllers::Zapper& zapper = input->zapper;
 					input = NULL;
 
-					if (Controllers::Zapper::callback( zapper ))
+					if (cpu.GetCallbacks().poll.zapper.Active()( zapper ))
 					{
 						fire = (zapper.fire ? arcade ? 0x80 : 0x10 : 0x00);
 
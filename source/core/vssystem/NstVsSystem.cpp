@@ -30,6 +30,7 @@
 #include "NstVsRbiBaseball.hpp"
 #include "NstVsTkoBoxing.hpp"
 #include "NstVsSuperXevious.hpp"
+#include "../api/NstApiCallbacks.hpp"
 
 namespace Nes
 {
@@ -225,13 +226,13 @@ namespace Nes
 		#pragma optimize("", on)
 		#endif
 
-		void Cartridge::VsSystem::VsDipSwitches::BeginFrame(Input::Controllers* const input)
+		void Cartridge::VsSystem::VsDipSwitches::BeginFrame(Input::Controllers* const input,const Api::Callbacks& callbacks)
 		{
 			if (!coinTimer)
 			{
 				if (input)
 				{
-					Input::Controllers::VsSystem::callback( input->vsSystem );
+					callbacks.poll.vsSystem.Active()( input->vsSystem );
 
 					if (input->vsSystem.insertCoin & COIN)
 					{
@@ -1357,9 +1358,10 @@ namespace Nes
 			}
 		};
 
-		void Cartridge::VsSystem::InputMapper::Begin(const Api::Input input,Input::Controllers* const controllers)
+		void Cartridge::VsSystem::InputMapper::Begin(const Api::Input input,Input::Controllers* const controllers,Api::Callbacks& callbacks)
 		{
-			Input::Controllers::Pad::callback.Get( userCallback, userData );
+			userLocal = callbacks.poll.pad.IsLocal();
+			callbacks.poll.pad.Get( userCallback, userData );
 
 			if (controllers)
 			{
@@ -1370,18 +1372,21 @@ namespace Nes
 					ports[i] = input.GetConnectedController(i) - Api::Input::PAD1;
 
 					if (ports[i] < 4)
-						Input::Controllers::Pad::callback( controllers->pad[ports[i]], ports[i] );
+						callbacks.poll.pad.Active()( controllers->pad[ports[i]], ports[i] );
 				}
 
-				Input::Controllers::Pad::callback.Set( NULL, NULL );
+				callbacks.poll.pad.Set( NULL, NULL );
 
 				Fix( controllers->pad, ports );
 			}
 		}
 
-		void Cartridge::VsSystem::InputMapper::End() const
+		void Cartridge::VsSystem::InputMapper::End(Api::Callbacks& callbacks) const
 		{
-			Input::Controllers::Pad::callback.Set( userCallback, userData );
+			if (userLocal)
+				callbacks.poll.pad.Set( userCallback, userData );
+			else
+				callbacks.poll.pad.Unset();
 		}
 
 		#ifdef NST_MSVC_OPTIMIZE
@@ -85,7 +85,7 @@ namespace Nes
 				inline uint Reg(uint) const;
 				inline void Reset();
 
-				void BeginFrame(Input::Controllers*);
+				void BeginFrame(Input::Controllers*,const Api::Callbacks&);
 
 			private:
 
@@ -139,6 +139,7 @@ namespace Nes
 
 				void* userData;
 				Pad::PollCallback userCallback;
+				bool userLocal;
 
 				struct Type1;
 				struct Type2;
@@ -161,8 +162,13 @@ namespace Nes
 				static InputMapper* Create(Type);
 				virtual ~InputMapper() {}
 
-				void Begin(const Api::Input,Input::Controllers*);
-				void End() const;
+				void Begin(const Api::Input,Input::Controllers*,Api::Callbacks&);
+				void End(Api::Callbacks&) const;
+
+			protected:
+
+				InputMapper()
+				: userData(NULL), userCallback(NULL), userLocal(false) {}
 			};
 
 			InputMapper* const inputMapper;
@@ -176,16 +182,16 @@ namespace Nes
 
 			void BeginFrame(const Api::Input& input,Input::Controllers* controllers)
 			{
-				dips.BeginFrame( controllers );
+				dips.BeginFrame( controllers, cpu.GetCallbacks() );
 
 				if (inputMapper)
-					inputMapper->Begin( input, controllers );
+					inputMapper->Begin( input, controllers, cpu.GetCallbacks() );
 			}
 
 			void VSync() const
 			{
 				if (inputMapper)
-					inputMapper->End();
+					inputMapper->End( cpu.GetCallbacks() );
 			}
 
 			PpuModel GetPpuModel() const
@@ -0,0 +1,88 @@
+/*
+ * Nestopia UE
+ *
+ * Copyright (C) 2026 R. Danbrook
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301, USA.
+ *
+ */
+
+// Compiles NstDatabase.xml into the binary form the frontends map at startup
+
+#include <iostream>
+#include <fstream>
+
+#include <stdio.h>
+#include <unistd.h>
+
+#include "core/api/NstApiEmulator.hpp"
+#include "core/api/NstApiCartridge.hpp"
+
+using namespace Nes::Api;
+
+static void dbc_usage() {
+	fprintf(stderr,
+		"Usage: nestopia-dbc [-o <file>] <database.xml> [override.xml]\n\n"
+		"  -o <file>  Write the compiled database to <file> (default NstDatabase.bin)\n"
+		"  -h         Show this help\n");
+}
+
+int main(int argc, char *argv[]) {
+	const char *outpath = "NstDatabase.bin";
+	int c;
+
+	while ((c = getopt(argc, argv, "o:h")) != -1) {
+		switch (c) {
+			case 'o': outpath = optarg; break;
+			default: dbc_usage(); return c == 'h' ? 0 : 1;
+		}
+	}
+
+	if (optind >= argc || argc - optind > 2) { dbc_usage(); return 1; }
+
+	Emulator emulator;
+	Cartridge::Database database(emulator);
+
+	std::ifstream base(argv[optind], std::ifstream::in|std::ifstream::binary);
+	if (!base.is_open()) { fprintf(stderr, "Could not open %s\n", argv[optind]); return 1; }
+
+	Nes::Result result;
+
+	if (argc - optind == 2) {
+		std::ifstream overrides(argv[optind + 1], std::ifstream::in|std::ifstream::binary);
+		if (!overrides.is_open()) { fprintf(stderr, "Could not open %s\n", argv[optind + 1]); return 1; }
+		result = database.Load(base, overrides);
+	}
+	else {
+		result = database.Load(base);
+	}
+
+	if (NES_FAILED(result)) { fprintf(stderr, "Could not load %s (%d)\n", argv[optind], result); return 1; }
+
+	std::ofstream out(outpath, std::ofstream::out|std::ofstream::binary|std::ofstream::trunc);
+	if (!out.is_open()) { fprintf(stderr, "Could not create %s\n", outpath); return 1; }
+
+	result = database.Save(out);
+	out.close();
+
+	if (NES_FAILED(result) || !out) {
+		fprintf(stderr, "Could not write %s (%d)\n", outpath, result);
+		unlink(outpath);
+		return 1;
+	}
+
+	return 0;
+}
@@ -37,18 +37,30 @@ static ao_sample_format format;
 
 #ifdef _JACK
 #define JACK_CLIENT_NAME "nestopia"
-#define JACK_RB_SIZE 6400
+#define JACK_BLOCK_SIZE 512
 
 #include <jack/jack.h>
-#include <jack/ringbuffer.h>
 
 static jack_port_t *jack_output_port1, *jack_output_port2;
 static jack_client_t *jack_client;
-static jack_ringbuffer_t *jack_rb = NULL;
 static bool jack_ready = false;
-const size_t jack_sample_size = sizeof(jack_default_audio_sample_t);
 #endif
 
+// Lock-free ring between the emulation thread (the only writer) and the
+// audio callback (the only reader), in interleaved 16-bit samples. Each side
+// only ever stores its own position, so neither has to wait for the other.
+#define AUDIO_RING_SIZE 65536
+#define AUDIO_RING_MASK (AUDIO_RING_SIZE - 1)
+
+static struct {
+	int16_t buf[AUDIO_RING_SIZE];
+	SDL_atomic_t head; // samples written, owned by the producer
+	SDL_atomic_t tail; // samples read, owned by the consumer
+	SDL_atomic_t underruns;
+	SDL_atomic_t overruns;
+	bool starved; // consumer side only
+} ring;
+
 extern Emulator emulator;
 
 static SDL_AudioSpec spec, obtained;
@@ -56,38 +68,142 @@ static SDL_AudioDeviceID dev;
 
 static int16_t audiobuf[6400];
 
-static int framerate, channels, bufsize;
+static int framerate, channels, bufsize, latency;
 
 static bool paused = false;
+static bool ratecontrol = false;
+
+static Sound::Output *soundout = NULL;
 
 void (*audio_output)();
 void (*audio_deinit)();
 
+static void audio_ring_reset() {
+	// Only safe while no callback is running
+	SDL_AtomicSet(&ring.head, 0);
+	SDL_AtomicSet(&ring.tail, 0);
+	SDL_AtomicSet(&ring.underruns, 0);
+	SDL_AtomicSet(&ring.overruns, 0);
+	ring.starved = true;
+	memset(ring.buf, 0, sizeof(ring.buf));
+}
+
+static unsigned audio_ring_fill() {
+	return (unsigned)SDL_AtomicGet(&ring.head) - (unsigned)SDL_AtomicGet(&ring.tail);
+}
+
+static void audio_ring_write(const int16_t *src, unsigned count) {
+	// Producer side, drops what doesn't fit instead of waiting
+	unsigned head = (unsigned)SDL_AtomicGet(&ring.head);
+	unsigned space = AUDIO_RING_SIZE - (head - (unsigned)SDL_AtomicGet(&ring.tail));
+	
+	if (count > space) {
+		SDL_AtomicAdd(&ring.overruns, 1);
+		count = space;
+	}
+	
+	unsigned pos = head & AUDIO_RING_MASK;
+	unsigned chunk = AUDIO_RING_SIZE - pos;
+	
+	if (chunk > count) { chunk = count; }
+	
+	memcpy(ring.buf + pos, src, chunk * sizeof(int16_t));
+	memcpy(ring.buf, src + chunk, (count - chunk) * sizeof(int16_t));
+	
+	// Publish only after the samples are in place
+	SDL_AtomicSet(&ring.head, (int)(head + count));
+}
+
+static void audio_ring_read(int16_t *dst, unsigned count) {
+	// Consumer side, pads with silence when the producer falls behind
+	unsigned tail = (unsigned)SDL_AtomicGet(&ring.tail);
+	unsigned avail = (unsigned)SDL_AtomicGet(&ring.head) - tail;
+	unsigned take = avail < count ? avail : count;
+	
+	unsigned pos = tail & AUDIO_RING_MASK;
+	unsigned chunk = AUDIO_RING_SIZE - pos;
+	
+	if (chunk > take) { chunk = take; }
+	
+	memcpy(dst, ring.buf + pos, chunk * sizeof(int16_t));
+	memcpy(dst + chunk, ring.buf, (take - chunk) * sizeof(int16_t));
+	memset(dst + take, 0, (count - take) * sizeof(int16_t));
+	
+	SDL_AtomicSet(&ring.tail, (int)(tail + take));
+	
+	// Count running dry once, not every callback while nothing is produced
+	if (take < count && !ring.starved) { SDL_AtomicAdd(&ring.underruns, 1); }
+	ring.starved = take < count;
+}
+
+static void audio_ring_pace() {
+	// Without rate control the audio clock paces emulation, keep about the
+	// latency target buffered. With it, only hold back a display running well
+	// faster than the emulated machine.
+	if (!conf.timing_limiter) { return; }
+	
+	unsigned limit = (ratecontrol ? latency * 2 : latency - bufsize) / sizeof(int16_t);
+	
+	// Give up after about the latency target, a device that stopped draining
+	// the ring must not stall emulation
+	Uint32 timeout = latency * 1000 / (2 * channels * conf.audio_sample_rate) + 1;
+	Uint32 start = SDL_GetTicks();
+	
+	while (audio_ring_fill() > limit) {
+		if (SDL_GetTicks() - start > timeout) {
+			SDL_AtomicAdd(&ring.overruns, 1);
+			return;
+		}
+		SDL_Delay(1);
+	}
+}
+
 void audio_output_sdl() {
-	while (SDL_GetQueuedAudioSize(dev) > (Uint32)bufsize) {
-		if (conf.timing_limiter) { SDL_Delay(1); }
+	// Nothing drains the ring without a device
+	if (!dev) { return; }
+	
+	audio_ring_pace();
+	audio_ring_write(audiobuf, bufsize / sizeof(int16_t));
+}
+
+static unsigned audio_queued() {
+	// Number of samples per channel waiting to be played
+	if (conf.audio_api == 1) { return 0; }
+	return audio_ring_fill() / channels;
+}
+
+static void audio_report() {
+	int underruns = SDL_AtomicGet(&ring.underruns);
+	int overruns = SDL_AtomicGet(&ring.overruns);
+	
+	if (underruns || overruns) {
+		fprintf(stderr, "Audio: %d underrun(s), %d overrun(s)\n", underruns, overruns);
 	}
-	SDL_QueueAudio(dev, (const void*)audiobuf, bufsize);
-	// Clear the audio queue arbitrarily to avoid it backing up too far
-	if (SDL_GetQueuedAudioSize(dev) > (Uint32)(bufsize * 3)) { SDL_ClearQueuedAudio(dev); }
 }
 
 void audio_deinit_sdl() {
 	if (dev) { SDL_CloseAudioDevice(dev); }
+	audio_report();
 }
 
 void audio_play() {
 	if (paused) { return; }
-	bufsize = 2 * channels * (conf.audio_sample_rate / framerate);
 	audio_output();
+	
+	// Request exactly what the core produces for the next frame, steering
+	// the queue towards the latency target when rate control is enabled
+	Sound sound(emulator);
+	unsigned length = sound.UpdateRateControl(audio_queued(), latency / (2 * channels));
+	unsigned maxlength = sizeof(audiobuf) / (2 * channels);
+	
+	if (!length || length > maxlength) { length = conf.audio_sample_rate / framerate; }
+	
+	soundout->length[0] = length;
+	bufsize = 2 * channels * length;
 }
 
 void audio_cb_sdl(void *data, uint8_t *stream, int len) {
-	uint8_t *soundbuf = (uint8_t*)audiobuf;
-	
-	for (int i = 0; i < len; i++) {
-		stream[i] = soundbuf[i];
-	}
+	audio_ring_read((int16_t*)stream, len / sizeof(int16_t));
 }
 
 void audio_init_sdl() {
@@ -97,10 +213,10 @@ void audio_init_sdl() {
 	spec.silence = 0;
 	spec.samples = (conf.audio_sample_rate / framerate);
 	spec.userdata = 0;
-	spec.callback = NULL; // Use SDL_QueueAudio instead
-	//spec.callback = audio_cb_sdl;
+	spec.callback = audio_cb_sdl;
 	
-	dev = SDL_OpenAudioDevice(NULL, 0, &spec, &obtained, SDL_AUDIO_ALLOW_ANY_CHANGE);
+	// The callback writes the requested format as is, let SDL convert
+	dev = SDL_OpenAudioDevice(NULL, 0, &spec, &obtained, 0);
 	if (!dev) {
 		fprintf(stderr, "Error opening audio device.\n");
 	}
@@ -145,21 +261,35 @@ void audio_init_ao() {
 #ifdef _JACK
 int audio_cb_jack(jack_nframes_t nframes, void *arg) {
 	jack_default_audio_sample_t *out1, *out2;
-	int i;
+	int16_t block[JACK_BLOCK_SIZE * 2];
+	const jack_default_audio_sample_t scale = 1.0f / 0x8000;
 
 	if(!jack_ready)
 		return 0;
 
 	out1 = (jack_default_audio_sample_t*) jack_port_get_buffer(jack_output_port1, nframes);
 	out2 = (jack_default_audio_sample_t*) jack_port_get_buffer(jack_output_port2, nframes);
-	// it is safe to not check if we have enough data
-	// because jack_ringbuffer_read does a noop if you ask for too much
-	for(i=0; i<nframes; i++) {
-		jack_ringbuffer_read(jack_rb,(char *) (out1+i),jack_sample_size);
-		if(channels == 1)
-			out2[i] = out1[i];
-		else if(channels == 2)
-			jack_ringbuffer_read(jack_rb,(char *) (out2+i),jack_sample_size);
+
+	// pull blocks from the ring and convert them to the 32 bit float JACK wants
+	for(jack_nframes_t done = 0; done < nframes;) {
+		jack_nframes_t frames = nframes - done;
+		if(frames > JACK_BLOCK_SIZE)
+			frames = JACK_BLOCK_SIZE;
+
+		audio_ring_read(block, frames * channels);
+
+		if(channels == 2) {
+			for(jack_nframes_t i = 0; i < frames; i++) {
+				out1[done+i] = block[i*2+0] * scale;
+				out2[done+i] = block[i*2+1] * scale;
+			}
+		}
+		else {
+			for(jack_nframes_t i = 0; i < frames; i++)
+				out1[done+i] = out2[done+i] = block[i] * scale;
+		}
+
+		done += frames;
 	}
 	return 0;
 }
@@ -171,9 +301,8 @@ void audio_jack_shutdown(void *arg) {
 void audio_deinit_jack() {
 	if(jack_client != NULL)
 		jack_deactivate(jack_client);
-	if(jack_rb != NULL)
-		jack_ringbuffer_free(jack_rb);
 	jack_ready = false;
+	audio_report();
 }
 
 void audio_init_jack() {
@@ -191,11 +320,6 @@ void audio_init_jack() {
 	// JACK needs sample rate to match server sample rate
 	conf.audio_sample_rate = (int) jack_get_sample_rate(jack_client);
 	fprintf(stderr, "Audio: jack - Setting sample rate to %d\n", conf.audio_sample_rate);
-	jack_set_process_callback(jack_client, audio_cb_jack,NULL);
-
-	// set up ringbuffer for callback
-	jack_rb = jack_ringbuffer_create(JACK_RB_SIZE * channels * jack_sample_size);
-	memset(jack_rb->buf, 0, jack_rb->size);
 
 	jack_set_process_callback(jack_client, audio_cb_jack, NULL);
 	jack_on_shutdown(jack_client, audio_jack_shutdown, NULL);
@@ -219,23 +343,10 @@ void audio_init_jack() {
 }
 
 void audio_output_jack() {
-	size_t i;
-	jack_default_audio_sample_t sample;
-
 	if(!jack_ready)
 		return;
 
-	if(bufsize > (jack_ringbuffer_write_space(jack_rb) / jack_sample_size)) {
-		fprintf(stderr, "Audio: jack - ringbuffer full!\n");
-		bufsize = jack_ringbuffer_write_space(jack_rb) / jack_sample_size;
-	}
-
-	for(i = 0; i < (bufsize/2); i++) {
-		// convert the audio to 32 bit float to make JACK happy
-		sample = (float) audiobuf[i];
-		sample /= (float) 0x8000;
-		jack_ringbuffer_write(jack_rb, (char *) &sample, jack_sample_size);
-	}
+	audio_ring_write(audiobuf, bufsize / sizeof(int16_t));
 }
 #endif // _JACK
 
@@ -269,6 +380,7 @@ void audio_init() {
 	framerate = nst_pal() ? (conf.timing_speed / 6) * 5 : conf.timing_speed;
 	channels = conf.audio_stereo ? 2 : 1;
 	memset(audiobuf, 0, sizeof(audiobuf));
+	audio_ring_reset();
 	
 	audio_set_funcs();
 	
@@ -310,12 +422,20 @@ void audio_set_params(Sound::Output *soundoutput) {
 	sound.SetSpeaker(conf.audio_stereo ? Sound::SPEAKER_STEREO : Sound::SPEAKER_MONO);
 	sound.SetSpeed(Sound::DEFAULT_SPEED);
 	
+	// Rate control only makes sense when the display paces emulation
+	ratecontrol = conf.timing_vsync && conf.audio_api != 1;
+	sound.EnableRateControl(ratecontrol);
+	
 	audio_adj_volume();
 	
 	soundoutput->samples[0] = audiobuf;
 	soundoutput->length[0] = conf.audio_sample_rate / framerate;
 	soundoutput->samples[1] = NULL;
 	soundoutput->length[1] = 0;
+	
+	soundout = soundoutput;
+	bufsize = 2 * channels * soundoutput->length[0];
+	latency = bufsize * 3;
 }
 
 void audio_adj_volume() {